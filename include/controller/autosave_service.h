@@ -0,0 +1,59 @@
+#pragma once
+
+#include "controller/game_controller.h"
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include <optional>
+
+// Saves the board while it is being configured. The GUI thread only takes a
+// copy-on-write snapshot; serialization and the write run on a worker thread.
+// Saves append the snapshot's dirty cells and categories to the file, so one
+// edit costs one record of I/O whatever the board size. The file is compacted
+// with a full atomic rewrite once the appended records outnumber the cells.
+class AutosaveService : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int AUTOSAVE_DELAY_MS = 5000;
+    static constexpr size_t MIN_COMPACTION_RECORDS = 256;
+
+    AutosaveService(GameController* controller, const QString& path, QObject* parent = nullptr);
+    ~AutosaveService();
+
+    // Loads the last autosave into the controller; returns false if there was none
+    bool restore();
+    void save_now();
+    // Synchronously writes pending changes; used when the application quits
+    void flush();
+
+    [[nodiscard]] static QString default_path();
+    [[nodiscard]] const QString& get_path() const;
+    [[nodiscard]] qint64 get_last_snapshot_ns() const;
+    [[nodiscard]] size_t get_delta_records() const;
+
+signals:
+    void saved(const QString& path);
+    void save_failed(const QString& error);
+
+private slots:
+    void on_board_changed();
+
+private:
+    GameController* game_controller;
+    QString path;
+    QTimer* autosave_timer;
+    QThreadPool write_pool;
+    bool restoring;
+    bool write_in_progress;
+    bool save_pending;
+    qint64 last_snapshot_ns;
+    size_t delta_records;       // Appended since the last full write
+    bool full_save_required;    // After a failed write or a restore
+
+    // Takes the snapshot and clears the live board's dirty state; empty if nothing changed
+    std::optional<board> take_snapshot(bool& full);
+    static bool write_snapshot(const QString& target, const board& snapshot, bool full, QString* error);
+    void on_write_finished(bool ok, bool full, size_t records, const QString& error);
+};
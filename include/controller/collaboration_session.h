@@ -0,0 +1,79 @@
+#pragma once
+
+#include "controller/game_controller.h"
+#include "model/board_replica.h"
+#include <QByteArray>
+#include <QHostAddress>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <memory>
+#include <optional>
+#include <vector>
+
+// Lets several editors configure one board at the same time. Every local edit
+// to a category, cell or the board size becomes a board_operation that is
+// merged into a board_replica and sent to the other editors; remote operations
+// that win their register are applied to the controller in one batch as soon
+// as they are read. The host relays what it accepts to every other peer, so
+// editors only need to reach the host. Joining replaces the local board with
+// the host's. Works over loopback for testing on one machine.
+class CollaborationSession : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr quint16 DEFAULT_PORT = 7468;
+    static constexpr quint8 PROTOCOL_VERSION = 1;
+    static constexpr quint32 MAX_FRAME_BYTES = 64 * 1024 * 1024;
+
+    explicit CollaborationSession(GameController* controller, QObject* parent = nullptr);
+
+    // Listening on QHostAddress::LocalHost keeps the session to this machine
+    bool host(quint16 port, const QHostAddress& address = QHostAddress::Any, QString* error = nullptr);
+    void join(const QString& host_name, quint16 port);
+    void leave();
+
+    [[nodiscard]] bool is_active() const { return replica != nullptr; }
+    [[nodiscard]] bool is_host() const { return server.isListening(); }
+    [[nodiscard]] quint16 get_port() const { return server.serverPort(); }
+    [[nodiscard]] int peer_count() const { return static_cast<int>(peers.size()); }
+    [[nodiscard]] const board_replica* get_replica() const { return replica.get(); }
+    // Time spent applying the last batch of remote operations
+    [[nodiscard]] qint64 get_last_apply_ns() const { return last_apply_ns; }
+
+    // Wire format: a 32-bit length, then the protocol version and the operations
+    [[nodiscard]] static QByteArray encode(const std::vector<board_operation>& operations);
+    [[nodiscard]] static std::optional<std::vector<board_operation>> decode(const QByteArray& payload);
+
+    // Merges remote operations and applies the winners; returns them for relaying
+    std::vector<board_operation> receive(const std::vector<board_operation>& operations);
+
+signals:
+    void peers_changed(int count);
+    void session_error(const QString& message);
+
+private slots:
+    void on_board_changes_committed(const board_change_set& changes);
+    void on_mode_changed(GameMode mode);
+    void on_new_connection();
+
+private:
+    GameController* game_controller;
+    std::unique_ptr<board_replica> replica;
+    QTcpServer server;
+    QList<QTcpSocket*> peers;
+    bool applying_remote;
+    qint64 last_apply_ns;
+
+    void seed_from_board();
+    void capture_category(const board& game_board, size_t col, std::vector<board_operation>& out);
+    void capture_cell(const board& game_board, size_t row, size_t col, std::vector<board_operation>& out);
+    void apply(const board_operation& operation);
+    // Re-applies every register; used after a resize or when editing resumes
+    void apply_all();
+    void add_peer(QTcpSocket* socket);
+    void read_frames(QTcpSocket* socket);
+    void send(const std::vector<board_operation>& operations, QTcpSocket* except = nullptr);
+};
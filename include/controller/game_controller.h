@@ -1,18 +1,49 @@
 #pragma once
 
 #include "model/game_state.h"
+#include "model/state_snapshot.h"
+#include "model/win_probability.h"
 #include <QObject>
 #include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+// Everything a batch of edits touched, delivered once when the batch commits
+struct board_change_set {
+    bool reset = false;  // Dimensions changed or the whole board was replaced
+    std::set<size_t> categories;
+    std::set<std::pair<size_t, size_t>> cells;
+
+    [[nodiscard]] bool empty() const { return !reset && categories.empty() && cells.empty(); }
+};
 
 class GameController : public QObject {
     Q_OBJECT
 
 private:
     std::unique_ptr<GameState> game_state;
+    std::unique_ptr<win_probability_engine> win_engine;
+    std::vector<double> win_probabilities;
+    int batch_depth;
+    board_change_set pending_changes;
+    std::shared_ptr<snapshot_publisher> snapshots;  // Shared so readers on other threads may outlive us
+
+    void note_reset();
+    void note_category(size_t col);
+    void note_cell(size_t row, size_t col);
+    // Emits the pending change set unless a batch is still open
+    void commit_changes(bool closing_batch = false);
+    // Publish a new snapshot after a change outside the board contents
+    void publish_team(size_t team_index);
+    void publish_scores_reset();
+
+    // Re-estimates every team's chance to win in the background
+    void refresh_win_probabilities();
 
 public:
     explicit GameController(QObject* parent = nullptr);
-    ~GameController() = default;
+    ~GameController();
 
     
     void start_config_mode();
@@ -21,24 +52,47 @@ public:
 
     
     void configure_board_size(size_t rows, size_t cols);
-    void set_category_name(size_t col, const std::string& name);
-    void set_question_answer(size_t row, size_t col, const std::string& question, const std::string& answer);
+    void set_category_name(size_t col, const shared_text& name);
+    void set_question_answer(size_t row, size_t col, const shared_text& question, const shared_text& answer);
+    void set_question_media(size_t row, size_t col, const shared_text& path, MediaType type);
+    bool load_board(const board& loaded_board);
+    void clear_board();
+    void mark_board_saved();
+
+    // Edits made between begin_batch and the matching end_batch are reported as
+    // one change set when the outermost batch ends; prefer board_batch below
+    void begin_batch();
+    void end_batch();
+    [[nodiscard]] bool in_batch() const;
 
     
     bool select_cell(size_t row, size_t col);
     void add_to_score(int points);
     void subtract_from_score(int points);
+    void add_to_score(int points, size_t row, size_t col);
+    void subtract_from_score(int points, size_t row, size_t col);
     [[nodiscard]] int get_current_team_score() const;
     void reset_game();
 
     
     // Team management
     [[nodiscard]] const board* get_board() const;
+    // What the play path reads; null outside a game
+    [[nodiscard]] const play_board* get_play_board() const;
     [[nodiscard]] const std::vector<team>& get_teams() const;
     [[nodiscard]] const team& get_current_team() const;
-    bool add_team(const std::string& team_name);
+    bool add_team(const shared_text& team_name);
     void switch_to_next_team();
-    void set_team_name(size_t team_index, const std::string& new_name);
+    void set_team_name(size_t team_index, const shared_text& new_name);
+    
+    // Standings by score, each O(log n) plus the size of the answer
+    [[nodiscard]] size_t get_team_rank(size_t team_index) const;  // 1 = leading; ties share a rank
+    [[nodiscard]] std::vector<size_t> get_top_teams(size_t count) const;
+    [[nodiscard]] std::vector<size_t> get_teams_in_rank_range(size_t first, size_t count) const;
+    [[nodiscard]] size_t count_teams_scoring_between(int low, int high) const;
+    
+    [[nodiscard]] const turn_timer_settings& get_turn_timer_settings() const;
+    void set_turn_timer_settings(const turn_timer_settings& settings);
     
     // Point stealing functionality  
     bool can_current_team_attempt(size_t row, size_t col) const;
@@ -47,11 +101,46 @@ public:
     [[nodiscard]] size_t get_current_team_index() const;
     bool is_question_in_progress(size_t row, size_t col) const;
     void complete_question(size_t row, size_t col);
+    
+    // Latest published version of the game; safe to call from any thread, and the
+    // returned snapshot stays consistent however long it is held
+    [[nodiscard]] std::shared_ptr<const game_snapshot> get_snapshot() const;
+    // For consumers on other threads that must keep reading after the controller is gone
+    [[nodiscard]] std::shared_ptr<const snapshot_publisher> get_snapshot_publisher() const;
+
+    // Latest Monte Carlo estimate, indexed like get_teams(); empty until the first run finishes
+    [[nodiscard]] const std::vector<double>& get_win_probabilities() const;
 
 signals:
     void board_changed();
+    // Finer-grained companions of board_changed, emitted just before it
+    void board_reset();
+    // Only for edits made outside a batch; board_changes_committed covers both
+    void cell_content_changed(size_t row, size_t col);
+    void board_changes_committed(const board_change_set& changes);
     void mode_changed(GameMode new_mode);
     void score_changed(int new_score);
+    void score_event_recorded(size_t team_index, const score_event& event);
     void cell_selected(size_t row, size_t col);
+    // A team had its go at this clue
+    void attempts_changed(size_t row, size_t col);
     void team_changed(const team& current_team);
+    void team_added(size_t team_index);
+    void team_renamed(size_t team_index);
+    // Every score was cleared at once (new game or reset)
+    void scores_reset();
+    void win_probabilities_changed(const std::vector<double>& probabilities);
+};
+
+// Scoped batch: board_batch batch(controller); ...edits...
+class board_batch {
+public:
+    explicit board_batch(GameController* controller) : controller(controller) { controller->begin_batch(); }
+    ~board_batch() { controller->end_batch(); }
+
+    board_batch(const board_batch&) = delete;
+    board_batch& operator=(const board_batch&) = delete;
+
+private:
+    GameController* controller;
 };
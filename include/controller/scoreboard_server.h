@@ -0,0 +1,55 @@
+#pragma once
+
+#include "controller/game_controller.h"
+#include <QObject>
+#include <QString>
+#include <QThread>
+#include <atomic>
+
+class ScoreboardWorker;
+
+// Read-only HTTP/1.1 view of the game for venue screens and phones:
+//   GET /teams  teams, scores, whose turn it is and the mode
+//   GET /board  categories and point values; a clue's text appears once it is revealed
+//   GET /state  both of the above
+// Every response carries an ETag, and If-None-Match gets a 304. Adding ?wait=N
+// (seconds, at most MAX_WAIT_SECONDS) to a request whose ETag is still current
+// holds it until the state changes or the wait runs out.
+//
+// Connections are served on a thread of their own from published game
+// snapshots. Each response is serialized once per state change and then
+// reused, so the GUI thread only posts one wakeup per change. Connections
+// idle for IDLE_TIMEOUT_SECONDS outside a long poll are closed, and past
+// MAX_CLIENTS new ones get a 503.
+class ScoreboardServer : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr quint16 DEFAULT_PORT = 8468;
+    static constexpr int MAX_WAIT_SECONDS = 60;
+    static constexpr int MAX_REQUEST_BYTES = 16 * 1024;
+    static constexpr int IDLE_TIMEOUT_SECONDS = 30;
+    static constexpr int MAX_CLIENTS = 256;
+
+    explicit ScoreboardServer(GameController* controller, QObject* parent = nullptr);
+    ~ScoreboardServer();
+
+    // Listens on every interface; port 0 picks a free one
+    bool start(quint16 port, QString* error = nullptr);
+    void stop();
+
+    [[nodiscard]] bool is_running() const { return port.load() != 0; }
+    [[nodiscard]] quint16 get_port() const { return port.load(); }
+    [[nodiscard]] quint64 get_requests_served() const { return requests_served.load(); }
+
+private:
+    GameController* game_controller;
+    QThread worker_thread;
+    ScoreboardWorker* worker;
+    std::atomic<quint16> port;
+    std::atomic<quint64> requests_served;
+    // Set while a wakeup is queued, so a burst of signals for one change posts once
+    std::atomic<bool> wake_pending;
+
+    void on_state_changed();
+};
@@ -1,37 +1,85 @@
 #pragma once
 #include "model/cell.h"
+#include "util/memory_report.h"
+#include <memory>
 #include <vector>
 #include <string>
+#include <utility>
 
+using cell_position = std::pair<size_t, size_t>;
+
+// Copying a board is cheap: copies share their contents and their dirty
+// tracking until one of them is modified, which lets background consumers take
+// snapshots of the live board.
 class board {
 private:
-    std::vector<std::vector<cell>> cells;
-    std::vector<std::string> categories;
-    size_t rows;
-    size_t cols;
+    struct board_data {
+        std::vector<std::vector<cell>> cells;
+        std::vector<shared_text> categories;
+        size_t rows;
+        size_t cols;
+    };
+
+    // Content edits since the last mark_clean(). This lives beside the shared
+    // contents rather than in them, so a snapshot keeps the list of edits it
+    // contains while the live board starts a fresh one.
+    struct dirty_state {
+        std::vector<bool> cell_bits;  // Row-major, sized at mark_clean()
+        std::vector<cell_position> cell_list;
+        std::vector<bool> category_bits;
+        std::vector<size_t> category_list;
+    };
+
+    std::shared_ptr<board_data> data;
+    std::shared_ptr<dirty_state> dirty;
+    bool structure_dirty;  // Never saved, resized or replaced: only a full save will do
+
+    // Gives this board a private copy of its contents before a write
+    void detach();
+    void detach_dirty();
+    void mark_cell_dirty(size_t row, size_t col);
+    void mark_category_dirty(size_t col);
 
 public:
+    // Largest board a file or a peer may describe. Roomier than the editor's own
+    // limits so large generated banks still load.
+    static constexpr size_t MAX_ROWS = 200;
+    static constexpr size_t MAX_COLS = 200;
+
     explicit board(size_t rows = 5, size_t cols = 6);
     
     
     void resize_board(size_t new_rows, size_t new_cols);
-    void set_category(size_t col, const std::string& category);
-    void set_cell_content(size_t row, size_t col, const std::string& question, const std::string& answer);
+    void set_category(size_t col, const shared_text& category);
+    void set_cell_content(size_t row, size_t col, const shared_text& question, const shared_text& answer);
+    void set_cell_media(size_t row, size_t col, const shared_text& path, MediaType type);
     
     
     [[nodiscard]] size_t get_rows() const;
     [[nodiscard]] size_t get_cols() const;
     [[nodiscard]] const std::string& get_category(size_t col) const;
+    [[nodiscard]] const shared_text& get_category_text(size_t col) const;
     [[nodiscard]] const cell& get_cell(size_t row, size_t col) const;
     [[nodiscard]] cell& get_cell(size_t row, size_t col);
     
     
-    void reveal_cell(size_t row, size_t col);
-    void reset_board();
     [[nodiscard]] bool is_valid_position(size_t row, size_t col) const;
+    [[nodiscard]] bool shares_data_with(const board& other) const;
+    
+    // Dirty tracking for incremental saves
+    [[nodiscard]] bool needs_full_save() const;
+    [[nodiscard]] bool has_unsaved_changes() const;
+    [[nodiscard]] const std::vector<cell_position>& dirty_cells() const;
+    [[nodiscard]] const std::vector<size_t>& dirty_categories() const;
+    void mark_clean();
+    void mark_all_dirty();
     
     
     [[nodiscard]] int get_cell_points(size_t row) const;
     
+    // Memory accounting; each call is one pass over the cells
+    [[nodiscard]] memory_usage cell_memory() const;
+    [[nodiscard]] memory_usage text_memory() const;
+    
     ~board() = default;
 };
@@ -0,0 +1,21 @@
+#pragma once
+#include "model/board.h"
+#include <utility>
+#include <vector>
+
+// Content checks shared by the command-line validator and anything else that
+// needs to know whether a board is ready to play.
+struct board_analysis {
+    std::vector<cell_position> empty_cells;      // No question (ContentState::EMPTY)
+    std::vector<cell_position> missing_answers;  // Question without an answer
+    std::vector<std::vector<cell_position>> duplicate_questions;  // Cells sharing one question
+    std::vector<int> column_points;
+    int total_points = 0;
+    size_t media_cells = 0;
+
+    [[nodiscard]] bool has_problems() const {
+        return !empty_cells.empty() || !missing_answers.empty() || !duplicate_questions.empty();
+    }
+
+    [[nodiscard]] static board_analysis analyze(const board& game_board);
+};
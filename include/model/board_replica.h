@@ -0,0 +1,85 @@
+#pragma once
+#include "model/cell.h"
+#include "model/shared_text.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+// Lamport timestamp; the replica id breaks ties so every replica orders concurrent edits the same way
+struct crdt_stamp {
+    // Counters past this come from a broken or hostile peer; accepting one would let next_stamp() wrap
+    static constexpr uint64_t MAX_COUNTER = UINT64_MAX / 2;
+
+    uint64_t counter = 0;
+    uint32_t replica = 0;
+
+    [[nodiscard]] bool operator<(const crdt_stamp& other) const {
+        return counter != other.counter ? counter < other.counter : replica < other.replica;
+    }
+};
+
+enum class board_operation_kind : uint8_t {
+    DIMENSIONS,
+    CATEGORY,
+    CELL
+};
+
+// One last-writer-wins write to a board register. DIMENSIONS uses row and col
+// as the row and column counts; CATEGORY keeps its name in text.
+struct board_operation {
+    board_operation_kind kind = board_operation_kind::CELL;
+    crdt_stamp stamp;
+    uint32_t row = 0;
+    uint32_t col = 0;
+    shared_text text;  // Category name or question
+    shared_text answer;
+    shared_text media_path;
+    MediaType media_type = MediaType::NONE;
+
+    [[nodiscard]] uint64_t content_hash() const {
+        return cell::hash_content(text, answer, media_path, media_type);
+    }
+};
+
+// Conflict-free replicated state of a board being configured by several
+// editors. The dimensions, every category and every cell are independent
+// last-writer-wins registers, so merging is commutative, associative and
+// idempotent: replicas that have seen the same operations hold the same board
+// whatever order they arrived in. Registers outside the current dimensions are
+// kept, so a board that shrinks and grows again on another replica converges too.
+class board_replica {
+public:
+    explicit board_replica(uint32_t replica_id);
+
+    // Local edits: stamp, merge and return the operation to send to peers
+    board_operation set_dimensions(size_t rows, size_t cols);
+    board_operation set_category(size_t col, const shared_text& name);
+    board_operation set_cell(size_t row, size_t col, const shared_text& question, const shared_text& answer,
+                             const shared_text& media_path, MediaType media_type);
+
+    // Returns true if the operation won its register and so must be applied to the board
+    bool merge(const board_operation& operation);
+    // Every winning register, dimensions first; enough for a new peer to catch up
+    [[nodiscard]] std::vector<board_operation> state() const;
+
+    [[nodiscard]] const board_operation* find_category(size_t col) const;
+    [[nodiscard]] const board_operation* find_cell(size_t row, size_t col) const;
+    [[nodiscard]] const std::optional<board_operation>& get_dimensions() const { return dimensions; }
+
+    [[nodiscard]] uint32_t get_id() const { return replica_id; }
+    [[nodiscard]] uint64_t get_clock() const { return clock; }
+    [[nodiscard]] size_t register_count() const;
+
+private:
+    uint32_t replica_id;
+    uint64_t clock;
+    std::optional<board_operation> dimensions;
+    std::unordered_map<uint32_t, board_operation> categories;
+    std::unordered_map<uint64_t, board_operation> cells;
+
+    static uint64_t cell_key(uint32_t row, uint32_t col) { return (static_cast<uint64_t>(row) << 32) | col; }
+    crdt_stamp next_stamp();
+    bool merge_into(board_operation& current, const board_operation& operation);
+};
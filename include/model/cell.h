@@ -1,39 +1,63 @@
 #pragma once
 #include <iostream>
 #include <string>
-#include <set>
+#include <cstdint>
+#include "model/shared_text.h"
+
+enum class MediaType {
+    NONE,
+    IMAGE,
+    AUDIO,
+    VIDEO
+};
+
+// How far a cell has been filled in; whitespace-only text counts as missing
+enum class ContentState {
+    EMPTY,
+    QUESTION_ONLY,
+    COMPLETE
+};
 
 class cell {
 private:
-    std::string question;
-    std::string answer;
-    bool is_revealed;
+    shared_text question;
+    shared_text answer;
+    shared_text media_path;  // Optional picture/sound/video shown with the question
+    MediaType media_type;
     int points;
-    std::set<size_t> attempted_teams;  // Track which teams have attempted this question
+    uint64_t content_hash;  // Over question, answer and media; kept current by the setters
+
+    void refresh_content_hash();
 
 public:
-    cell(): is_revealed(false), points(0) {};
-    cell(std::string question, std::string answer, int points = 0, bool is_revealed = false):
-        question(std::move(question)), answer(std::move(answer)), points(points), is_revealed(is_revealed) {};
+    cell(): media_type(MediaType::NONE), points(0) { refresh_content_hash(); };
+    cell(std::string question, std::string answer, int points = 0):
+        question(std::move(question)), answer(std::move(answer)), media_type(MediaType::NONE),
+        points(points) { refresh_content_hash(); };
     
-    void set_question(const std::string& question);
-    void set_answer(const std::string& answer);
+    void set_question(const shared_text& question);
+    void set_answer(const shared_text& answer);
     void set_points(int points);
-    void set_is_revealed(bool is_revealed);
+    void set_media(const shared_text& path, MediaType type);
     
     [[nodiscard]] const std::string& get_question() const;
     [[nodiscard]] const std::string& get_answer() const;
     [[nodiscard]] int get_points() const;
-    [[nodiscard]] bool get_is_revealed() const;
-    
-    // Team attempt tracking
-    void add_attempted_team(size_t team_index);
-    [[nodiscard]] bool has_team_attempted(size_t team_index) const;
-    [[nodiscard]] const std::set<size_t>& get_attempted_teams() const;
-    void clear_attempted_teams();
-    
-    void reveal();
-    void reset();
+    [[nodiscard]] const std::string& get_media_path() const;
+    [[nodiscard]] MediaType get_media_type() const;
+    // The same text with its display encoding already built
+    [[nodiscard]] const shared_text& get_question_text() const { return question; }
+    [[nodiscard]] const shared_text& get_answer_text() const { return answer; }
+    [[nodiscard]] const shared_text& get_media_path_text() const { return media_path; }
+    [[nodiscard]] bool has_media() const;
+    [[nodiscard]] ContentState get_content_state() const;
+    [[nodiscard]] uint64_t get_content_hash() const { return content_hash; }
+    // Compares hashes first and the text only when they match, so a collision can't hide an edit
+    [[nodiscard]] bool has_content(const shared_text& question, const shared_text& answer, const shared_text& media_path,
+                                   MediaType media_type) const;
+    // Combines the hashes each shared_text computed when it was created, so no text is rescanned
+    [[nodiscard]] static uint64_t hash_content(const shared_text& question, const shared_text& answer,
+                                               const shared_text& media_path, MediaType media_type);
     
     ~cell() = default;
 };
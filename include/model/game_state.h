@@ -1,25 +1,41 @@
 #pragma once
 
 #include "model/board.h"
+#include "model/play_board.h"
 #include "model/team.h"
+#include "model/rank_index.h"
 #include <vector>
 #include <memory>
 #include <string>
+#include <chrono>
 
 enum class GameMode {
     CONFIG,
     PLAYING
 };
 
+// Seconds a team gets to answer; zero turns the countdown off
+struct turn_timer_settings {
+    int answer_seconds = 30;
+    int steal_seconds = 15;
+};
+
 class GameState {
 private:
     std::unique_ptr<board> game_board;
+    std::unique_ptr<play_board> play;  // Compiled at game start; null while configuring
     std::vector<team> teams;
+    rank_index team_ranks;  // Same indices as teams, kept in step with every score change
     GameMode current_mode;
     int current_team_index;
-    const size_t max_teams = 5;
+    turn_timer_settings timer_settings;
+    std::chrono::steady_clock::time_point game_started_at;
+    
+    void record_current_team_score_change(int delta, int row, int col);
 
 public:
+    static constexpr size_t MAX_TEAMS = 500;
+
     explicit GameState(size_t rows = 5, size_t cols = 6);
     ~GameState() = default;
 
@@ -30,23 +46,35 @@ public:
 
     
     void configure_board_size(size_t rows, size_t cols);
-    void set_category_name(size_t col, const std::string& name);
-    void set_question_answer(size_t row, size_t col, const std::string& question, const std::string& answer);
+    void set_category_name(size_t col, const shared_text& name);
+    void set_question_answer(size_t row, size_t col, const shared_text& question, const shared_text& answer);
+    void set_question_media(size_t row, size_t col, const shared_text& path, MediaType type);
+    bool load_board(const board& loaded_board);
+    // Called once the current contents are persisted; later edits are tracked as a delta
+    void mark_board_saved();
     [[nodiscard]] const board* get_board() const;
+    [[nodiscard]] const play_board* get_play_board() const;
 
     
     bool select_cell(size_t row, size_t col);
 
     
     // Team management
-    bool add_team(const std::string& team_name);
+    bool add_team(const shared_text& team_name);
     void switch_to_next_team();
     void add_to_current_team_score(int points);
     void subtract_from_current_team_score(int points);
+    // Variants that record which cell caused the change in the team's history
+    void add_to_current_team_score(int points, size_t row, size_t col);
+    void subtract_from_current_team_score(int points, size_t row, size_t col);
     [[nodiscard]] int get_current_team_score() const;
     [[nodiscard]] const team& get_current_team() const;
     [[nodiscard]] const std::vector<team>& get_teams() const;
-    void set_team_name(size_t team_index, const std::string& new_name);
+    void set_team_name(size_t team_index, const shared_text& new_name);
+    [[nodiscard]] const rank_index& get_team_ranks() const;
+    
+    [[nodiscard]] const turn_timer_settings& get_turn_timer_settings() const;
+    void set_turn_timer_settings(const turn_timer_settings& settings);
     
     // Point stealing functionality
     bool can_current_team_attempt(size_t row, size_t col) const;
@@ -56,12 +84,6 @@ public:
     bool is_question_in_progress(size_t row, size_t col) const;
     void complete_question(size_t row, size_t col);  // Mark question as fully completed
 
-private:
-    // Helper method to get mutable cell reference
-    cell& get_cell_mutable(size_t row, size_t col);
-
-public:
-
     // Game reset
     void reset_game();
 };
@@ -0,0 +1,69 @@
+#pragma once
+#include "model/board.h"
+#include "util/memory_report.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Read-only copy of a configured board, compiled once when a game starts and
+// read by everything on the play path. Text is interned into one table and
+// cells refer to it by index; each clue is a small fixed-size record in one
+// row-major array. The state that changes during play lives in separate packed
+// arrays: a revealed byte and an attempt count per cell, and one bit per team
+// and cell for the teams that already tried it. The editable board is never
+// written while a game runs.
+class play_board {
+public:
+    [[nodiscard]] static play_board compile(const board& source, size_t team_count);
+
+    [[nodiscard]] size_t get_rows() const { return rows; }
+    [[nodiscard]] size_t get_cols() const { return cols; }
+    [[nodiscard]] bool is_valid_position(size_t row, size_t col) const { return row < rows && col < cols; }
+
+    [[nodiscard]] const shared_text& get_category_text(size_t col) const;
+    [[nodiscard]] const shared_text& get_question_text(size_t row, size_t col) const { return texts[clue_at(row, col).question]; }
+    [[nodiscard]] const shared_text& get_answer_text(size_t row, size_t col) const { return texts[clue_at(row, col).answer]; }
+    [[nodiscard]] const shared_text& get_media_path_text(size_t row, size_t col) const { return texts[clue_at(row, col).media_path]; }
+    [[nodiscard]] MediaType get_media_type(size_t row, size_t col) const { return clue_at(row, col).media_type; }
+    [[nodiscard]] bool has_media(size_t row, size_t col) const { return get_media_type(row, col) != MediaType::NONE; }
+    [[nodiscard]] int get_points(size_t row, size_t col) const { return clue_at(row, col).points; }
+
+    [[nodiscard]] bool is_revealed(size_t row, size_t col) const { return revealed[index_of(row, col)] != 0; }
+    [[nodiscard]] bool has_team_attempted(size_t row, size_t col, size_t team_index) const;
+    [[nodiscard]] size_t attempt_count(size_t row, size_t col) const { return attempts[index_of(row, col)]; }
+    // Some team has tried the clue but nobody has finished it
+    [[nodiscard]] bool is_in_progress(size_t row, size_t col) const;
+    [[nodiscard]] std::vector<size_t> attempted_teams(size_t row, size_t col) const;
+    [[nodiscard]] size_t unrevealed_count() const { return rows * cols - revealed_total; }
+
+    void reveal(size_t row, size_t col);
+    void mark_attempted(size_t row, size_t col, size_t team_index);
+    // Widens the per-cell team bits when a team joins mid-game
+    void reserve_teams(size_t team_count);
+
+    [[nodiscard]] size_t interned_text_count() const { return texts.size(); }
+    [[nodiscard]] memory_usage memory() const;
+
+private:
+    struct clue {
+        uint32_t question;
+        uint32_t answer;
+        uint32_t media_path;
+        int32_t points;
+        MediaType media_type;
+    };
+
+    size_t rows = 0;
+    size_t cols = 0;
+    std::vector<shared_text> texts;  // Index 0 is the empty text
+    std::vector<uint32_t> categories;
+    std::vector<clue> clues;
+    std::vector<uint8_t> revealed;
+    std::vector<uint16_t> attempts;
+    std::vector<uint64_t> attempted_bits;  // words_per_cell words per cell
+    size_t words_per_cell = 1;
+    size_t revealed_total = 0;
+
+    [[nodiscard]] size_t index_of(size_t row, size_t col) const { return row * cols + col; }
+    [[nodiscard]] const clue& clue_at(size_t row, size_t col) const { return clues[index_of(row, col)]; }
+};
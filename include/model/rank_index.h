@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Teams ordered by score, highest first, ties broken by team index. Backed by a
+// treap with one node per team and subtree sizes, so a score change, a team's
+// rank, and the team at a given rank all take O(log n); a run of k consecutive
+// ranks costs O(log n + k). Teams are only ever appended, never removed.
+class rank_index {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    // Appends team number size() with the given score
+    void add(int score);
+    void update(size_t team_index, int new_score);
+    // Resets every team to the same score, keeping the team count
+    void reset(int score = 0);
+    void clear();
+
+    [[nodiscard]] size_t size() const { return nodes.size(); }
+    [[nodiscard]] int score_of(size_t team_index) const { return nodes[team_index].score; }
+    // Zero-based position in the ordering; equal scores are ordered by team index
+    [[nodiscard]] size_t position_of(size_t team_index) const;
+    // One-based competition rank: teams with equal scores share a rank
+    [[nodiscard]] size_t rank_of(size_t team_index) const;
+    [[nodiscard]] size_t team_at(size_t position) const;
+    // Teams at positions [first, first + count), clipped to size()
+    [[nodiscard]] std::vector<size_t> range(size_t first, size_t count) const;
+    [[nodiscard]] std::vector<size_t> top(size_t count) const { return range(0, count); }
+    [[nodiscard]] size_t count_at_least(int score) const;
+    [[nodiscard]] size_t count_between(int low, int high) const;
+
+    [[nodiscard]] size_t heap_bytes() const { return nodes.capacity() * sizeof(node); }
+
+private:
+    struct node {
+        int score;
+        uint32_t priority;
+        uint32_t left = NONE;
+        uint32_t right = NONE;
+        uint32_t size = 1;
+    };
+
+    std::vector<node> nodes;
+    uint32_t root = NONE;
+
+    [[nodiscard]] uint32_t size_of(uint32_t n) const { return n == NONE ? 0 : nodes[n].size; }
+    void pull(uint32_t n) { nodes[n].size = 1 + size_of(nodes[n].left) + size_of(nodes[n].right); }
+    // True when a sorts ahead of b
+    [[nodiscard]] bool ahead(uint32_t a, uint32_t b) const {
+        return nodes[a].score != nodes[b].score ? nodes[a].score > nodes[b].score : a < b;
+    }
+
+    uint32_t merge(uint32_t a, uint32_t b);
+    uint32_t insert(uint32_t n, uint32_t item);
+    uint32_t erase(uint32_t n, uint32_t item);
+    void collect(uint32_t n, size_t first, size_t count, std::vector<size_t>& out) const;
+};
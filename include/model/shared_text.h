@@ -0,0 +1,41 @@
+#pragma once
+#include <QString>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Immutable text that keeps both encodings: the UTF-8 std::string used by the
+// model and storage, and the UTF-16 QString the views display. The conversion
+// happens once, when the text is created; copies share one payload, and reading
+// either form hands out a reference without transcoding or allocating.
+class shared_text {
+private:
+    struct payload {
+        std::string utf8;
+        QString utf16;
+        bool blank;  // Empty or whitespace only
+        uint64_t hash;  // 64-bit FNV-1a of utf8
+    };
+
+    std::shared_ptr<const payload> data;  // Null for the empty text
+
+    static const payload& empty_payload();
+    const payload& get() const { return data ? *data : empty_payload(); }
+
+public:
+    shared_text() = default;
+    shared_text(const char* utf8);
+    shared_text(const std::string& utf8);
+    shared_text(const QString& utf16);
+
+    [[nodiscard]] const std::string& str() const { return get().utf8; }
+    [[nodiscard]] const QString& qstr() const { return get().utf16; }
+    [[nodiscard]] bool empty() const { return get().utf8.empty(); }
+    [[nodiscard]] bool is_blank() const { return get().blank; }
+    [[nodiscard]] uint64_t hash() const { return get().hash; }
+    // Heap held by the payload, counted in full by every holder of a shared copy
+    [[nodiscard]] size_t heap_bytes() const;
+
+    bool operator==(const shared_text& other) const { return data == other.data || str() == other.str(); }
+    bool operator!=(const shared_text& other) const { return !(*this == other); }
+};
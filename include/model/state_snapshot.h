@@ -0,0 +1,80 @@
+#pragma once
+#include "model/board.h"
+#include "model/game_state.h"
+#include "model/team.h"
+#include "util/shared_chunks.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct snapshot_cell {
+    shared_text question;
+    shared_text answer;
+    shared_text media_path;
+    MediaType media_type = MediaType::NONE;
+    int points = 0;
+};
+
+struct snapshot_team {
+    shared_text name;
+    int score = 0;
+};
+
+// One immutable version of the game. Any thread may keep reading it for as
+// long as it holds the pointer; the GUI thread never changes a published
+// version, it publishes a new one.
+struct game_snapshot {
+    uint64_t version = 0;
+    // The version that last changed each part, so consumers can cache per part
+    uint64_t board_version = 0;  // Categories, cells and revealed flags
+    uint64_t teams_version = 0;  // Teams, current team and mode
+    GameMode mode = GameMode::CONFIG;
+    size_t rows = 0;
+    size_t cols = 0;
+    size_t current_team = 0;
+    int64_t total_score = 0;  // Sum over teams, kept alongside them as a consistency check
+    shared_chunks<shared_text> categories;
+    shared_chunks<snapshot_cell> cells;  // Row-major
+    shared_chunks<uint8_t> revealed;     // Row-major; all clear outside a game
+    shared_chunks<snapshot_team> teams;
+
+    [[nodiscard]] const snapshot_cell& cell_at(size_t row, size_t col) const { return cells[row * cols + col]; }
+    [[nodiscard]] bool is_revealed(size_t row, size_t col) const { return revealed[row * cols + col] != 0; }
+};
+
+// Read-copy-update publication of game_snapshot. The owning thread edits a
+// draft and publish() swaps in an immutable copy of it; current() is one atomic
+// load from any thread. A copy shares every chunk the edits did not touch, so
+// publishing costs the touched chunks plus one pointer per chunk.
+class snapshot_publisher {
+private:
+    game_snapshot draft;
+    bool board_touched = true;
+    bool teams_touched = true;
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<std::shared_ptr<const game_snapshot>> published;
+#else
+    std::shared_ptr<const game_snapshot> published;  // Only touched through std::atomic_load/atomic_store
+#endif
+
+public:
+    snapshot_publisher();
+
+    // Safe from any thread
+    [[nodiscard]] std::shared_ptr<const game_snapshot> current() const;
+
+    // Draft edits, owning thread only; none is visible until publish()
+    void load_board(const board& source);
+    void set_category(size_t col, const shared_text& name);
+    void set_cell(size_t row, size_t col, const cell& source);
+    void set_revealed(size_t row, size_t col);
+    void clear_revealed();
+    void load_teams(const std::vector<team>& source);
+    // An index one past the last team appends it
+    void set_team(size_t team_index, const team& source);
+    void set_mode(GameMode mode);
+    void set_current_team(size_t team_index);
+
+    void publish();
+};
@@ -1,20 +1,41 @@
 #pragma once
 #include <iostream>
+#include <cstdint>
+#include "util/ring_buffer.h"
+#include "model/shared_text.h"
 
+struct score_event {
+    int64_t timestamp_ms;  // Since the game started
+    int delta;
+    int score;             // Score after the change
+    int row;               // Cell that caused the change, -1 if none
+    int col;
+};
 
 class team {
     private:
-        std::string name;
+        shared_text name;
         int score;
+        ring_buffer<score_event> history;
 
     public:
-        team(const std::string& team_name, int initial_score = 0) 
-        : name(std::move(team_name)), score(initial_score) {}
+        static constexpr size_t HISTORY_CAPACITY = 256;
+
+        team(const shared_text& team_name, int initial_score = 0) 
+        : name(team_name), score(initial_score), history(HISTORY_CAPACITY) {}
         
-        const std::string& get_name() const { return name; }
-        void set_name(const std::string& new_name) { name = new_name; }
-        void set_name(std::string&& new_name) { name = std::move(new_name); }
+        const std::string& get_name() const { return name.str(); }
+        const shared_text& get_name_text() const { return name; }
+        void set_name(const shared_text& new_name) { name = new_name; }
 
         int get_score() const { return score; }
         void set_score(int new_score) { score = new_score; }
-};
\ No newline at end of file
+
+        void record_score_change(int delta, int64_t timestamp_ms, int row = -1, int col = -1) {
+            score += delta;
+            history.push({timestamp_ms, delta, score, row, col});
+        }
+        const ring_buffer<score_event>& get_history() const { return history; }
+        void clear_history() { history.clear(); }
+        size_t heap_bytes() const { return history.capacity() * sizeof(score_event) + name.heap_bytes(); }
+};
@@ -0,0 +1,84 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+struct win_probability_input {
+    std::vector<int> scores;            // Current score of every team
+    std::vector<int> remaining_points;  // Points of every unrevealed cell
+    size_t current_team = 0;            // Team that picks the next cell
+};
+
+struct win_probability_result {
+    std::vector<double> probabilities;  // Chance of finishing first, ties split evenly
+    uint64_t simulations = 0;
+    double elapsed_ms = 0.0;
+};
+
+// Monte Carlo estimate of each team's chance to win from the current position.
+// Every remaining cell is played out: the picking team and then each stealing
+// team answers correctly with CORRECT_PROBABILITY, wrong answers cost the cell's
+// points. Simulations run in lanes of LANES games so the per-team score update
+// is branch-free and vectorizes; each worker thread owns its own PRNG.
+class win_probability_engine {
+public:
+    static constexpr double CORRECT_PROBABILITY = 0.6;
+    static constexpr size_t LANES = 16;
+    static constexpr int TIME_BUDGET_MS = 40;
+    static constexpr uint64_t MAX_SIMULATIONS = 2'000'000;
+
+    using result_callback = std::function<void(const win_probability_result&)>;
+
+    explicit win_probability_engine(size_t thread_count = 0);
+    ~win_probability_engine();
+
+    win_probability_engine(const win_probability_engine&) = delete;
+    win_probability_engine& operator=(const win_probability_engine&) = delete;
+
+    // Replaces any queued or running estimate; the callback runs on a background thread
+    void request(win_probability_input input, result_callback on_result);
+    void cancel();
+
+    // Synchronous run used by benchmarks; waits for any estimate in flight
+    [[nodiscard]] win_probability_result simulate(const win_probability_input& input, uint64_t max_simulations,
+                                                  int time_budget_ms, uint64_t seed);
+
+private:
+    struct job {
+        win_probability_input input;
+        result_callback on_result;
+        uint64_t generation;  // The request's own; a newer one makes the result stale
+    };
+
+    size_t thread_count;
+    std::thread coordinator;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::optional<job> pending;
+    std::atomic<uint64_t> generation;  // Only bumped while holding mutex
+    bool stopping;
+
+    // Helpers stay parked between estimates rather than being started for each one
+    std::vector<std::thread> helpers;
+    std::mutex helper_mutex;
+    std::condition_variable helper_wake;
+    std::condition_variable helper_done;
+    const std::function<void(size_t)>* helper_task;
+    uint64_t helper_round;
+    size_t helpers_running;
+    bool helpers_stopping;
+    std::mutex run_mutex;  // One run owns the helpers at a time
+
+    void coordinator_loop();
+    void helper_loop(size_t worker_index);
+    // Runs task(0) here and task(1..thread_count-1) on the helpers, then waits for all of them
+    void run_on_workers(const std::function<void(size_t)>& task);
+    // Stops early once generation moves past job_generation
+    win_probability_result run(const win_probability_input& input, uint64_t max_simulations,
+                               int time_budget_ms, uint64_t seed, uint64_t job_generation);
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <QByteArray>
+#include <QString>
+#include <optional>
+#include "model/board.h"
+
+enum class board_format {
+    JSON_LINES,    // .jpdy: appendable, what autosave writes
+    JSON_DOCUMENT  // .json: one object, for hand editing and other tools
+};
+
+// Board files are JSON Lines: a header record followed by one record per
+// category and per cell. Later records for the same category or cell replace
+// earlier ones, so a file can be extended by appending. The same records can
+// also be stored as a single JSON document with "categories" and "cells" arrays.
+class board_file {
+public:
+    static constexpr int FORMAT_VERSION = 1;
+
+    [[nodiscard]] static QByteArray serialize(const board& game_board, board_format format = board_format::JSON_LINES);
+    [[nodiscard]] static std::optional<board> parse(const QByteArray& data, QString* error = nullptr);
+    [[nodiscard]] static std::optional<board> parse_document(const QByteArray& data, QString* error = nullptr);
+
+    // The format follows the file suffix. Writes go to a temporary file that is renamed over the target
+    static bool write(const QString& path, const board& game_board, QString* error = nullptr);
+    // Appends records for the board's dirty categories and cells to an existing .jpdy file
+    static bool append_delta(const QString& path, const board& game_board, QString* error = nullptr);
+    [[nodiscard]] static size_t delta_record_count(const board& game_board);
+    [[nodiscard]] static std::optional<board> read(const QString& path, QString* error = nullptr);
+
+    [[nodiscard]] static board_format format_for_path(const QString& path);
+    [[nodiscard]] static QString format_suffix(board_format format);
+
+    [[nodiscard]] static QString media_type_name(MediaType type);
+    [[nodiscard]] static MediaType media_type_from_name(const QString& name);
+};
@@ -0,0 +1,9 @@
+#pragma once
+#include <string>
+
+// Micro-benchmarks runnable from the command line: jpdy --benchmark <name>
+class benchmarks {
+public:
+    // Returns a process exit code; prints results to stdout
+    static int run(const std::string& name);
+};
@@ -0,0 +1,12 @@
+#pragma once
+#include <string>
+
+// Headless board tools: jpdy validate|stats|convert ... They run before any
+// Qt application object exists, so nothing GUI-related is loaded or
+// initialized. Files are processed in parallel and reported in argument order.
+class command_line_tool {
+public:
+    [[nodiscard]] static bool handles(const std::string& command);
+    // Returns a process exit code: 0 success, 1 problems found, 2 usage error
+    static int run(int argc, char* argv[]);
+};
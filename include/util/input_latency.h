@@ -0,0 +1,50 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include "util/trace.h"
+
+// Time from a key press to the first paint that can show its result. Both ends
+// are marked on the GUI thread; presses that arrive before the paint are
+// folded into the earliest one.
+class input_latency {
+public:
+    static constexpr double FRAME_BUDGET_MS = 1000.0 / 60.0;
+
+    // Call once the press is known to change something; pass the time it arrived
+    void input_received(uint64_t received_ns) {
+        if (pending_ns == 0) {
+            pending_ns = received_ns;
+        }
+    }
+
+    void frame_presented() {
+        if (pending_ns == 0) return;
+        const uint64_t now = tracer::now_ns();
+        if (tracer::enabled()) {
+            tracer::record_span("input_latency::key_to_paint", pending_ns, now);
+        }
+        const double elapsed_ms = static_cast<double>(now - pending_ns) / 1e6;
+        pending_ns = 0;
+        ++samples;
+        over_budget += elapsed_ms > FRAME_BUDGET_MS;
+        last_ms = elapsed_ms;
+        worst_ms = std::max(worst_ms, elapsed_ms);
+        total_ms += elapsed_ms;
+    }
+
+    void reset() { *this = input_latency(); }
+
+    [[nodiscard]] uint64_t sample_count() const { return samples; }
+    [[nodiscard]] uint64_t over_budget_count() const { return over_budget; }
+    [[nodiscard]] double last() const { return last_ms; }
+    [[nodiscard]] double worst() const { return worst_ms; }
+    [[nodiscard]] double average() const { return samples ? total_ms / static_cast<double>(samples) : 0.0; }
+
+private:
+    uint64_t pending_ns = 0;
+    uint64_t samples = 0;
+    uint64_t over_budget = 0;
+    double last_ms = 0.0;
+    double worst_ms = 0.0;
+    double total_ms = 0.0;
+};
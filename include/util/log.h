@@ -0,0 +1,156 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+enum class LogLevel : uint8_t {
+    VERBOSE,
+    INFO,
+    WARNING,
+    CRITICAL
+};
+
+enum class LogCategory : uint8_t {
+    GENERAL,
+    ANIMATION,
+    STORAGE,
+    NETWORK,
+    COUNT
+};
+
+// One message as the calling thread left it: the format string and its raw
+// arguments. Turning it into text is left to the flusher thread.
+struct log_record {
+    static constexpr size_t MAX_ARGS = 6;
+    static constexpr size_t TEXT_BYTES = 112;  // Shared by every string argument; longer ones are cut
+
+    enum class arg_kind : uint8_t { SIGNED, UNSIGNED, REAL, TEXT };
+
+    union arg_value {
+        int64_t signed_value;
+        uint64_t unsigned_value;
+        double real_value;
+        struct {
+            uint8_t offset;
+            uint8_t length;
+        } text;
+    };
+
+    uint64_t timestamp_ns;
+    const char* format;  // "{}" marks each argument; must be a string literal
+    LogLevel level;
+    LogCategory category;
+    uint8_t arg_count;
+    uint8_t text_used;
+    arg_kind kinds[MAX_ARGS];
+    arg_value values[MAX_ARGS];
+    char text[TEXT_BYTES];
+
+    // Arguments past MAX_ARGS are dropped
+    void add(std::signed_integral auto value) {
+        if (arg_count == MAX_ARGS) return;
+        kinds[arg_count] = arg_kind::SIGNED;
+        values[arg_count++].signed_value = value;
+    }
+    void add(std::unsigned_integral auto value) {
+        if (arg_count == MAX_ARGS) return;
+        kinds[arg_count] = arg_kind::UNSIGNED;
+        values[arg_count++].unsigned_value = value;
+    }
+    void add(bool value) { add(value ? "true" : "false"); }
+    void add(std::floating_point auto value) {
+        if (arg_count == MAX_ARGS) return;
+        kinds[arg_count] = arg_kind::REAL;
+        values[arg_count++].real_value = value;
+    }
+    // Copied, so the caller's string may die as soon as the call returns
+    void add(std::string_view value) {
+        if (arg_count == MAX_ARGS) return;
+        size_t length = std::min(value.size(), TEXT_BYTES - text_used);
+        std::memcpy(text + text_used, value.data(), length);
+        kinds[arg_count] = arg_kind::TEXT;
+        values[arg_count].text.offset = text_used;
+        values[arg_count++].text.length = static_cast<uint8_t>(length);
+        text_used += static_cast<uint8_t>(length);
+    }
+    void add(const char* value) { add(std::string_view(value ? value : "(null)")); }
+    void add(const std::string& value) { add(std::string_view(value)); }
+};
+
+struct log_settings {
+    std::string path;                          // Empty: no file
+    size_t max_file_bytes = 1024 * 1024;       // Rotated once a file grows past this
+    int kept_files = 3;                        // Rotated copies kept beside it: path.1 ... path.N
+    LogLevel stderr_level = LogLevel::WARNING; // Messages from this level up are also echoed to stderr
+};
+
+// Structured, asynchronous logging. Each thread writes records into its own
+// ring buffer without locks or formatting; a background thread formats them
+// and writes them to a rotating file. A full buffer drops the record and counts
+// it rather than blocking. The flusher sleeps until a record arrives, so an
+// idle application never wakes it.
+class logger {
+public:
+    static constexpr size_t RECORDS_PER_THREAD = 1024;
+    static constexpr int FLUSH_INTERVAL_MS = 100;
+
+    // Starts the flusher; returns false if the file could not be opened (stderr still works)
+    static bool start(const log_settings& settings);
+    // Writes everything buffered and stops the flusher
+    static void stop();
+    // Writes everything buffered so far before returning
+    static void flush();
+
+    static void set_min_level(LogLevel level);
+    static void set_category_enabled(LogCategory category, bool enabled);
+    [[nodiscard]] static bool should_log(LogLevel level, LogCategory category) {
+        uint32_t current = filter.load(std::memory_order_relaxed);
+        return static_cast<uint32_t>(level) >= (current >> LEVEL_SHIFT) &&
+               (current & (1u << static_cast<uint32_t>(category))) != 0;
+    }
+    [[nodiscard]] static uint64_t dropped_count();
+
+    [[nodiscard]] static const char* level_name(LogLevel level);
+    [[nodiscard]] static const char* category_name(LogCategory category);
+    // Accepts the names level_name() returns, in any case
+    static bool parse_level(std::string_view name, LogLevel& level);
+
+    template <typename... Args>
+    static void write(LogLevel level, LogCategory category, const char* format, const Args&... args) {
+        log_record* record = begin_record();
+        if (!record) return;
+        record->level = level;
+        record->category = category;
+        record->format = format;
+        record->arg_count = 0;
+        record->text_used = 0;
+        (record->add(args), ...);
+        commit_record();
+    }
+
+private:
+    static constexpr uint32_t LEVEL_SHIFT = 16;
+    static inline std::atomic<uint32_t> filter{(static_cast<uint32_t>(LogLevel::INFO) << LEVEL_SHIFT) | 0xffffu};
+
+    // Claims the calling thread's next slot, stamped with the time; null when the buffer is full
+    static log_record* begin_record();
+    static void commit_record();
+};
+
+#define LOG_AT(level, category, ...)                              \
+    do {                                                          \
+        if (logger::should_log(level, category)) [[unlikely]] {   \
+            logger::write(level, category, __VA_ARGS__);          \
+        }                                                         \
+    } while (0)
+
+// LOG_WARNING(LogCategory::STORAGE, "Could not write {}: {}", path, error);
+#define LOG_VERBOSE(category, ...) LOG_AT(LogLevel::VERBOSE, category, __VA_ARGS__)
+#define LOG_INFO(category, ...) LOG_AT(LogLevel::INFO, category, __VA_ARGS__)
+#define LOG_WARNING(category, ...) LOG_AT(LogLevel::WARNING, category, __VA_ARGS__)
+#define LOG_CRITICAL(category, ...) LOG_AT(LogLevel::CRITICAL, category, __VA_ARGS__)
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct memory_usage {
+    size_t objects = 0;
+    size_t bytes = 0;
+
+    memory_usage& operator+=(const memory_usage& other) {
+        objects += other.objects;
+        bytes += other.bytes;
+        return *this;
+    }
+};
+
+// One sample of per-subsystem memory use. Byte counts are computed from the
+// containers' capacities rather than by hooking the allocator, so a sample costs
+// a walk over the board and the widget trees and can be taken every second.
+class memory_report {
+public:
+    struct entry {
+        std::string subsystem;
+        size_t objects;
+        std::optional<size_t> bytes;  // Unset when only the object count is known
+    };
+
+    void add(const std::string& subsystem, const memory_usage& usage);
+    void add_count(const std::string& subsystem, size_t objects);
+
+    [[nodiscard]] const std::vector<entry>& entries() const { return rows; }
+    [[nodiscard]] size_t measured_bytes() const;
+    [[nodiscard]] std::string to_text() const;
+
+private:
+    std::vector<entry> rows;
+};
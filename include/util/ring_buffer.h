@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fixed-capacity FIFO that overwrites its oldest entry once full. Storage is
+// allocated up front, so pushing never allocates. Every push gets a sequence
+// number, letting readers ask for "everything after the last one I saw".
+template <typename T>
+class ring_buffer {
+private:
+    std::vector<T> slots;
+    size_t head;      // Index of the next write
+    size_t count;
+    uint64_t pushed;  // Sequence number of the next push
+
+public:
+    explicit ring_buffer(size_t capacity) : slots(capacity), head(0), count(0), pushed(0) {}
+
+    void push(const T& value) {
+        if (slots.empty()) return;
+        slots[head] = value;
+        head = (head + 1) % slots.size();
+        if (count < slots.size()) ++count;
+        ++pushed;
+    }
+
+    void clear() {
+        head = 0;
+        count = 0;
+        pushed = 0;
+    }
+
+    [[nodiscard]] size_t size() const { return count; }
+    [[nodiscard]] size_t capacity() const { return slots.size(); }
+    [[nodiscard]] bool empty() const { return count == 0; }
+
+    // Sequence numbers of the oldest retained entry and of the next push
+    [[nodiscard]] uint64_t first_sequence() const { return pushed - count; }
+    [[nodiscard]] uint64_t end_sequence() const { return pushed; }
+
+    // 0 is the oldest retained entry
+    [[nodiscard]] const T& at(size_t index) const {
+        return slots[(head + slots.size() - count + index) % slots.size()];
+    }
+
+    [[nodiscard]] const T& back() const { return at(count - 1); }
+
+    // Caller must check first_sequence() <= sequence < end_sequence()
+    [[nodiscard]] const T& at_sequence(uint64_t sequence) const {
+        return at(static_cast<size_t>(sequence - first_sequence()));
+    }
+};
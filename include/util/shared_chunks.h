@@ -0,0 +1,70 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Array stored as fixed-size blocks that copies share. Copying it copies one
+// pointer per block; writing clones the touched block first if any copy still
+// holds it. Only one holder may write; copies handed to other threads are
+// read-only, which is what lets them be read without locks.
+template <typename T>
+class shared_chunks {
+private:
+    using block = std::vector<T>;
+
+    std::vector<std::shared_ptr<block>> blocks;
+    size_t count = 0;
+
+    block& writable(size_t block_index) {
+        std::shared_ptr<block>& target = blocks[block_index];
+        if (target.use_count() > 1) {
+            target = std::make_shared<block>(*target);
+        } else {
+            // The last reader's release of its reference must be seen before we overwrite
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *target;
+    }
+
+public:
+    static constexpr size_t CHUNK = 64;
+
+    shared_chunks() = default;
+    explicit shared_chunks(size_t size, const T& fill = T()) { assign(size, fill); }
+
+    void assign(size_t size, const T& fill = T()) {
+        blocks.clear();
+        blocks.reserve((size + CHUNK - 1) / CHUNK);
+        for (size_t first = 0; first < size; first += CHUNK) {
+            blocks.push_back(std::make_shared<block>(std::min(CHUNK, size - first), fill));
+        }
+        count = size;
+    }
+
+    void push_back(const T& value) {
+        if (count % CHUNK == 0) {
+            blocks.push_back(std::make_shared<block>());
+            blocks.back()->reserve(CHUNK);
+        }
+        writable(blocks.size() - 1).push_back(value);
+        ++count;
+    }
+
+    void set(size_t index, const T& value) { writable(index / CHUNK)[index % CHUNK] = value; }
+
+    [[nodiscard]] const T& operator[](size_t index) const { return (*blocks[index / CHUNK])[index % CHUNK]; }
+    [[nodiscard]] size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] size_t chunk_count() const { return blocks.size(); }
+
+    // Blocks held in common with another copy, compared position by position
+    [[nodiscard]] size_t chunks_shared_with(const shared_chunks& other) const {
+        size_t shared = 0;
+        for (size_t i = 0; i < std::min(blocks.size(), other.blocks.size()); ++i) {
+            if (blocks[i] == other.blocks[i]) ++shared;
+        }
+        return shared;
+    }
+};
@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+
+// Milestones measured from static initialization of the executable, which is the
+// earliest point the process can observe after the dynamic loader has run.
+class startup_timer {
+public:
+    static void mark(const std::string& milestone);
+    [[nodiscard]] static double elapsed_ms();
+    [[nodiscard]] static const std::vector<std::pair<std::string, double>>& milestones();
+    [[nodiscard]] static std::string report();
+};
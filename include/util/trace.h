@@ -0,0 +1,63 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Scoped-span tracing. Each thread records into its own fixed-size ring buffer,
+// the buffers can be exported as Chrome trace JSON (chrome://tracing, Perfetto).
+// When tracing is disabled a span costs one relaxed load and one branch.
+class tracer {
+public:
+    static constexpr size_t EVENTS_PER_THREAD = 16384;
+
+    static void set_enabled(bool enabled) { enabled_flag.store(enabled, std::memory_order_relaxed); }
+    [[nodiscard]] static bool enabled() { return enabled_flag.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] static uint64_t now_ns();
+    static void record_span(const char* name, uint64_t start_ns, uint64_t end_ns);
+    static void record_instant(const char* name);
+    static void set_thread_name(const std::string& name);
+
+    // Writes every buffered event; returns false if the file could not be written
+    static bool export_chrome_trace(const std::string& path);
+    // Drops everything recorded so far; safe while other threads are tracing
+    static void clear();
+
+private:
+    static inline std::atomic<bool> enabled_flag{false};
+};
+
+class trace_span {
+private:
+    const char* name;
+    uint64_t start_ns;
+
+public:
+    explicit trace_span(const char* name) : name(name), start_ns(0) {
+        if (tracer::enabled()) [[unlikely]] {
+            start_ns = tracer::now_ns();
+        }
+    }
+
+    ~trace_span() {
+        if (start_ns != 0) [[unlikely]] {
+            tracer::record_span(name, start_ns, tracer::now_ns());
+        }
+    }
+
+    trace_span(const trace_span&) = delete;
+    trace_span& operator=(const trace_span&) = delete;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+// Span names must be string literals (or otherwise outlive the trace)
+#define TRACE_SCOPE(name) trace_span TRACE_CONCAT(trace_span_, __LINE__)(name)
+
+#define TRACE_INSTANT(name)                      \
+    do {                                         \
+        if (tracer::enabled()) [[unlikely]] {    \
+            tracer::record_instant(name);        \
+        }                                        \
+    } while (0)
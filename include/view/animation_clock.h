@@ -0,0 +1,76 @@
+#pragma once
+#include <QObject>
+#include <QEasingCurve>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QTimer>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+struct animation_frame_stats {
+    uint64_t frames = 0;
+    uint64_t late_frames = 0;      // Ticks that arrived more than half a frame late
+    double last_cost_ms = 0.0;     // Time spent advancing effects in one tick
+    double worst_cost_ms = 0.0;
+    double total_cost_ms = 0.0;
+    double worst_interval_ms = 0.0;
+
+    [[nodiscard]] double average_cost_ms() const { return frames ? total_cost_ms / static_cast<double>(frames) : 0.0; }
+};
+
+// One frame tick shared by every effect in the application. Effects are plain
+// step callbacks that receive eased progress, so concurrent animations advance
+// in the same frame. The timer only runs while at least one effect is active.
+class AnimationClock : public QObject {
+    Q_OBJECT
+
+public:
+    using effect_id = uint64_t;
+    using step_function = std::function<void(double progress)>;
+    using finish_function = std::function<void()>;
+
+    static constexpr int FRAME_INTERVAL_MS = 16;
+
+    explicit AnimationClock(QObject* parent = nullptr);
+
+    // Steps immediately with progress 0 unless delayed. The effect is dropped
+    // without finishing if target is destroyed first.
+    effect_id start(QObject* target, int duration_ms, const QEasingCurve& curve, step_function step,
+                    finish_function on_finished = {}, int delay_ms = 0);
+    // Removes the effect without calling its finish callback
+    void stop(effect_id id);
+
+    [[nodiscard]] bool is_running(effect_id id) const;
+    [[nodiscard]] bool is_active() const { return frame_timer.isActive(); }
+    [[nodiscard]] size_t active_count() const;
+    [[nodiscard]] const animation_frame_stats& frame_stats() const { return stats; }
+    void reset_frame_stats() { stats = {}; }
+
+signals:
+    void idle();
+
+private:
+    struct effect {
+        effect_id id;
+        QPointer<QObject> target;
+        qint64 start_ms;
+        int duration_ms;
+        QEasingCurve curve;
+        step_function step;
+        finish_function on_finished;
+        bool removed;
+    };
+
+    QTimer frame_timer;
+    QElapsedTimer clock;
+    std::vector<effect> effects;
+    effect_id next_id;
+    qint64 last_tick_ms;
+    bool ticking;
+    animation_frame_stats stats;
+
+    void tick();
+    void compact();
+    void stop_if_idle();
+};
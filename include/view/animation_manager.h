@@ -1,18 +1,17 @@
 #pragma once
 #include <QObject>
-#include <QPropertyAnimation>
-#include <QSequentialAnimationGroup>
-#include <QParallelAnimationGroup>
 #include <QGraphicsOpacityEffect>
-#include <QTimer>
 #include <QLabel>
 #include <QWidget>
+#include <functional>
+#include <vector>
+#include "view/animation_clock.h"
 
 class AnimationManager : public QObject {
     Q_OBJECT
 
 public:
-    explicit AnimationManager(QWidget* parent_widget, QObject* parent = nullptr);
+    AnimationManager(QWidget* parent_widget, AnimationClock* clock, QObject* parent = nullptr);
     ~AnimationManager();
 
     void setup_animations();
@@ -29,8 +28,6 @@ signals:
     void incorrect_animation_finished();
 
 private slots:
-    void on_correct_animation_timeout();
-    void on_incorrect_animation_timeout();
     void on_correct_sequence_finished();
     void on_incorrect_sequence_finished();
 
@@ -39,18 +36,15 @@ private:
     static constexpr int OVERLAY_FADE_DURATION = 300;
     static constexpr int POINTS_COUNT_DURATION = 800;
     static constexpr int SHAKE_DURATION = 400;
-    static constexpr int DIALOG_FADE_DURATION = 500;
-    static constexpr int TOTAL_CORRECT_DURATION = 1200;
-    static constexpr int TOTAL_INCORRECT_DURATION = 900;
 
     // Parent widget reference
     QWidget* parent_widget;
+    AnimationClock* clock;
     
     // Animation infrastructure
-    QSequentialAnimationGroup* correct_sequence;
-    QSequentialAnimationGroup* incorrect_sequence;
     QLabel* animation_feedback_label;
-    QTimer* animation_completion_timer;
+    QGraphicsOpacityEffect* feedback_opacity;
+    std::vector<AnimationClock::effect_id> running_effects;
     bool animation_in_progress;
     
     // Animation creation methods
@@ -58,9 +52,12 @@ private:
     void create_incorrect_animation_sequence(int points);
     void create_points_animation(int points);
     void create_shake_animation();
-    void create_overlay_animation(const QString& text, const QString& color, bool fade_in);
+    void show_feedback(const QString& text, const QString& background);
+    // Fades the overlay in and out again, then runs on_finished
+    void create_overlay_animation(std::function<void()> on_finished);
+    QLabel* create_points_label(const QString& text, const QString& color, int top);
+    void fade(QLabel* label, QGraphicsOpacityEffect* opacity, double from, double to, int duration_ms, int delay_ms = 0);
     
     // Helper methods
     void cleanup_leftover_labels();
-    void setup_timeout_protection(bool is_correct);
 };
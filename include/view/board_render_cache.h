@@ -0,0 +1,45 @@
+#pragma once
+#include <QObject>
+#include <QCache>
+#include <QColor>
+#include <QFont>
+#include <QPixmap>
+#include <QStaticText>
+#include <QString>
+
+// Pre-rendered board tiles and laid-out text shared by every window that shows
+// the board. Tiles depend only on their points, state and size, so one render
+// serves every cell in a row on every screen; text layouts are keyed by content
+// and width. Entries are never invalidated, only evicted: a changed cell asks
+// for a different key.
+class BoardRenderCache : public QObject {
+    Q_OBJECT
+
+public:
+    enum class TileState { OPEN, HOVERED, USED };
+    enum class TextRole { CATEGORY, DETAIL };
+
+    static constexpr qint64 TILE_BUDGET_BYTES = 32 * 1024 * 1024;
+    static constexpr int LAYOUT_CAPACITY = 4096;
+    static constexpr int CORNER_RADIUS = 10;
+
+    explicit BoardRenderCache(QObject* parent = nullptr);
+
+    QPixmap tile(int points, TileState state, const QSize& size, qreal device_pixel_ratio);
+    QStaticText text_layout(const QString& text, TextRole role, int width);
+
+    [[nodiscard]] static QFont font_for(TextRole role);
+    [[nodiscard]] static QColor team_color(size_t team_index);
+    [[nodiscard]] int tile_renders() const { return renders; }
+    [[nodiscard]] int tile_requests() const { return requests; }
+    [[nodiscard]] qint64 used_bytes() const { return tiles.totalCost(); }
+    [[nodiscard]] int cached_count() const { return static_cast<int>(tiles.count() + layouts.count()); }
+
+private:
+    QCache<QString, QPixmap> tiles;
+    QCache<QString, QStaticText> layouts;
+    int renders;
+    int requests;
+
+    static QPixmap render_tile(int points, TileState state, const QSize& size, qreal device_pixel_ratio);
+};
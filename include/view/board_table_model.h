@@ -0,0 +1,38 @@
+#pragma once
+#include <QAbstractTableModel>
+#include "controller/game_controller.h"
+
+// Table model over the live board for the config grid. It keeps no copy of the
+// board; every role is read on demand, so only cells a view actually paints
+// cost anything. Each committed change set becomes at most one dataChanged and
+// one headerDataChanged range, with a model reset only when the dimensions change.
+class BoardTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Role {
+        QuestionRole = Qt::UserRole + 1,
+        AnswerRole,
+        MediaPathRole,
+        PointsRole,
+        ContentStateRole
+    };
+
+    explicit BoardTableModel(GameController* controller, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    bool setHeaderData(int section, Qt::Orientation orientation, const QVariant& value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+private slots:
+    void on_board_changes_committed(const board_change_set& changes);
+
+private:
+    GameController* game_controller;
+    // Dimensions the attached views know about; only updated inside a reset
+    int shown_rows;
+    int shown_cols;
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include <QObject>
+#include <QFont>
+#include <QTextDocument>
+#include <QThreadPool>
+#include <memory>
+#include <unordered_map>
+#include "controller/game_controller.h"
+
+// Lays out question and answer documents for every unrevealed clue on worker
+// threads when a game starts, at the font and width of the dialog's ClueTextView,
+// so opening a clue hands over a finished layout instead of building one while
+// the audience watches. A prepared document is only handed out for the text it
+// was built from; anything else is laid out on the spot, as before.
+class ClueDocumentCache : public QObject {
+    Q_OBJECT
+
+public:
+    ClueDocumentCache(GameController* controller, const QFont& font, int text_width, QObject* parent = nullptr);
+    ~ClueDocumentCache();
+
+    // The view reports its real width once laid out; a change prepares everything again
+    void set_text_width(int width);
+    [[nodiscard]] int text_width() const { return document_text_width; }
+
+    std::unique_ptr<QTextDocument> take_question(size_t row, size_t col, const shared_text& text);
+    std::unique_ptr<QTextDocument> take_answer(size_t row, size_t col, const shared_text& text);
+
+    [[nodiscard]] int prepared_count() const { return static_cast<int>(prepared.size()); }
+    [[nodiscard]] int hit_count() const { return hits; }
+    [[nodiscard]] int miss_count() const { return misses; }
+
+private slots:
+    void on_mode_changed(GameMode new_mode);
+    void on_board_changes_committed(const board_change_set& changes);
+
+private:
+    struct prepared_clue {
+        shared_text question_text;
+        shared_text answer_text;
+        std::unique_ptr<QTextDocument> question_document;
+        std::unique_ptr<QTextDocument> answer_document;
+    };
+
+    GameController* game_controller;
+    QFont document_font;
+    int document_text_width;
+    std::unordered_map<quint64, prepared_clue> prepared;
+    std::unordered_map<quint64, quint64> pending_generations;
+    quint64 next_generation;
+    int hits;
+    int misses;
+    QThreadPool layout_pool;
+
+    static quint64 cell_key(size_t row, size_t col);
+    void prepare_unrevealed();
+    std::unique_ptr<QTextDocument> take(size_t row, size_t col, const shared_text& text, bool question);
+    void on_prepared(quint64 key, quint64 generation, std::shared_ptr<prepared_clue> clue);
+};
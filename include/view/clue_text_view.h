@@ -0,0 +1,43 @@
+#pragma once
+#include <QAbstractScrollArea>
+#include <QString>
+#include <QTextDocument>
+#include <memory>
+
+// Read-only clue text painted straight from a QTextDocument. QTextEdit::setDocument()
+// resets the page size, which lays the whole document out again; this view adopts
+// a document already laid out at the viewport width as it is, and only paints it.
+// Styled like a QTextEdit: border and padding come from the style sheet.
+class ClueTextView : public QAbstractScrollArea {
+    Q_OBJECT
+
+private:
+    std::unique_ptr<QTextDocument> current;
+    int relayouts;
+
+    void fit_width();
+    void update_scroll_range();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+
+public:
+    explicit ClueTextView(QWidget* parent = nullptr);
+    ~ClueTextView();
+
+    // Takes over a document; one laid out at text_width() is shown without relayout
+    void set_document(std::unique_ptr<QTextDocument> document);
+
+    [[nodiscard]] int text_width() const;
+    // Documents that had to be laid out again on adoption or resize
+    [[nodiscard]] int relayout_count() const { return relayouts; }
+
+    // Lays a document out the way QTextEdit::setText() would, ready to adopt
+    [[nodiscard]] static std::unique_ptr<QTextDocument> build_document(const QString& text, const QFont& font,
+                                                                       int text_width);
+
+signals:
+    // The width documents should be prepared at; not reported while a scroll bar narrows it
+    void text_width_changed(int width);
+};
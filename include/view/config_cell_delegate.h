@@ -0,0 +1,18 @@
+#pragma once
+#include <QStyledItemDelegate>
+
+// Paints a config grid cell the way the old per-cell edit buttons looked,
+// without a widget behind it: green for complete clues, purple for a question
+// without an answer, dark blue for empty cells.
+class ConfigCellDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+
+public:
+    static constexpr int CELL_WIDTH = 140;
+    static constexpr int CELL_HEIGHT = 80;
+
+    explicit ConfigCellDelegate(QObject* parent = nullptr);
+
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+};
@@ -8,32 +8,39 @@
 #include <QSpinBox>
 #include <QPushButton>
 #include <QTextEdit>
-#include <QScrollArea>
+#include <QTableView>
+#include <QComboBox>
 #include "controller/game_controller.h"
 
+class BoardTableModel;
+class ConfigCellDelegate;
+
 class ConfigWidget : public QWidget {
     Q_OBJECT
 
 private:
+    static constexpr int MAX_ROWS = 100;
+    static constexpr int MAX_COLS = 40;
+
     GameController* game_controller;
     QVBoxLayout* main_layout;
     QHBoxLayout* size_layout;
     QSpinBox* rows_spinbox;
     QSpinBox* cols_spinbox;
+    QSpinBox* answer_time_spinbox;
+    QSpinBox* steal_time_spinbox;
     QPushButton* apply_size_button;
+    QPushButton* clear_board_button;
     
-    QScrollArea* config_scroll_area;
-    QWidget* config_content_widget;
-    QGridLayout* config_grid_layout;
-    
-    std::vector<QLineEdit*> category_inputs;
-    std::vector<std::vector<QPushButton*>> cell_edit_buttons;
+    // Virtualized grid: only visible cells are painted, no widget per cell
+    QTableView* config_table;
+    BoardTableModel* board_model;
+    ConfigCellDelegate* cell_delegate;
     
     void setup_ui();
     void create_size_controls();
-    void rebuild_config_grid();
-    void clear_config_grid();
-    void update_cell_button_style(size_t row, size_t col);
+    QSpinBox* create_timer_spinbox(int seconds);
+    void create_config_table();
 
 public:
     explicit ConfigWidget(GameController* controller, QWidget* parent = nullptr);
@@ -41,9 +48,11 @@ public:
 
 private slots:
     void apply_board_size();
-    void edit_cell(int row, int col);
-    void update_category(int col);
-    void on_board_changed();
+    void clear_board();
+    void apply_turn_timers();
+    void edit_cell(const QModelIndex& index);
+    void edit_category(int col);
+    void on_board_reset();
 };
 
 class CellEditDialog : public QWidget {
@@ -56,6 +65,9 @@ private:
     QLabel* title_label;
     QTextEdit* question_edit;
     QTextEdit* answer_edit;
+    QLineEdit* media_edit;
+    QComboBox* media_type_combo;
+    QPushButton* browse_media_button;
     QPushButton* save_button;
     QPushButton* cancel_button;
 
@@ -69,4 +81,5 @@ signals:
 private slots:
     void save_cell();
     void cancel_edit();
+    void browse_media();
 };
@@ -0,0 +1,52 @@
+#pragma once
+#include <QWidget>
+#include <QTimer>
+#include <chrono>
+
+// Answer countdown drawn as a shrinking bar and whole seconds. Remaining time
+// is always measured against a steady-clock deadline, and the widget only
+// wakes when the next pixel of bar or the next second would change, then
+// repaints just that strip.
+class CountdownWidget : public QWidget {
+    Q_OBJECT
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr int BAR_HEIGHT = 12;
+    static constexpr int TEXT_WIDTH = 56;
+    static constexpr int SPACING = 8;
+    static constexpr int WARNING_SECONDS = 5;
+
+    QTimer wake_timer;
+    clock::time_point deadline;
+    std::chrono::milliseconds total;
+    bool running;
+    int shown_width;
+    int shown_seconds;
+
+    [[nodiscard]] std::chrono::milliseconds remaining() const;
+    [[nodiscard]] QRect bar_rect() const;
+    [[nodiscard]] QRect text_rect() const;
+    [[nodiscard]] int fill_width(std::chrono::milliseconds left) const;
+    [[nodiscard]] static int whole_seconds(std::chrono::milliseconds left);
+    void schedule_next(std::chrono::milliseconds left);
+    void on_wake();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+
+public:
+    explicit CountdownWidget(QWidget* parent = nullptr);
+
+    // Zero or less hides the countdown
+    void start(int seconds);
+    void stop();
+    [[nodiscard]] bool is_running() const { return running; }
+
+    QSize sizeHint() const override;
+
+signals:
+    void expired();
+};
@@ -1,14 +1,14 @@
 #pragma once
 #include <QObject>
-#include <QPropertyAnimation>
 #include <QGraphicsOpacityEffect>
 #include <QDialog>
+#include "view/animation_clock.h"
 
 class DialogTransitionManager : public QObject {
     Q_OBJECT
 
 public:
-    explicit DialogTransitionManager(QDialog* dialog, QObject* parent = nullptr);
+    DialogTransitionManager(QDialog* dialog, AnimationClock* clock, QObject* parent = nullptr);
     ~DialogTransitionManager();
 
     void setup_transition_effects();
@@ -25,6 +25,7 @@ private:
     static constexpr int DIALOG_FADE_DURATION = 500;
     
     QDialog* dialog;
+    AnimationClock* clock;
     QGraphicsOpacityEffect* dialog_opacity_effect;
-    QPropertyAnimation* fade_out_animation;
+    AnimationClock::effect_id fade_out_effect;
 };
@@ -1,36 +1,76 @@
 #pragma once
 #include <QWidget>
-#include <QGridLayout>
-#include <QVBoxLayout>
-#include <QHBoxLayout>
-#include <QLabel>
-#include <QPushButton>
 #include "controller/game_controller.h"
 
+class BoardRenderCache;
+class input_latency;
+
+enum class BoardAudience {
+    AUDIENCE,   // What the room sees: points and used cells
+    PRESENTER   // Adds each cell's answer and the teams that already tried it
+};
+
+// Painted board grid. Tiles and text layouts come from a BoardRenderCache that
+// is shared with every other board on screen, so a change renders each affected
+// tile once and each window only blits it.
 class GameBoardWidget : public QWidget {
     Q_OBJECT
 
 private:
+    static constexpr int MARGIN = 20;
+    static constexpr int SPACING = 5;
+    static constexpr int HEADER_HEIGHT = 60;
+    static constexpr int MIN_CELL_WIDTH = 60;
+    static constexpr int MIN_CELL_HEIGHT = 40;
+    static constexpr int DETAIL_PADDING = 8;
+    static constexpr int ATTEMPT_DOT_SIZE = 8;
+
     GameController* game_controller;
-    QVBoxLayout* main_layout;
-    QGridLayout* board_layout;
+    BoardRenderCache* render_cache;
+    BoardAudience audience;
+    input_latency* latency;
+    // Highlighted cell, moved by the mouse or the arrow keys
+    int hovered_row;
+    int hovered_col;
     
-    std::vector<QLabel*> category_labels;
-    std::vector<std::vector<QPushButton*>> cell_buttons;
-    
-    void setup_ui();
-    void rebuild_board();
-    void clear_board();
-    void update_cell_button(size_t row, size_t col);
+    // Null unless a game is in progress; the editable board is shown instead
+    const play_board* shown_play_board() const;
+    // Columns by rows
+    QSize grid_size() const;
+    QSize cell_size() const;
+    QRect header_rect(size_t col) const;
+    QRect cell_rect(size_t row, size_t col) const;
+    bool cell_at(const QPoint& position, size_t& row, size_t& col) const;
+    void set_hovered(int row, int col);
+    // Returns whether the cell could be selected
+    bool activate(size_t row, size_t col);
+    void paint_header(QPainter& painter, const QRect& rect, const shared_text& category);
+    void paint_config_board(QPainter& painter, const QRect& dirty_rect);
+    void paint_play_board(QPainter& painter, const QRect& dirty_rect, const play_board& board);
+    void paint_presenter_details(QPainter& painter, const play_board& board, size_t row, size_t col, const QRect& rect);
+    void paint_answer(QPainter& painter, const QRect& rect, const shared_text& answer, bool revealed);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void leaveEvent(QEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
 
 public:
-    explicit GameBoardWidget(GameController* controller, QWidget* parent = nullptr);
+    GameBoardWidget(GameController* controller, BoardRenderCache* cache,
+                    BoardAudience audience = BoardAudience::AUDIENCE, QWidget* parent = nullptr);
     ~GameBoardWidget() = default;
+    
+    QSize minimumSizeHint() const override;
+    // Key presses are timed until the paint that shows them
+    void set_input_latency(input_latency* tracker) { latency = tracker; }
 
 private slots:
-    void on_cell_clicked();
     void on_board_changed();
+    void on_attempts_changed(size_t row, size_t col);
 
 signals:
     void cell_selected(size_t row, size_t col);
+    void cell_hovered(size_t row, size_t col);
 };
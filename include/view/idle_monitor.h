@@ -0,0 +1,54 @@
+#pragma once
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class AnimationClock;
+
+struct idle_report {
+    double seconds = 0.0;
+    uint64_t wakeups = 0;
+    int active_timers = 0;
+    size_t active_animations = 0;
+    std::vector<std::pair<std::string, uint64_t>> sources;  // Busiest first
+    std::vector<std::string> timers;                       // Timers still running at the end
+
+    [[nodiscard]] double wakeups_per_second() const { return seconds > 0.0 ? wakeups / seconds : 0.0; }
+    [[nodiscard]] bool is_idle() const { return wakeups == 0 && active_timers == 0 && active_animations == 0; }
+    [[nodiscard]] std::string to_text() const;
+};
+
+// Counts the GUI thread's wakeups over a measurement window: timer events,
+// queued calls from worker threads and repaint requests, grouped by the object
+// that received them. At the end it also lists every running QTimer reachable
+// from a top-level widget and every active animation effect.
+class IdleMonitor : public QObject {
+    Q_OBJECT
+
+public:
+    IdleMonitor(AnimationClock* clock, QObject* parent = nullptr);
+
+    // Reports through finished() once duration_ms has passed
+    void measure(int duration_ms);
+    [[nodiscard]] bool is_measuring() const { return measurement_timer.isActive(); }
+
+signals:
+    void finished(const idle_report& report);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    AnimationClock* clock;
+    QTimer measurement_timer;
+    QElapsedTimer elapsed;
+    uint64_t wakeups;
+    std::map<std::string, uint64_t> sources;
+
+    void finish_measurement();
+    static std::string describe(const QObject* object);
+};
@@ -13,40 +13,91 @@
 #include <QMenu>
 #include <QAction>
 #include "controller/game_controller.h"
+#include "util/memory_report.h"
+#include "util/input_latency.h"
 
 class ConfigWidget;
 class GameBoardWidget;
 class QuestionDialog;
 class TeamWidget;
+class PixmapCache;
+class ClueDocumentCache;
+class AutosaveService;
+class CollaborationSession;
+class ScoreboardServer;
+class ScoreTimelineWidget;
+class MemoryReportWidget;
+class BoardRenderCache;
+class PresenterWindow;
+class AnimationClock;
+class IdleMonitor;
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
 
 private:
+    static constexpr int IDLE_CHECK_MS = 5000;
+
     GameController* game_controller;
     QStackedWidget* stacked_widget;
+    QHBoxLayout* content_layout;
     ConfigWidget* config_widget;
     GameBoardWidget* game_board_widget;
     QuestionDialog* question_dialog;
     TeamWidget* team_widget;
+    PixmapCache* pixmap_cache;
+    ClueDocumentCache* clue_document_cache;
+    AnimationClock* animation_clock;
+    IdleMonitor* idle_monitor;
+    AutosaveService* autosave_service;
+    CollaborationSession* collaboration_session;
+    ScoreboardServer* scoreboard_server;
+    ScoreTimelineWidget* score_timeline_widget;
+    MemoryReportWidget* memory_report_widget;
+    BoardRenderCache* board_render_cache;
+    PresenterWindow* presenter_window;
     
     QLabel* score_label;
     QPushButton* mode_toggle_button;
+    bool first_frame_painted;
+    bool host_mode;
+    input_latency host_latency;
     
     void setup_ui();
     void setup_menu();
     void create_widgets();
     void setup_connections();
+    
+    // Widgets that are not visible in the first frame are built on first use
+    GameBoardWidget* ensure_game_board_widget();
+    QuestionDialog* ensure_question_dialog();
+    TeamWidget* ensure_team_widget();
+    PixmapCache* ensure_pixmap_cache();
+    ScoreTimelineWidget* ensure_score_timeline_widget();
+    MemoryReportWidget* ensure_memory_report_widget();
+    BoardRenderCache* ensure_board_render_cache();
+    PresenterWindow* ensure_presenter_window();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
 
 public:
     explicit MainWindow(QWidget* parent = nullptr);
-    ~MainWindow() = default;
+    ~MainWindow();
+    
+    // Samples the model, caches and every view built so far
+    [[nodiscard]] memory_report collect_memory_report() const;
+    [[nodiscard]] IdleMonitor* get_idle_monitor() const { return idle_monitor; }
+
+signals:
+    void first_frame_shown();
 
 private slots:
     void on_mode_changed(GameMode new_mode);
     void on_score_changed(int new_score);
     void toggle_mode();
     void show_question_dialog(size_t row, size_t col);
+    void prefetch_column_media(size_t row, size_t col);
 };
 
 #endif
\ No newline at end of file
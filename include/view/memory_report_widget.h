@@ -0,0 +1,30 @@
+#pragma once
+#include <QWidget>
+#include <QPlainTextEdit>
+#include <QTimer>
+#include <functional>
+#include "util/memory_report.h"
+
+// Debug window that re-samples a memory_report once a second while it is shown.
+class MemoryReportWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    using sampler = std::function<memory_report()>;
+
+    explicit MemoryReportWidget(sampler sample, QWidget* parent = nullptr);
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private slots:
+    void refresh();
+
+private:
+    static constexpr int REFRESH_INTERVAL_MS = 1000;
+
+    sampler sample;
+    QPlainTextEdit* report_text;
+    QTimer refresh_timer;
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <QObject>
+#include <QCache>
+#include <QImage>
+#include <QPixmap>
+#include <QSet>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+#include "model/play_board.h"
+
+// Byte-bounded LRU cache of scaled clue pictures. Files are decoded (and scaled
+// while decoding) on worker threads; only the QImage -> QPixmap upload happens
+// on the GUI thread, so a request never blocks on disk or codec work.
+class PixmapCache : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr qint64 DEFAULT_BUDGET_BYTES = 128LL * 1024 * 1024;
+    static constexpr int DECODE_THREADS = 2;
+
+    explicit PixmapCache(QObject* parent = nullptr);
+    ~PixmapCache();
+
+    // Returns the cached pixmap, or a null pixmap after queueing a decode
+    QPixmap request(const QString& path, const QSize& target_size);
+    void prefetch(const QString& path, const QSize& target_size);
+    void prefetch_column(const play_board& game_board, size_t col, const QSize& target_size);
+    // Lets paths that failed to decode be tried again, e.g. after the board was edited
+    void clear_failures();
+
+    void set_budget_bytes(qint64 bytes);
+    [[nodiscard]] qint64 budget_bytes() const;
+    [[nodiscard]] qint64 used_bytes() const;
+    [[nodiscard]] int cached_count() const;
+
+signals:
+    void pixmap_ready(const QString& path, const QSize& target_size, const QPixmap& pixmap);
+    void decode_failed(const QString& path);
+
+private:
+    QCache<QString, QPixmap> cache;  // Cost is the pixmap size in bytes
+    QSet<QString> pending_keys;
+    QSet<QString> failed_paths;  // Not retried until clear_failures()
+    QThreadPool decode_pool;
+
+    static QString cache_key(const QString& path, const QSize& target_size);
+    void start_decode(const QString& key, const QString& path, const QSize& target_size);
+    void on_decoded(const QString& key, const QString& path, const QSize& target_size, const QImage& image);
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include <QWidget>
+#include <QLabel>
+#include "controller/game_controller.h"
+
+class BoardRenderCache;
+class GameBoardWidget;
+
+// Host-only window: the board with answers and attempted teams, the top of the
+// standings and the clue currently in play. Shares the audience board's render cache.
+class PresenterWindow : public QWidget {
+    Q_OBJECT
+
+private:
+    static constexpr size_t STANDINGS_SHOWN = 10;
+
+    GameController* game_controller;
+    GameBoardWidget* board_widget;
+    QLabel* current_team_label;
+    QLabel* scores_label;
+    QLabel* question_label;
+    QLabel* answer_label;
+
+    void setup_ui(BoardRenderCache* render_cache);
+    void refresh_scores();
+
+protected:
+    void showEvent(QShowEvent* event) override;
+
+public:
+    PresenterWindow(GameController* controller, BoardRenderCache* render_cache, QWidget* parent = nullptr);
+    ~PresenterWindow() = default;
+
+    GameBoardWidget* get_board_widget() const { return board_widget; }
+
+private slots:
+    void on_cell_selected(size_t row, size_t col);
+};
@@ -4,28 +4,55 @@
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QPushButton>
-#include <QTextEdit>
+#include <QShortcut>
+#include <vector>
 #include "controller/game_controller.h"
 #include "view/animation_manager.h"
 #include "view/dialog_transition_manager.h"
+#include "view/pixmap_cache.h"
+#include "view/countdown_widget.h"
+#include "view/clue_text_view.h"
+
+class input_latency;
+class ClueDocumentCache;
 
 class QuestionDialog : public QDialog {
     Q_OBJECT
 
 private:
+    static constexpr int DIALOG_WIDTH = 600;
+    static constexpr int DIALOG_HEIGHT = 500;
+    static constexpr int DIALOG_HEIGHT_WITH_MEDIA = 780;
+    static constexpr int MEDIA_WIDTH = 540;
+    static constexpr int MEDIA_HEIGHT = 260;
+    static constexpr int CONTENT_MARGIN = 30;
+    static constexpr int CLUE_PADDING = 15;
+    static constexpr int CLUE_BORDER = 3;
+    static constexpr int CLUE_FONT_PIXEL_SIZE = 16;
+
     // Core game data
     GameController* game_controller;
+    PixmapCache* pixmap_cache;
+    ClueDocumentCache* document_cache;
+    AnimationClock* animation_clock;
+    QString current_media_path;
     size_t current_row, current_col;
     bool answer_shown;
     bool point_stealing_mode;  // Track if we're in stealing mode
+    bool host_mode;            // Keyboard shortcuts, no animations or fades
+    input_latency* latency;
+    std::vector<QShortcut*> host_shortcuts;
     
     // UI components
     QVBoxLayout* main_layout;
     QLabel* points_label;
     QLabel* category_label;
-    QTextEdit* question_display;
+    CountdownWidget* countdown;
+    QLabel* media_label;
+    QPushButton* play_media_button;
+    ClueTextView* question_display;
     QPushButton* show_answer_button;
-    QTextEdit* answer_display;
+    ClueTextView* answer_display;
     QHBoxLayout* button_layout;
     QPushButton* correct_button;
     QPushButton* incorrect_button;
@@ -38,8 +65,17 @@ private:
     // UI setup and management
     void setup_ui();
     void setup_managers();
+    void setup_host_shortcuts();
+    // The action returns whether the key did anything
+    void add_host_shortcut(const QKeySequence& key, bool (QuestionDialog::*action)());
+    bool host_reveal();
+    bool host_correct();
+    bool host_incorrect();
+    bool host_close();
+    void finish_question();
     void reset_ui_state();
     void enable_buttons(bool enabled);
+    void load_media(const play_board& board, size_t row, size_t col);
 
     // Helper to reveal the answer without altering button visibility
     void reveal_answer();
@@ -49,17 +85,34 @@ private:
     void execute_incorrect_action();
     void setup_for_next_team();  // Setup for next team in stealing mode
 
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    // Esc and the close button hide the dialog without going through close_dialog()
+    void hideEvent(QHideEvent* event) override;
+
 public:
-    explicit QuestionDialog(GameController* controller, QWidget* parent = nullptr);
+    QuestionDialog(GameController* controller, PixmapCache* pixmap_cache, ClueDocumentCache* document_cache,
+                   AnimationClock* animation_clock, QWidget* parent = nullptr);
     ~QuestionDialog();
     
     void show_question(size_t row, size_t col);
+    void set_host_mode(bool enabled);
+    void set_input_latency(input_latency* tracker) { latency = tracker; }
+    [[nodiscard]] static QSize media_size() { return QSize(MEDIA_WIDTH, MEDIA_HEIGHT); }
+    // Layout of clue documents prepared before the dialog exists; the view reports its real width once shown
+    [[nodiscard]] static QFont clue_font();
+    [[nodiscard]] static int clue_text_width();
 
 private slots:
     void show_answer();
     void mark_correct();
     void mark_incorrect();
     void close_dialog();
+    void play_media();
+    
+    // Asynchronous picture loading
+    void on_pixmap_ready(const QString& path, const QSize& target_size, const QPixmap& pixmap);
+    void on_pixmap_failed(const QString& path);
     
     // Animation completion handlers
     void on_correct_animation_finished();
@@ -67,4 +120,7 @@ private slots:
     
     // Transition completion handler
     void on_transition_finished();
+    
+    // Running out of time counts as an incorrect answer
+    void on_countdown_expired();
 };
@@ -0,0 +1,50 @@
+#pragma once
+#include <QWidget>
+#include <QPixmap>
+#include <QPointF>
+#include <QColor>
+#include <vector>
+#include "controller/game_controller.h"
+
+class QPainter;
+
+// Step chart of every team's score over the game. The series are kept painted
+// on a backing pixmap; a new score event paints one segment and repaints only
+// its bounding rectangle. The pixmap is rebuilt from the teams' history rings
+// only on resize, a new game, or when an axis has to double its range.
+class ScoreTimelineWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit ScoreTimelineWidget(GameController* controller, QWidget* parent = nullptr);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+
+private slots:
+    void on_score_event_recorded(size_t team_index, const score_event& event);
+    // A new game and a reset both clear every score
+    void on_scores_reset();
+
+private:
+    static constexpr int MARGIN = 40;
+    static constexpr int LEGEND_ENTRIES = 12;
+    static constexpr int64_t INITIAL_TIME_SPAN_MS = 5 * 60 * 1000;
+    static constexpr int INITIAL_SCORE_SPAN = 1000;
+
+    GameController* game_controller;
+    QPixmap canvas;
+    int64_t time_span_ms;
+    int score_min;
+    int score_max;
+    std::vector<QPointF> last_points;  // Per team, in (milliseconds, score)
+
+    void reset_ranges();
+    bool fits(int64_t time_ms, int score) const;
+    void grow_to_fit(int64_t time_ms, int score);
+    void rebuild_canvas();
+    void draw_axes(QPainter& painter) const;
+    QRectF draw_step(QPainter& painter, size_t team_index, const QPointF& from, const QPointF& to) const;
+    QPointF to_pixel(const QPointF& point) const;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <QAbstractListModel>
+#include "controller/game_controller.h"
+
+// One row per team in turn order, read from the controller on demand. Score
+// and rename events touch only their own row, and every dataChanged names the
+// roles it affects, so a sorting proxy re-sorts only when its sort key moved.
+class TeamListModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    enum Role {
+        ScoreRole = Qt::UserRole + 1,
+        WinProbabilityRole,
+        CurrentRole,
+        TeamIndexRole
+    };
+
+    explicit TeamListModel(GameController* controller, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+    void reset();
+
+private slots:
+    void on_score_event_recorded(size_t team_index, const score_event& event);
+    void on_team_changed(const team& current_team);
+    void on_team_added(size_t team_index);
+    void on_team_renamed(size_t team_index);
+    void on_win_probabilities_changed(const std::vector<double>& probabilities);
+
+private:
+    GameController* game_controller;
+    // Row count the attached views know about; only updated inside a reset or insert
+    int shown_rows;
+    int current_row;
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include <QStyledItemDelegate>
+#include <unordered_map>
+
+// Paints one leaderboard row: rank, name, score and win chance, with the team
+// whose turn it is highlighted. Rows that changed rank are drawn shifted back
+// toward where they were and slide into place as the motion progresses.
+class TeamRowDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+
+public:
+    static constexpr int ROW_HEIGHT = 40;
+
+    explicit TeamRowDelegate(QObject* parent = nullptr);
+
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+    // rows_moved is the old visual row minus the new one, keyed by team index
+    void add_motion(size_t team_index, int rows_moved);
+    void clear_motions();
+    void set_motion_progress(double progress) { motion_progress = progress; }
+    [[nodiscard]] bool has_motions() const { return !motions.empty(); }
+
+private:
+    std::unordered_map<size_t, int> motions;
+    double motion_progress;
+};
@@ -1,77 +1,61 @@
 #pragma once
 
 #include <QWidget>
-#include <QVBoxLayout>
-#include <QHBoxLayout>
+#include <QComboBox>
 #include <QLabel>
+#include <QListView>
 #include <QPushButton>
-#include <QLineEdit>
-#include <QFrame>
-#include <QString>
-#include <QEvent>
-#include <QKeyEvent>
-#include <vector>
-#include "model/team.h"
+#include <QSortFilterProxyModel>
+#include <unordered_map>
+#include "view/animation_clock.h"
 
 class GameController;
-
-class TeamDisplayWidget : public QFrame {
+class TeamListModel;
+class TeamRowDelegate;
+struct team;
+
+// Leaderboard for any number of teams. The list is virtualized, so only
+// visible rows are painted, and a proxy keeps it sorted by turn order, score
+// or name. When a score changes rank, the changed row and the rows it passed
+// slide to their new places. The team whose turn it is stays pinned above the
+// list. Double-click a name to rename it.
+class TeamWidget : public QWidget {
     Q_OBJECT
 
 private:
-    const team* team_data;
-    QLabel* name_label;
-    QLabel* score_label;
-    QLineEdit* name_edit;
-    bool is_current_team;
-    bool is_editing_name;
-
-    void setup_ui();
-    void update_display();
-    void start_name_editing();
-    void finish_name_editing();
+    static constexpr int RANK_MOTION_MS = 300;
 
-protected:
-    bool eventFilter(QObject* obj, QEvent* event) override;
-    void keyPressEvent(QKeyEvent* event) override;
+    enum class SortMode { TURN_ORDER, SCORE, NAME };
 
-public:
-    explicit TeamDisplayWidget(const team* team_ptr, QWidget* parent = nullptr);
-    void set_team_data(const team* team_ptr);
-    void set_current_team(bool is_current);
-    void update_team_info();
-
-signals:
-    void name_change_requested(const team* team_ptr, const QString& new_name);
-
-private slots:
-    void on_name_clicked();
-    void on_name_edit_finished();
-    void on_name_edit_escape();
-};
-
-class TeamWidget : public QWidget {
-    Q_OBJECT
-
-private:
     GameController* game_controller;
-    QVBoxLayout* main_layout;
+    AnimationClock* clock;
+    TeamListModel* team_model;
+    QSortFilterProxyModel* sorted_model;
+    TeamRowDelegate* row_delegate;
     QLabel* title_label;
-    std::vector<TeamDisplayWidget*> team_displays;
+    QLabel* current_team_label;
+    QComboBox* sort_combo;
+    QListView* team_list;
+    QPushButton* add_team_button;
+    
+    // Visual rows of teams whose sort key just changed, captured before the proxy re-sorts
+    std::unordered_map<size_t, int> rows_before_sort;
+    AnimationClock::effect_id rank_motion;
+    int motion_top_row;
+    int motion_bottom_row;
 
     void setup_ui();
-    void clear_team_displays();
-    void create_team_displays();
+    void apply_sort_mode();
+    void start_rank_motion();
+    void update_motion_rows();
+    void refresh_current_team();
 
 public:
-    explicit TeamWidget(GameController* controller, QWidget* parent = nullptr);
+    TeamWidget(GameController* controller, AnimationClock* clock, QWidget* parent = nullptr);
     void update_teams();
-    void set_current_team(const team& current_team);
-
-public slots:
-    void on_teams_updated();
-    void on_current_team_changed(const team& current_team);
 
 private slots:
-    void on_team_name_change_requested(const team* team_ptr, const QString& new_name);
+    void on_source_data_changed(const QModelIndex& top_left, const QModelIndex& bottom_right, const QList<int>& roles);
+    void on_layout_changed();
+    void add_team();
 };
@@ -0,0 +1,168 @@
+#include "controller/autosave_service.h"
+#include "storage/board_file.h"
+#include "util/trace.h"
+#include "util/log.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QStandardPaths>
+#include <algorithm>
+
+AutosaveService::AutosaveService(GameController* controller, const QString& path, QObject* parent)
+    : QObject(parent), game_controller(controller), path(path), autosave_timer(nullptr),
+      restoring(false), write_in_progress(false), save_pending(false), last_snapshot_ns(0),
+      delta_records(0), full_save_required(true) {
+    write_pool.setMaxThreadCount(1);
+    
+    // Single-shot so an idle board causes no wakeups; the first edit after a save arms it
+    autosave_timer = new QTimer(this);
+    autosave_timer->setSingleShot(true);
+    autosave_timer->setInterval(AUTOSAVE_DELAY_MS);
+    
+    connect(autosave_timer, &QTimer::timeout, this, &AutosaveService::save_now);
+    connect(game_controller, &GameController::board_changed, this, &AutosaveService::on_board_changed);
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &AutosaveService::flush);
+}
+
+AutosaveService::~AutosaveService() {
+    write_pool.waitForDone();
+}
+
+void AutosaveService::flush() {
+    write_pool.waitForDone();
+    // Don't lose edits made in the last few seconds before quitting
+    if (autosave_timer->isActive() || save_pending) {
+        autosave_timer->stop();
+        save_pending = false;
+        bool full = false;
+        if (std::optional<board> snapshot = take_snapshot(full)) {
+            QString error;
+            bool ok = write_snapshot(path, *snapshot, full, &error);
+            on_write_finished(ok, full, board_file::delta_record_count(*snapshot), error);
+        }
+    }
+}
+
+QString AutosaveService::default_path() {
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).filePath("autosave.jpdy");
+}
+
+const QString& AutosaveService::get_path() const {
+    return path;
+}
+
+qint64 AutosaveService::get_last_snapshot_ns() const {
+    return last_snapshot_ns;
+}
+
+size_t AutosaveService::get_delta_records() const {
+    return delta_records;
+}
+
+bool AutosaveService::restore() {
+    TRACE_SCOPE("AutosaveService::restore");
+    if (!QFileInfo::exists(path)) {
+        return false;
+    }
+    
+    QString error;
+    std::optional<board> saved_board = board_file::read(path, &error);
+    if (!saved_board) {
+        LOG_WARNING(LogCategory::STORAGE, "Could not restore {}: {}", path.toStdString(), error.toStdString());
+        emit save_failed(QString("Could not restore %1: %2").arg(path, error));
+        return false;
+    }
+    
+    restoring = true;
+    bool loaded = game_controller->load_board(*saved_board);
+    restoring = false;
+    if (loaded) {
+        // The file already holds this board; the first save compacts whatever deltas it carries
+        game_controller->mark_board_saved();
+        full_save_required = true;
+    }
+    return loaded;
+}
+
+void AutosaveService::on_board_changed() {
+    if (restoring || game_controller->get_current_mode() != GameMode::CONFIG) {
+        return;
+    }
+    if (!autosave_timer->isActive()) {
+        autosave_timer->start();
+    }
+}
+
+void AutosaveService::save_now() {
+    TRACE_SCOPE("AutosaveService::save_now");
+    autosave_timer->stop();
+    if (write_in_progress) {
+        save_pending = true;
+        return;
+    }
+    
+    QElapsedTimer snapshot_timer;
+    snapshot_timer.start();
+    bool full = false;
+    std::optional<board> taken = take_snapshot(full);
+    last_snapshot_ns = snapshot_timer.nsecsElapsed();
+    if (!taken) return;
+    
+    write_in_progress = true;
+    QString target = path;
+    board snapshot = std::move(*taken);
+    size_t records = board_file::delta_record_count(snapshot);
+    write_pool.start([this, snapshot, target, full, records]() {
+        QString error;
+        bool ok = write_snapshot(target, snapshot, full, &error);
+        QMetaObject::invokeMethod(this, [this, ok, full, records, error]() {
+            on_write_finished(ok, full, records, error);
+        }, Qt::QueuedConnection);
+    });
+}
+
+std::optional<board> AutosaveService::take_snapshot(bool& full) {
+    const board& live = *game_controller->get_board();
+    if (!live.has_unsaved_changes() && !full_save_required) {
+        return std::nullopt;
+    }
+    board snapshot = live;
+    game_controller->mark_board_saved();
+    
+    size_t cells = snapshot.get_rows() * snapshot.get_cols();
+    size_t compaction_threshold = std::max(MIN_COMPACTION_RECORDS, cells);
+    full = full_save_required || snapshot.needs_full_save() ||
+           delta_records + board_file::delta_record_count(snapshot) > compaction_threshold;
+    // Until the write is confirmed the next save must not assume these edits are on disk
+    full_save_required = true;
+    return snapshot;
+}
+
+bool AutosaveService::write_snapshot(const QString& target, const board& snapshot, bool full, QString* error) {
+    QDir().mkpath(QFileInfo(target).absolutePath());
+    if (full || !QFileInfo::exists(target)) {
+        return board_file::write(target, snapshot, error);
+    }
+    return board_file::append_delta(target, snapshot, error);
+}
+
+void AutosaveService::on_write_finished(bool ok, bool full, size_t records, const QString& error) {
+    write_in_progress = false;
+    if (ok) {
+        full_save_required = false;
+        delta_records = full ? 0 : delta_records + records;
+        emit saved(path);
+    } else {
+        // The edits in the failed snapshot are no longer tracked, so rewrite everything next time
+        full_save_required = true;
+        LOG_WARNING(LogCategory::STORAGE, "Autosave to {} failed: {}", path.toStdString(), error.toStdString());
+        emit save_failed(error);
+    }
+    
+    if (save_pending) {
+        save_pending = false;
+        save_now();
+    }
+}
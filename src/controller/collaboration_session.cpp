@@ -0,0 +1,340 @@
+#include "controller/collaboration_session.h"
+#include "util/trace.h"
+#include "util/log.h"
+#include <QDataStream>
+#include <QIODevice>
+#include <QRandomGenerator>
+#include <QtEndian>
+#include <algorithm>
+#include <utility>
+
+CollaborationSession::CollaborationSession(GameController* controller, QObject* parent)
+    : QObject(parent), game_controller(controller), server(this), applying_remote(false), last_apply_ns(0) {
+    connect(game_controller, &GameController::board_changes_committed, this,
+            &CollaborationSession::on_board_changes_committed);
+    connect(game_controller, &GameController::mode_changed, this, &CollaborationSession::on_mode_changed);
+    connect(&server, &QTcpServer::newConnection, this, &CollaborationSession::on_new_connection);
+}
+
+bool CollaborationSession::host(quint16 port, const QHostAddress& address, QString* error) {
+    leave();
+    if (!server.listen(address, port)) {
+        if (error) *error = server.errorString();
+        return false;
+    }
+    replica = std::make_unique<board_replica>(QRandomGenerator::global()->generate());
+    seed_from_board();
+    emit peers_changed(0);
+    return true;
+}
+
+void CollaborationSession::join(const QString& host_name, quint16 port) {
+    leave();
+    // Starts empty: the host's state arrives first and replaces the local board
+    replica = std::make_unique<board_replica>(QRandomGenerator::global()->generate());
+    
+    QTcpSocket* socket = new QTcpSocket(this);
+    add_peer(socket);
+    connect(socket, &QTcpSocket::errorOccurred, this, [this, socket](QAbstractSocket::SocketError) {
+        emit session_error(socket->errorString());
+        if (socket->state() == QAbstractSocket::UnconnectedState && peers.removeOne(socket)) {
+            socket->deleteLater();
+            emit peers_changed(peer_count());
+        }
+    });
+    socket->connectToHost(host_name, port);
+}
+
+void CollaborationSession::leave() {
+    bool was_active = is_active();
+    server.close();
+    for (QTcpSocket* socket : std::as_const(peers)) {
+        socket->disconnect(this);
+        socket->abort();
+        socket->deleteLater();
+    }
+    peers.clear();
+    replica.reset();
+    if (was_active) {
+        emit peers_changed(0);
+    }
+}
+
+void CollaborationSession::seed_from_board() {
+    const board* game_board = game_controller->get_board();
+    if (!game_board) return;
+    
+    TRACE_SCOPE("CollaborationSession::seed_from_board");
+    std::vector<board_operation> ignored;
+    replica->set_dimensions(game_board->get_rows(), game_board->get_cols());
+    for (size_t col = 0; col < game_board->get_cols(); ++col) {
+        capture_category(*game_board, col, ignored);
+    }
+    for (size_t row = 0; row < game_board->get_rows(); ++row) {
+        for (size_t col = 0; col < game_board->get_cols(); ++col) {
+            capture_cell(*game_board, row, col, ignored);
+        }
+    }
+}
+
+void CollaborationSession::capture_category(const board& game_board, size_t col, std::vector<board_operation>& out) {
+    const shared_text& name = game_board.get_category_text(col);
+    const board_operation* current = replica->find_category(col);
+    if (current && current->text == name) return;
+    out.push_back(replica->set_category(col, name));
+}
+
+void CollaborationSession::capture_cell(const board& game_board, size_t row, size_t col, std::vector<board_operation>& out) {
+    const cell& game_cell = game_board.get_cell(row, col);
+    const board_operation* current = replica->find_cell(row, col);
+    if (current && game_cell.has_content(current->text, current->answer, current->media_path, current->media_type)) return;
+    
+    out.push_back(replica->set_cell(row, col, game_cell.get_question_text(), game_cell.get_answer_text(),
+                                    game_cell.get_media_path_text(), game_cell.get_media_type()));
+}
+
+void CollaborationSession::on_board_changes_committed(const board_change_set& changes) {
+    if (applying_remote || !replica || game_controller->get_current_mode() != GameMode::CONFIG) return;
+    const board* game_board = game_controller->get_board();
+    if (!game_board) return;
+    
+    TRACE_SCOPE("CollaborationSession::on_board_changes_committed");
+    std::vector<board_operation> operations;
+    if (changes.reset) {
+        const auto& dimensions = replica->get_dimensions();
+        if (!dimensions || dimensions->row != game_board->get_rows() || dimensions->col != game_board->get_cols()) {
+            operations.push_back(replica->set_dimensions(game_board->get_rows(), game_board->get_cols()));
+        }
+        for (size_t col = 0; col < game_board->get_cols(); ++col) {
+            capture_category(*game_board, col, operations);
+        }
+        for (size_t row = 0; row < game_board->get_rows(); ++row) {
+            for (size_t col = 0; col < game_board->get_cols(); ++col) {
+                capture_cell(*game_board, row, col, operations);
+            }
+        }
+    } else {
+        for (size_t col : changes.categories) {
+            capture_category(*game_board, col, operations);
+        }
+        for (const auto& [row, col] : changes.cells) {
+            capture_cell(*game_board, row, col, operations);
+        }
+    }
+    send(operations);
+}
+
+void CollaborationSession::on_mode_changed(GameMode mode) {
+    // Edits are refused while a game runs; catch up on what arrived meanwhile
+    if (mode == GameMode::CONFIG && replica) {
+        applying_remote = true;
+        {
+            board_batch batch(game_controller);
+            apply_all();
+        }
+        applying_remote = false;
+    }
+}
+
+std::vector<board_operation> CollaborationSession::receive(const std::vector<board_operation>& operations) {
+    std::vector<board_operation> winners;
+    if (!replica) return winners;
+    
+    TRACE_SCOPE("CollaborationSession::receive");
+    qint64 started = tracer::now_ns();
+    bool resized = false;
+    for (const board_operation& operation : operations) {
+        if (replica->merge(operation)) {
+            resized = resized || operation.kind == board_operation_kind::DIMENSIONS;
+            winners.push_back(operation);
+        }
+    }
+    
+    if (!winners.empty()) {
+        applying_remote = true;
+        {
+            board_batch batch(game_controller);
+            if (resized) {
+                apply_all();
+            } else {
+                for (const board_operation& operation : winners) {
+                    apply(operation);
+                }
+            }
+        }
+        applying_remote = false;
+    }
+    last_apply_ns = tracer::now_ns() - started;
+    return winners;
+}
+
+void CollaborationSession::apply(const board_operation& operation) {
+    const board* game_board = game_controller->get_board();
+    // Registers outside the current size, and ones the board already shows, are left alone
+    switch (operation.kind) {
+        case board_operation_kind::DIMENSIONS:
+            if (operation.row != game_board->get_rows() || operation.col != game_board->get_cols()) {
+                game_controller->configure_board_size(operation.row, operation.col);
+            }
+            break;
+        case board_operation_kind::CATEGORY:
+            if (operation.col < game_board->get_cols() && game_board->get_category_text(operation.col) != operation.text) {
+                game_controller->set_category_name(operation.col, operation.text);
+            }
+            break;
+        case board_operation_kind::CELL:
+            if (game_board->is_valid_position(operation.row, operation.col) &&
+                !game_board->get_cell(operation.row, operation.col)
+                     .has_content(operation.text, operation.answer, operation.media_path, operation.media_type)) {
+                game_controller->set_question_answer(operation.row, operation.col, operation.text, operation.answer);
+                game_controller->set_question_media(operation.row, operation.col, operation.media_path, operation.media_type);
+            }
+            break;
+    }
+}
+
+void CollaborationSession::apply_all() {
+    TRACE_SCOPE("CollaborationSession::apply_all");
+    // state() lists the dimensions first, so every cell lands inside the resized board
+    for (const board_operation& operation : replica->state()) {
+        apply(operation);
+    }
+}
+
+void CollaborationSession::on_new_connection() {
+    while (QTcpSocket* socket = server.nextPendingConnection()) {
+        add_peer(socket);
+        socket->write(encode(replica->state()));
+    }
+}
+
+void CollaborationSession::add_peer(QTcpSocket* socket) {
+    socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    peers.append(socket);
+    connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { read_frames(socket); });
+    connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+        peers.removeOne(socket);
+        socket->deleteLater();
+        emit peers_changed(peer_count());
+    });
+    emit peers_changed(peer_count());
+}
+
+void CollaborationSession::read_frames(QTcpSocket* socket) {
+    while (socket->bytesAvailable() >= static_cast<qint64>(sizeof(quint32))) {
+        quint32 length = 0;
+        socket->peek(reinterpret_cast<char*>(&length), sizeof(length));
+        length = qFromBigEndian(length);
+        if (length > MAX_FRAME_BYTES) {
+            LOG_WARNING(LogCategory::NETWORK, "Dropped peer {}: {}-byte frame", socket->peerAddress().toString().toStdString(), length);
+            emit session_error(QString("Dropped a peer that sent a %1-byte frame").arg(length));
+            socket->abort();
+            return;
+        }
+        if (socket->bytesAvailable() < static_cast<qint64>(sizeof(length) + length)) return;
+        
+        socket->skip(sizeof(length));
+        std::optional<std::vector<board_operation>> operations = decode(socket->read(length));
+        if (!operations) {
+            LOG_WARNING(LogCategory::NETWORK, "Dropped peer {}: unknown protocol version", socket->peerAddress().toString().toStdString());
+            emit session_error("Dropped a peer speaking a different protocol version");
+            socket->abort();
+            return;
+        }
+        std::vector<board_operation> winners = receive(*operations);
+        if (is_host() && !winners.empty()) {
+            send(winners, socket);
+        }
+    }
+}
+
+void CollaborationSession::send(const std::vector<board_operation>& operations, QTcpSocket* except) {
+    if (operations.empty() || peers.isEmpty()) return;
+    
+    QByteArray frame = encode(operations);
+    for (QTcpSocket* socket : std::as_const(peers)) {
+        if (socket != except) {
+            socket->write(frame);
+        }
+    }
+}
+
+QByteArray CollaborationSession::encode(const std::vector<board_operation>& operations) {
+    QByteArray frame;
+    QDataStream out(&frame, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << quint32(0) << PROTOCOL_VERSION << static_cast<quint32>(operations.size());
+    for (const board_operation& operation : operations) {
+        out << static_cast<quint8>(operation.kind)
+            << static_cast<quint64>(operation.stamp.counter) << static_cast<quint32>(operation.stamp.replica)
+            << static_cast<quint32>(operation.row) << static_cast<quint32>(operation.col);
+        switch (operation.kind) {
+            case board_operation_kind::DIMENSIONS:
+                break;
+            case board_operation_kind::CATEGORY:
+                out << operation.text.qstr();
+                break;
+            case board_operation_kind::CELL:
+                out << operation.text.qstr() << operation.answer.qstr() << operation.media_path.qstr()
+                    << static_cast<quint8>(operation.media_type);
+                break;
+        }
+    }
+    qToBigEndian(static_cast<quint32>(frame.size() - sizeof(quint32)), frame.data());
+    return frame;
+}
+
+std::optional<std::vector<board_operation>> CollaborationSession::decode(const QByteArray& payload) {
+    QDataStream in(payload);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint8 version = 0;
+    quint32 count = 0;
+    in >> version >> count;
+    if (version != PROTOCOL_VERSION || in.status() != QDataStream::Ok) {
+        return std::nullopt;
+    }
+    
+    std::vector<board_operation> operations;
+    operations.reserve(std::min<quint32>(count, static_cast<quint32>(payload.size())));
+    for (quint32 i = 0; i < count; ++i) {
+        quint8 kind = 0;
+        quint64 counter = 0;
+        quint32 replica_id = 0;
+        board_operation operation;
+        in >> kind >> counter >> replica_id >> operation.row >> operation.col;
+        if (kind > static_cast<quint8>(board_operation_kind::CELL) || counter > crdt_stamp::MAX_COUNTER) {
+            return std::nullopt;
+        }
+        operation.kind = static_cast<board_operation_kind>(kind);
+        operation.stamp = {counter, replica_id};
+        // A peer may not grow the board past what the editor allows, nor write outside it
+        if (operation.kind == board_operation_kind::DIMENSIONS) {
+            if (operation.row == 0 || operation.row > board::MAX_ROWS || operation.col == 0 ||
+                operation.col > board::MAX_COLS) {
+                return std::nullopt;
+            }
+        } else if (operation.col >= board::MAX_COLS ||
+                   (operation.kind == board_operation_kind::CELL && operation.row >= board::MAX_ROWS)) {
+            return std::nullopt;
+        }
+        if (operation.kind == board_operation_kind::CATEGORY) {
+            QString name;
+            in >> name;
+            operation.text = name;
+        } else if (operation.kind == board_operation_kind::CELL) {
+            QString question, answer, media_path;
+            quint8 media_type = 0;
+            in >> question >> answer >> media_path >> media_type;
+            operation.text = question;
+            operation.answer = answer;
+            operation.media_path = media_path;
+            operation.media_type = media_type <= static_cast<quint8>(MediaType::VIDEO) ? static_cast<MediaType>(media_type)
+                                                                                     : MediaType::NONE;
+        }
+        if (in.status() != QDataStream::Ok) {
+            return std::nullopt;
+        }
+        operations.push_back(std::move(operation));
+    }
+    return operations;
+}
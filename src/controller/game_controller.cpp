@@ -1,20 +1,36 @@
 #include "controller/game_controller.h"
+#include "util/trace.h"
 
 GameController::GameController(QObject* parent)
-    : QObject(parent) {
+    : QObject(parent), batch_depth(0), snapshots(std::make_shared<snapshot_publisher>()) {
     game_state = std::make_unique<GameState>();
+    snapshots->load_board(*game_state->get_board());
+    snapshots->load_teams(game_state->get_teams());
+    snapshots->publish();
+}
+
+GameController::~GameController() {
+    // Stop the estimator before the QObject is torn down; its callback posts to this object
+    win_engine.reset();
 }
 
 void GameController::start_config_mode() {
     game_state->start_config_mode();
+    snapshots->set_mode(GameMode::CONFIG);
+    snapshots->clear_revealed();
+    snapshots->publish();
     emit mode_changed(game_state->get_current_mode());
 }
 
 void GameController::start_game_mode() {
+    TRACE_SCOPE("GameController::start_game_mode");
     game_state->start_game_mode();
+    publish_scores_reset();
     emit mode_changed(game_state->get_current_mode());
+    emit scores_reset();
     emit score_changed(game_state->get_current_team_score());
     emit team_changed(game_state->get_current_team());
+    refresh_win_probabilities();
 }
 
 GameMode GameController::get_current_mode() const {
@@ -22,21 +38,119 @@ GameMode GameController::get_current_mode() const {
 }
 
 void GameController::configure_board_size(size_t rows, size_t cols) {
+    TRACE_SCOPE("GameController::configure_board_size");
     game_state->configure_board_size(rows, cols);
-    emit board_changed();
+    note_reset();
 }
 
-void GameController::set_category_name(size_t col, const std::string& name) {
+void GameController::set_category_name(size_t col, const shared_text& name) {
+    TRACE_SCOPE("GameController::set_category_name");
     game_state->set_category_name(col, name);
-    emit board_changed();
+    note_category(col);
 }
 
-void GameController::set_question_answer(size_t row, size_t col, const std::string& question, const std::string& answer) {
+void GameController::set_question_answer(size_t row, size_t col, const shared_text& question, const shared_text& answer) {
+    TRACE_SCOPE("GameController::set_question_answer");
     game_state->set_question_answer(row, col, question, answer);
+    note_cell(row, col);
+}
+
+void GameController::set_question_media(size_t row, size_t col, const shared_text& path, MediaType type) {
+    TRACE_SCOPE("GameController::set_question_media");
+    game_state->set_question_media(row, col, path, type);
+    note_cell(row, col);
+}
+
+bool GameController::load_board(const board& loaded_board) {
+    TRACE_SCOPE("GameController::load_board");
+    if (!game_state->load_board(loaded_board)) {
+        return false;
+    }
+    note_reset();
+    return true;
+}
+
+void GameController::mark_board_saved() {
+    game_state->mark_board_saved();
+}
+
+void GameController::clear_board() {
+    TRACE_SCOPE("GameController::clear_board");
+    board_batch batch(this);
+    const board* board = game_state->get_board();
+    for (size_t col = 0; col < board->get_cols(); ++col) {
+        set_category_name(col, "");
+        for (size_t row = 0; row < board->get_rows(); ++row) {
+            set_question_answer(row, col, "", "");
+            set_question_media(row, col, "", MediaType::NONE);
+        }
+    }
+}
+
+void GameController::begin_batch() {
+    ++batch_depth;
+}
+
+void GameController::end_batch() {
+    if (batch_depth > 0) {
+        --batch_depth;
+        commit_changes(true);
+    }
+}
+
+bool GameController::in_batch() const {
+    return batch_depth > 0;
+}
+
+void GameController::note_reset() {
+    pending_changes.reset = true;
+    commit_changes();
+}
+
+void GameController::note_category(size_t col) {
+    pending_changes.categories.insert(col);
+    commit_changes();
+}
+
+void GameController::note_cell(size_t row, size_t col) {
+    pending_changes.cells.insert({row, col});
+    commit_changes();
+}
+
+void GameController::commit_changes(bool closing_batch) {
+    if (batch_depth > 0 || pending_changes.empty()) return;
+    
+    TRACE_SCOPE("GameController::commit_changes");
+    board_change_set changes = std::move(pending_changes);
+    pending_changes = board_change_set();
+    
+    const board* game_board = game_state->get_board();
+    if (changes.reset) {
+        snapshots->load_board(*game_board);
+    } else {
+        for (size_t col : changes.categories) {
+            snapshots->set_category(col, game_board->get_category_text(col));
+        }
+        for (const auto& [row, col] : changes.cells) {
+            snapshots->set_cell(row, col, game_board->get_cell(row, col));
+        }
+    }
+    snapshots->publish();
+    
+    if (changes.reset) {
+        emit board_reset();
+    } else if (!closing_batch) {
+        // A batch may touch thousands of cells; its listeners read the change set instead
+        for (const auto& [row, col] : changes.cells) {
+            emit cell_content_changed(row, col);
+        }
+    }
+    emit board_changes_committed(changes);
     emit board_changed();
 }
 
 bool GameController::select_cell(size_t row, size_t col) {
+    TRACE_SCOPE("GameController::select_cell");
     if (game_state->select_cell(row, col)) {
         emit cell_selected(row, col);
         return true;
@@ -46,11 +160,29 @@ bool GameController::select_cell(size_t row, size_t col) {
 
 void GameController::add_to_score(int points) {
     game_state->add_to_current_team_score(points);
+    publish_team(game_state->get_current_team_index());
+    emit score_event_recorded(game_state->get_current_team_index(), game_state->get_current_team().get_history().back());
     emit score_changed(game_state->get_current_team_score());
 }
 
 void GameController::subtract_from_score(int points) {
     game_state->subtract_from_current_team_score(points);
+    publish_team(game_state->get_current_team_index());
+    emit score_event_recorded(game_state->get_current_team_index(), game_state->get_current_team().get_history().back());
+    emit score_changed(game_state->get_current_team_score());
+}
+
+void GameController::add_to_score(int points, size_t row, size_t col) {
+    game_state->add_to_current_team_score(points, row, col);
+    publish_team(game_state->get_current_team_index());
+    emit score_event_recorded(game_state->get_current_team_index(), game_state->get_current_team().get_history().back());
+    emit score_changed(game_state->get_current_team_score());
+}
+
+void GameController::subtract_from_score(int points, size_t row, size_t col) {
+    game_state->subtract_from_current_team_score(points, row, col);
+    publish_team(game_state->get_current_team_index());
+    emit score_event_recorded(game_state->get_current_team_index(), game_state->get_current_team().get_history().back());
     emit score_changed(game_state->get_current_team_score());
 }
 
@@ -59,16 +191,24 @@ int GameController::get_current_team_score() const {
 }
 
 void GameController::reset_game() {
+    TRACE_SCOPE("GameController::reset_game");
     game_state->reset_game();
+    publish_scores_reset();
+    emit scores_reset();
     emit score_changed(game_state->get_current_team_score());
     emit board_changed();
     emit team_changed(game_state->get_current_team());
+    refresh_win_probabilities();
 }
 
 const board* GameController::get_board() const {
     return game_state->get_board();
 }
 
+const play_board* GameController::get_play_board() const {
+    return game_state->get_play_board();
+}
+
 const std::vector<team>& GameController::get_teams() const {
     return game_state->get_teams();
 }
@@ -77,20 +217,55 @@ const team& GameController::get_current_team() const {
     return game_state->get_current_team();
 }
 
-bool GameController::add_team(const std::string& team_name) {
-    return game_state->add_team(team_name);
+bool GameController::add_team(const shared_text& team_name) {
+    if (!game_state->add_team(team_name)) {
+        return false;
+    }
+    publish_team(game_state->get_teams().size() - 1);
+    emit team_added(game_state->get_teams().size() - 1);
+    refresh_win_probabilities();
+    return true;
 }
 
 void GameController::switch_to_next_team() {
     game_state->switch_to_next_team();
+    snapshots->set_current_team(game_state->get_current_team_index());
+    snapshots->publish();
     emit team_changed(game_state->get_current_team());
 }
 
-void GameController::set_team_name(size_t team_index, const std::string& new_name) {
+void GameController::set_team_name(size_t team_index, const shared_text& new_name) {
     game_state->set_team_name(team_index, new_name);
+    publish_team(team_index);
+    emit team_renamed(team_index);
     emit team_changed(game_state->get_current_team());
 }
 
+size_t GameController::get_team_rank(size_t team_index) const {
+    const rank_index& ranks = game_state->get_team_ranks();
+    return team_index < ranks.size() ? ranks.rank_of(team_index) : 0;
+}
+
+std::vector<size_t> GameController::get_top_teams(size_t count) const {
+    return game_state->get_team_ranks().top(count);
+}
+
+std::vector<size_t> GameController::get_teams_in_rank_range(size_t first, size_t count) const {
+    return game_state->get_team_ranks().range(first, count);
+}
+
+size_t GameController::count_teams_scoring_between(int low, int high) const {
+    return game_state->get_team_ranks().count_between(low, high);
+}
+
+const turn_timer_settings& GameController::get_turn_timer_settings() const {
+    return game_state->get_turn_timer_settings();
+}
+
+void GameController::set_turn_timer_settings(const turn_timer_settings& settings) {
+    game_state->set_turn_timer_settings(settings);
+}
+
 // Point stealing functionality
 bool GameController::can_current_team_attempt(size_t row, size_t col) const {
     return game_state->can_current_team_attempt(row, col);
@@ -98,11 +273,14 @@ bool GameController::can_current_team_attempt(size_t row, size_t col) const {
 
 void GameController::mark_current_team_attempted(size_t row, size_t col) {
     game_state->mark_current_team_attempted(row, col);
+    emit attempts_changed(row, col);
 }
 
 bool GameController::switch_to_next_available_team(size_t row, size_t col) {
     bool has_next_team = game_state->switch_to_next_available_team(row, col);
     if (has_next_team) {
+        snapshots->set_current_team(game_state->get_current_team_index());
+        snapshots->publish();
         emit team_changed(game_state->get_current_team());
     }
     return has_next_team;
@@ -117,6 +295,76 @@ bool GameController::is_question_in_progress(size_t row, size_t col) const {
 }
 
 void GameController::complete_question(size_t row, size_t col) {
+    TRACE_SCOPE("GameController::complete_question");
     game_state->complete_question(row, col);
+    snapshots->set_revealed(row, col);
+    snapshots->publish();
     emit board_changed();
+    refresh_win_probabilities();
+}
+
+void GameController::publish_team(size_t team_index) {
+    if (team_index < game_state->get_teams().size()) {
+        snapshots->set_team(team_index, game_state->get_teams()[team_index]);
+    }
+    snapshots->set_current_team(game_state->get_current_team_index());
+    snapshots->publish();
+}
+
+void GameController::publish_scores_reset() {
+    snapshots->set_mode(game_state->get_current_mode());
+    snapshots->clear_revealed();
+    snapshots->load_teams(game_state->get_teams());
+    snapshots->set_current_team(game_state->get_current_team_index());
+    snapshots->publish();
+}
+
+std::shared_ptr<const game_snapshot> GameController::get_snapshot() const {
+    return snapshots->current();
+}
+
+std::shared_ptr<const snapshot_publisher> GameController::get_snapshot_publisher() const {
+    return snapshots;
+}
+
+const std::vector<double>& GameController::get_win_probabilities() const {
+    return win_probabilities;
+}
+
+void GameController::refresh_win_probabilities() {
+    TRACE_SCOPE("GameController::refresh_win_probabilities");
+    if (!win_engine) {
+        win_engine = std::make_unique<win_probability_engine>();
+    }
+    
+    win_probability_input input;
+    for (const auto& team : game_state->get_teams()) {
+        input.scores.push_back(team.get_score());
+    }
+    if (const play_board* play = game_state->get_play_board()) {
+        input.remaining_points.reserve(play->unrevealed_count());
+        for (size_t row = 0; row < play->get_rows(); ++row) {
+            for (size_t col = 0; col < play->get_cols(); ++col) {
+                if (!play->is_revealed(row, col)) {
+                    input.remaining_points.push_back(play->get_points(row, col));
+                }
+            }
+        }
+    } else {
+        // Before a game every clue is still to be played
+        const board* board = game_state->get_board();
+        for (size_t row = 0; row < board->get_rows(); ++row) {
+            for (size_t col = 0; col < board->get_cols(); ++col) {
+                input.remaining_points.push_back(board->get_cell(row, col).get_points());
+            }
+        }
+    }
+    input.current_team = game_state->get_current_team_index();
+    
+    win_engine->request(std::move(input), [this](const win_probability_result& result) {
+        QMetaObject::invokeMethod(this, [this, probabilities = result.probabilities]() {
+            win_probabilities = probabilities;
+            emit win_probabilities_changed(win_probabilities);
+        }, Qt::QueuedConnection);
+    });
 }
@@ -0,0 +1,488 @@
+#include "controller/scoreboard_server.h"
+#include "util/trace.h"
+#include "util/log.h"
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QElapsedTimer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUrlQuery>
+#include <algorithm>
+#include <array>
+#include <utility>
+
+// Lives on the server thread; everything here runs there
+class ScoreboardWorker : public QObject {
+public:
+    ScoreboardWorker(std::shared_ptr<const snapshot_publisher> publisher, std::atomic<quint64>& requests_served,
+                     std::atomic<bool>& wake_pending);
+
+    bool listen(quint16 port, QString* error);
+    [[nodiscard]] quint16 listening_port() const { return server ? server->serverPort() : 0; }
+    void close();
+    // The published state changed: wake the long polls it answers
+    void refresh();
+
+private:
+    enum endpoint { TEAMS, BOARD, STATE, ENDPOINT_COUNT };
+
+    struct response_cache {
+        QByteArray etag;
+        QByteArray full;  // Headers and body
+        QByteArray head;  // Headers only, for HEAD
+        QByteArray not_modified;
+    };
+
+    struct client {
+        QByteArray buffer;
+        bool waiting = false;
+        endpoint waiting_on = TEAMS;
+        QByteArray waiting_etag;
+        bool head_only = false;
+        bool keep_alive = true;
+        quint64 wait_id = 0;
+        qint64 last_active_ms = 0;  // On the worker's clock
+    };
+
+    std::shared_ptr<const snapshot_publisher> publisher;
+    std::atomic<quint64>& requests_served;
+    std::atomic<bool>& wake_pending;
+    QTcpServer* server;
+    QTimer* idle_timer;  // Runs only while someone is connected
+    QElapsedTimer clock;
+    QHash<QTcpSocket*, client> clients;
+    std::shared_ptr<const game_snapshot> latest;
+    std::array<response_cache, ENDPOINT_COUNT> responses;
+    QByteArray teams_body;
+    uint64_t teams_body_version;
+    QByteArray board_body;
+    uint64_t board_body_version;
+    QByteArray etag_prefix;  // Random per run, so a restart never matches an old tag
+    quint64 next_wait_id;
+
+    void on_new_connection();
+    void on_ready_read(QTcpSocket* socket);
+    void close_idle_clients();
+    // Answers buffered requests in order until one has to wait or none is complete
+    void process(QTcpSocket* socket);
+    void finish_wait(QTcpSocket* socket);
+    void send(QTcpSocket* socket, const QByteArray& response, bool keep_alive);
+    void send_error(QTcpSocket* socket, const char* status, const char* extra_headers = "");
+
+    [[nodiscard]] QByteArray etag_for(endpoint target) const;
+    const response_cache& response_for(endpoint target);
+    const QByteArray& serialize_teams();
+    const QByteArray& serialize_board();
+    static bool etag_matches(const QByteArray& if_none_match, const QByteArray& etag);
+};
+
+namespace {
+
+const char* mode_name(GameMode mode) {
+    return mode == GameMode::PLAYING ? "playing" : "config";
+}
+
+}
+
+ScoreboardWorker::ScoreboardWorker(std::shared_ptr<const snapshot_publisher> publisher,
+                                   std::atomic<quint64>& requests_served, std::atomic<bool>& wake_pending)
+    : publisher(std::move(publisher)), requests_served(requests_served), wake_pending(wake_pending), server(nullptr),
+      idle_timer(nullptr), teams_body_version(0), board_body_version(0),
+      etag_prefix(QByteArray::number(QRandomGenerator::global()->generate(), 16)), next_wait_id(0) {
+    latest = this->publisher->current();
+    clock.start();
+}
+
+bool ScoreboardWorker::listen(quint16 port, QString* error) {
+    if (!server) {
+        // Created here rather than in the constructor so it belongs to this thread
+        server = new QTcpServer(this);
+        connect(server, &QTcpServer::newConnection, this, [this]() { on_new_connection(); });
+        idle_timer = new QTimer(this);
+        idle_timer->setInterval(ScoreboardServer::IDLE_TIMEOUT_SECONDS * 1000 / 2);
+        connect(idle_timer, &QTimer::timeout, this, [this]() { close_idle_clients(); });
+    }
+    if (!server->listen(QHostAddress::Any, port)) {
+        if (error) *error = server->errorString();
+        return false;
+    }
+    return true;
+}
+
+void ScoreboardWorker::close() {
+    if (server) {
+        server->close();
+    }
+    if (idle_timer) {
+        idle_timer->stop();
+    }
+    for (auto it = clients.cbegin(); it != clients.cend(); ++it) {
+        it.key()->disconnect(this);
+        it.key()->abort();
+        it.key()->deleteLater();
+    }
+    clients.clear();
+}
+
+void ScoreboardWorker::refresh() {
+    wake_pending = false;
+    latest = publisher->current();
+
+    TRACE_SCOPE("ScoreboardWorker::refresh");
+    QList<QTcpSocket*> woken;
+    for (auto it = clients.cbegin(); it != clients.cend(); ++it) {
+        if (it->waiting && it->waiting_etag != etag_for(it->waiting_on)) {
+            woken.append(it.key());
+        }
+    }
+    // Answering may close a socket, so the list is collected before any is touched
+    for (QTcpSocket* socket : std::as_const(woken)) {
+        finish_wait(socket);
+    }
+}
+
+void ScoreboardWorker::on_new_connection() {
+    while (QTcpSocket* socket = server->nextPendingConnection()) {
+        if (clients.size() >= ScoreboardServer::MAX_CLIENTS) {
+            // Turned away without being tracked; the socket goes once the reply is out
+            connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            socket->write("HTTP/1.1 503 Service Unavailable\r\nRetry-After: 5\r\n"
+                          "Content-Length: 0\r\nConnection: close\r\n\r\n");
+            socket->disconnectFromHost();
+            continue;
+        }
+        socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        client entry;
+        entry.last_active_ms = clock.elapsed();
+        clients.insert(socket, entry);
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { on_ready_read(socket); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            clients.remove(socket);
+            socket->deleteLater();
+            if (clients.isEmpty()) {
+                idle_timer->stop();
+            }
+        });
+        if (!idle_timer->isActive()) {
+            idle_timer->start();
+        }
+    }
+}
+
+void ScoreboardWorker::close_idle_clients() {
+    const qint64 cutoff = clock.elapsed() - ScoreboardServer::IDLE_TIMEOUT_SECONDS * 1000;
+    QList<QTcpSocket*> idle;
+    for (auto it = clients.cbegin(); it != clients.cend(); ++it) {
+        // A parked long poll is bounded by its own wait
+        if (!it->waiting && it->last_active_ms < cutoff) {
+            idle.append(it.key());
+        }
+    }
+    for (QTcpSocket* socket : std::as_const(idle)) {
+        socket->disconnect(this);
+        clients.remove(socket);
+        socket->abort();
+        socket->deleteLater();
+    }
+    if (clients.isEmpty()) {
+        idle_timer->stop();
+    }
+}
+
+void ScoreboardWorker::on_ready_read(QTcpSocket* socket) {
+    auto it = clients.find(socket);
+    if (it == clients.end()) return;
+    it->last_active_ms = clock.elapsed();
+    it->buffer += socket->readAll();
+    if (it->buffer.size() > ScoreboardServer::MAX_REQUEST_BYTES) {
+        send_error(socket, "431 Request Header Fields Too Large");
+        return;
+    }
+    if (!it->waiting) {
+        process(socket);
+    }
+}
+
+void ScoreboardWorker::process(QTcpSocket* socket) {
+    while (true) {
+        auto it = clients.find(socket);
+        if (it == clients.end() || it->waiting) return;
+        qsizetype end = it->buffer.indexOf("\r\n\r\n");
+        if (end < 0) return;
+        QByteArray request = it->buffer.left(end);
+        it->buffer.remove(0, end + 4);
+
+        QList<QByteArray> lines = request.split('\n');
+        QList<QByteArray> request_line = lines.first().trimmed().split(' ');
+        if (request_line.size() != 3 || !request_line[2].startsWith("HTTP/1.")) {
+            send_error(socket, "400 Bad Request");
+            return;
+        }
+        const QByteArray& method = request_line[0];
+        bool http_11 = request_line[2] == "HTTP/1.1";
+        QByteArray if_none_match;
+        QByteArray connection;
+        for (qsizetype i = 1; i < lines.size(); ++i) {
+            qsizetype colon = lines[i].indexOf(':');
+            if (colon < 0) continue;
+            QByteArray name = lines[i].left(colon).trimmed().toLower();
+            QByteArray value = lines[i].mid(colon + 1).trimmed();
+            if (name == "if-none-match") {
+                if_none_match = value;
+            } else if (name == "connection") {
+                connection = value.toLower();
+            } else if ((name == "content-length" && value != "0") || name == "transfer-encoding") {
+                // Nothing here takes a body, and skipping one safely is not worth the code
+                send_error(socket, "400 Bad Request");
+                return;
+            }
+        }
+        bool keep_alive = http_11 ? connection != "close" : connection == "keep-alive";
+
+        if (method != "GET" && method != "HEAD") {
+            send_error(socket, "405 Method Not Allowed", "Allow: GET, HEAD\r\n");
+            return;
+        }
+        QByteArray target = request_line[1];
+        qsizetype question_mark = target.indexOf('?');
+        QByteArray path = question_mark < 0 ? target : target.left(question_mark);
+        QUrlQuery query(question_mark < 0 ? QString() : QString::fromUtf8(target.mid(question_mark + 1)));
+        endpoint requested;
+        if (path == "/teams") {
+            requested = TEAMS;
+        } else if (path == "/board") {
+            requested = BOARD;
+        } else if (path == "/state") {
+            requested = STATE;
+        } else {
+            send_error(socket, "404 Not Found");
+            return;
+        }
+
+        // Read fresh here too: the wakeup for a change may still be queued
+        latest = publisher->current();
+        const response_cache& response = response_for(requested);
+        bool head_only = method == "HEAD";
+        if (!etag_matches(if_none_match, response.etag)) {
+            send(socket, head_only ? response.head : response.full, keep_alive);
+            continue;
+        }
+        int wait_seconds = std::clamp(query.queryItemValue("wait").toInt(), 0, ScoreboardServer::MAX_WAIT_SECONDS);
+        if (wait_seconds == 0) {
+            send(socket, response.not_modified, keep_alive);
+            continue;
+        }
+
+        it->waiting = true;
+        it->waiting_on = requested;
+        it->waiting_etag = response.etag;
+        it->head_only = head_only;
+        it->keep_alive = keep_alive;
+        it->wait_id = ++next_wait_id;
+        QTimer::singleShot(wait_seconds * 1000, socket, [this, socket, wait_id = it->wait_id]() {
+            auto waiter = clients.find(socket);
+            if (waiter != clients.end() && waiter->waiting && waiter->wait_id == wait_id) {
+                finish_wait(socket);
+            }
+        });
+        return;
+    }
+}
+
+void ScoreboardWorker::finish_wait(QTcpSocket* socket) {
+    auto it = clients.find(socket);
+    if (it == clients.end()) return;
+    it->waiting = false;
+    bool keep_alive = it->keep_alive;
+    // A timeout can race a change whose wakeup is still queued, so compare again
+    latest = publisher->current();
+    const response_cache& response = response_for(it->waiting_on);
+    if (response.etag != it->waiting_etag) {
+        send(socket, it->head_only ? response.head : response.full, keep_alive);
+    } else {
+        send(socket, response.not_modified, keep_alive);
+    }
+    if (keep_alive) {
+        process(socket);
+    }
+}
+
+void ScoreboardWorker::send(QTcpSocket* socket, const QByteArray& response, bool keep_alive) {
+    socket->write(response);
+    requests_served.fetch_add(1, std::memory_order_relaxed);
+    // The idle clock restarts after an answer, so a long poll that just ended gets the full timeout
+    clients[socket].last_active_ms = clock.elapsed();
+    if (!keep_alive) {
+        clients[socket].buffer.clear();
+        socket->disconnectFromHost();
+    }
+}
+
+void ScoreboardWorker::send_error(QTcpSocket* socket, const char* status, const char* extra_headers) {
+    socket->write(QByteArray("HTTP/1.1 ") + status + "\r\n" + extra_headers +
+                  "Content-Length: 0\r\nConnection: close\r\n\r\n");
+    requests_served.fetch_add(1, std::memory_order_relaxed);
+    clients[socket].buffer.clear();
+    socket->disconnectFromHost();
+}
+
+QByteArray ScoreboardWorker::etag_for(endpoint target) const {
+    QByteArray tag = '"' + etag_prefix;
+    if (target != BOARD) tag += "-t" + QByteArray::number(latest->teams_version);
+    if (target != TEAMS) tag += "-b" + QByteArray::number(latest->board_version);
+    return tag + '"';
+}
+
+const ScoreboardWorker::response_cache& ScoreboardWorker::response_for(endpoint target) {
+    response_cache& cache = responses[target];
+    QByteArray etag = etag_for(target);
+    if (cache.etag == etag) {
+        return cache;
+    }
+
+    TRACE_SCOPE("ScoreboardWorker::response_for");
+    QByteArray body;
+    switch (target) {
+        case TEAMS:
+            body = serialize_teams();
+            break;
+        case BOARD:
+            body = serialize_board();
+            break;
+        default:
+            body = "{\"teams\":" + serialize_teams() + ",\"board\":" + serialize_board() + '}';
+            break;
+    }
+    QByteArray shared_headers = "ETag: " + etag + "\r\nCache-Control: no-cache\r\nAccess-Control-Allow-Origin: *\r\n";
+    cache.etag = etag;
+    cache.head = "HTTP/1.1 200 OK\r\nContent-Type: application/json; charset=utf-8\r\nContent-Length: " +
+                 QByteArray::number(body.size()) + "\r\n" + shared_headers + "\r\n";
+    cache.full = cache.head + body;
+    cache.not_modified = "HTTP/1.1 304 Not Modified\r\n" + shared_headers + "\r\n";
+    return cache;
+}
+
+const QByteArray& ScoreboardWorker::serialize_teams() {
+    if (teams_body_version == latest->teams_version && !teams_body.isEmpty()) {
+        return teams_body;
+    }
+    QJsonArray teams;
+    for (size_t i = 0; i < latest->teams.size(); ++i) {
+        const snapshot_team& entry = latest->teams[i];
+        teams.append(QJsonObject{{"name", entry.name.qstr()}, {"score", entry.score}});
+    }
+    QJsonObject document;
+    document["version"] = static_cast<qint64>(latest->teams_version);
+    document["mode"] = mode_name(latest->mode);
+    document["current_team"] = static_cast<qint64>(latest->current_team);
+    document["teams"] = teams;
+    teams_body = QJsonDocument(document).toJson(QJsonDocument::Compact);
+    teams_body_version = latest->teams_version;
+    return teams_body;
+}
+
+const QByteArray& ScoreboardWorker::serialize_board() {
+    if (board_body_version == latest->board_version && !board_body.isEmpty()) {
+        return board_body;
+    }
+    QJsonArray categories;
+    for (size_t col = 0; col < latest->cols; ++col) {
+        categories.append(latest->categories[col].qstr());
+    }
+    QJsonArray rows;
+    for (size_t row = 0; row < latest->rows; ++row) {
+        QJsonArray cells;
+        for (size_t col = 0; col < latest->cols; ++col) {
+            const snapshot_cell& entry = latest->cell_at(row, col);
+            bool revealed = latest->is_revealed(row, col);
+            QJsonObject record{{"points", entry.points}, {"revealed", revealed}};
+            // Screens facing the room must not show a clue before it is played
+            if (revealed) {
+                record["question"] = entry.question.qstr();
+                record["answer"] = entry.answer.qstr();
+            }
+            cells.append(record);
+        }
+        rows.append(cells);
+    }
+    QJsonObject document;
+    document["version"] = static_cast<qint64>(latest->board_version);
+    document["rows"] = static_cast<qint64>(latest->rows);
+    document["cols"] = static_cast<qint64>(latest->cols);
+    document["categories"] = categories;
+    document["cells"] = rows;
+    board_body = QJsonDocument(document).toJson(QJsonDocument::Compact);
+    board_body_version = latest->board_version;
+    return board_body;
+}
+
+bool ScoreboardWorker::etag_matches(const QByteArray& if_none_match, const QByteArray& etag) {
+    if (if_none_match.isEmpty()) return false;
+    if (if_none_match == "*") return true;
+    for (QByteArray candidate : if_none_match.split(',')) {
+        candidate = candidate.trimmed();
+        if (candidate.startsWith("W/")) candidate.remove(0, 2);
+        if (candidate == etag) return true;
+    }
+    return false;
+}
+
+ScoreboardServer::ScoreboardServer(GameController* controller, QObject* parent)
+    : QObject(parent), game_controller(controller), worker(nullptr), port(0), requests_served(0), wake_pending(false) {
+    // Every signal a screen could care about; the worker sorts out what actually changed
+    connect(game_controller, &GameController::score_changed, this, &ScoreboardServer::on_state_changed);
+    connect(game_controller, &GameController::board_changed, this, &ScoreboardServer::on_state_changed);
+    connect(game_controller, &GameController::team_changed, this, &ScoreboardServer::on_state_changed);
+    connect(game_controller, &GameController::team_added, this, &ScoreboardServer::on_state_changed);
+    connect(game_controller, &GameController::team_renamed, this, &ScoreboardServer::on_state_changed);
+    connect(game_controller, &GameController::mode_changed, this, &ScoreboardServer::on_state_changed);
+}
+
+ScoreboardServer::~ScoreboardServer() {
+    stop();
+    worker_thread.quit();
+    worker_thread.wait();
+}
+
+bool ScoreboardServer::start(quint16 requested_port, QString* error) {
+    stop();
+    if (!worker) {
+        worker = new ScoreboardWorker(game_controller->get_snapshot_publisher(), requests_served, wake_pending);
+        worker->moveToThread(&worker_thread);
+        connect(&worker_thread, &QThread::started, worker, []() { tracer::set_thread_name("scoreboard"); });
+        connect(&worker_thread, &QThread::finished, worker, &QObject::deleteLater);
+        worker_thread.setObjectName("Scoreboard");
+        worker_thread.start();
+    }
+
+    bool listening = false;
+    QString message;
+    QMetaObject::invokeMethod(worker, [this, requested_port, &listening, &message]() {
+        listening = worker->listen(requested_port, &message);
+        if (listening) {
+            port = worker->listening_port();
+        }
+    }, Qt::BlockingQueuedConnection);
+    if (listening) {
+        LOG_INFO(LogCategory::NETWORK, "Scoreboard serving on port {}", get_port());
+    } else {
+        LOG_WARNING(LogCategory::NETWORK, "Scoreboard could not listen on port {}: {}", requested_port, message.toStdString());
+        if (error) *error = message;
+    }
+    return listening;
+}
+
+void ScoreboardServer::stop() {
+    if (!worker || !is_running()) return;
+    QMetaObject::invokeMethod(worker, [this]() { worker->close(); }, Qt::BlockingQueuedConnection);
+    port = 0;
+}
+
+void ScoreboardServer::on_state_changed() {
+    if (!worker || !is_running() || wake_pending.exchange(true)) return;
+    QMetaObject::invokeMethod(worker, [this]() { worker->refresh(); }, Qt::QueuedConnection);
+}
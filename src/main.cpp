@@ -1,10 +1,107 @@
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QStandardPaths>
 #include <QPushButton>
+#include <QTimer>
 #include "view/main_window.h"
+#include "view/idle_monitor.h"
+#include "util/trace.h"
+#include "util/log.h"
+#include "util/startup_timer.h"
+#include "util/benchmarks.h"
+#include "util/command_line_tool.h"
+#include <cstdio>
+#include <string>
+
+namespace {
+
+constexpr int IDLE_SETTLE_MS = 2000;
+
+}
 
 int main(int argc, char* argv[]) {
+    // Benchmarks and the board tools need no display, so they run before any Qt application object exists
+    if (argc == 3 && std::string(argv[1]) == "--benchmark") {
+        return benchmarks::run(argv[2]);
+    }
+    if (argc >= 2 && command_line_tool::handles(argv[1])) {
+        return command_line_tool::run(argc, argv);
+    }
+    
     QApplication a(argc, argv);
+    QApplication::setApplicationName("jpdy");
+    startup_timer::mark("QApplication constructed");
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption trace_option("trace", "Record a Chrome trace and write it to <file> on exit.", "file");
+    parser.addOption(trace_option);
+    QCommandLineOption startup_report_option("startup-report", "Print startup timing once the first frame is painted.");
+    parser.addOption(startup_report_option);
+    QCommandLineOption memory_report_option("memory-report", "Print a memory report after the first frame and on exit.");
+    parser.addOption(memory_report_option);
+    QCommandLineOption idle_report_option("idle-report", "Measure wakeups for <seconds> after startup settles and print them.", "seconds");
+    parser.addOption(idle_report_option);
+    QCommandLineOption log_level_option("log-level", "Log messages from <level> up: verbose, info, warning or critical.", "level", "info");
+    parser.addOption(log_level_option);
+    parser.process(a);
+
+    LogLevel log_level = LogLevel::INFO;
+    if (!logger::parse_level(parser.value(log_level_option).toStdString(), log_level)) {
+        std::fprintf(stderr, "Unknown log level '%s'\n", qPrintable(parser.value(log_level_option)));
+        return 2;
+    }
+    logger::set_min_level(log_level);
+    log_settings logging;
+    logging.path = QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).filePath("jpdy.log").toStdString();
+    if (!logger::start(logging)) {
+        std::fprintf(stderr, "Could not open %s; logging to stderr only\n", logging.path.c_str());
+    }
+
+    const QString trace_path = parser.value(trace_option);
+    tracer::set_thread_name("gui");
+    if (!trace_path.isEmpty()) {
+        tracer::set_enabled(true);
+    }
+
     MainWindow w;
+    startup_timer::mark("MainWindow constructed");
+    const bool startup_report = parser.isSet(startup_report_option);
+    const bool print_memory_report = parser.isSet(memory_report_option);
+    const int idle_report_seconds = parser.isSet(idle_report_option) ? parser.value(idle_report_option).toInt() : 0;
+    if (idle_report_seconds > 0) {
+        QObject::connect(w.get_idle_monitor(), &IdleMonitor::finished, [](const idle_report& report) {
+            std::fputs(report.to_text().c_str(), stdout);
+            std::fflush(stdout);
+        });
+    }
+    QObject::connect(&w, &MainWindow::first_frame_shown, [&w, startup_report, print_memory_report, idle_report_seconds]() {
+        startup_timer::mark("first frame painted");
+        if (startup_report) {
+            std::fputs(startup_timer::report().c_str(), stdout);
+        }
+        if (print_memory_report) {
+            std::fputs(w.collect_memory_report().to_text().c_str(), stdout);
+        }
+        std::fflush(stdout);
+        if (idle_report_seconds > 0) {
+            // Let deferred startup work (autosave restore, first layouts) finish before measuring
+            QTimer::singleShot(IDLE_SETTLE_MS, &w, [&w, idle_report_seconds]() {
+                w.get_idle_monitor()->measure(idle_report_seconds * 1000);
+            });
+        }
+    });
     w.show();
-    return QApplication::exec();
-}
\ No newline at end of file
+    int result = QApplication::exec();
+    
+    if (print_memory_report) {
+        std::fputs(w.collect_memory_report().to_text().c_str(), stdout);
+    }
+
+    if (!trace_path.isEmpty() && !tracer::export_chrome_trace(trace_path.toStdString())) {
+        LOG_WARNING(LogCategory::GENERAL, "Could not write trace to {}", trace_path.toStdString());
+    }
+    logger::stop();
+    return result;
+}
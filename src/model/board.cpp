@@ -1,41 +1,67 @@
 #include "model/board.h"
+#include "util/trace.h"
 
-board::board(size_t rows, size_t cols) : rows(rows), cols(cols) {
-    cells.resize(rows, std::vector<cell>(cols));
-    categories.resize(cols);
+board::board(size_t rows, size_t cols)
+    : data(std::make_shared<board_data>()), dirty(std::make_shared<dirty_state>()), structure_dirty(true) {
+    data->rows = rows;
+    data->cols = cols;
+    data->cells.resize(rows, std::vector<cell>(cols));
+    data->categories.resize(cols);
     
     
     for (size_t i = 0; i < cols; ++i) {
-        categories[i] = "Category " + std::to_string(i + 1);
+        data->categories[i] = "Category " + std::to_string(i + 1);
     }
     
     
     for (size_t row = 0; row < rows; ++row) {
         for (size_t col = 0; col < cols; ++col) {
-            cells[row][col].set_points(get_cell_points(row));
-            cells[row][col].set_question(" ");
-            cells[row][col].set_answer(" ");
+            data->cells[row][col].set_points(get_cell_points(row));
+            data->cells[row][col].set_question(" ");
+            data->cells[row][col].set_answer(" ");
         }
     }
 }
 
+void board::detach() {
+    // Snapshots are only created on the owning thread, so a count of one cannot grow concurrently
+    if (data.use_count() > 1) {
+        TRACE_SCOPE("board::detach");
+        data = std::make_shared<board_data>(*data);
+    }
+}
+
+void board::detach_dirty() {
+    if (dirty.use_count() > 1) {
+        dirty = std::make_shared<dirty_state>(*dirty);
+    }
+}
+
 void board::resize_board(size_t new_rows, size_t new_cols) {
-    rows = new_rows;
-    cols = new_cols;
+    TRACE_SCOPE("board::resize_board");
+    detach();
+    mark_all_dirty();
+    auto& cells = data->cells;
+    auto& categories = data->categories;
+    data->rows = new_rows;
+    data->cols = new_cols;
     
-    cells.resize(rows, std::vector<cell>(cols));
-    categories.resize(cols);
+    cells.resize(new_rows, std::vector<cell>(new_cols));
+    for (auto& row_cells : cells) {
+        row_cells.resize(new_cols);
+    }
+    categories.resize(new_cols);
     
     
-    for (size_t i = 0; i < cols; ++i) {
+    for (size_t i = 0; i < new_cols; ++i) {
         if (categories[i].empty()) {
             categories[i] = "Category " + std::to_string(i + 1);
         }
     }
     
     
-    for (size_t row = 0; row < rows; ++row) {
-        for (size_t col = 0; col < cols; ++col) {
+    for (size_t row = 0; row < new_rows; ++row) {
+        for (size_t col = 0; col < new_cols; ++col) {
             cells[row][col].set_points(get_cell_points(row));
             if (cells[row][col].get_question().empty()) {
                 cells[row][col].set_question("Question for " + std::to_string((row + 1) * 100) + " points");
@@ -45,62 +71,155 @@ void board::resize_board(size_t new_rows, size_t new_cols) {
     }
 }
 
-void board::set_category(size_t col, const std::string& category) {
-    if (col < cols) {
-        categories[col] = category;
+void board::set_category(size_t col, const shared_text& category) {
+    if (col < data->cols && data->categories[col] != category) {
+        detach();
+        data->categories[col] = category;
+        mark_category_dirty(col);
     }
 }
 
-void board::set_cell_content(size_t row, size_t col, const std::string& question, const std::string& answer) {
-    if (is_valid_position(row, col)) {
-        cells[row][col].set_question(question);
-        cells[row][col].set_answer(answer);
-    }
+void board::set_cell_content(size_t row, size_t col, const shared_text& question, const shared_text& answer) {
+    if (!is_valid_position(row, col)) return;
+    
+    // Rewriting identical content neither detaches nor dirties the cell
+    const cell& current = data->cells[row][col];
+    if (current.has_content(question, answer, current.get_media_path_text(), current.get_media_type())) return;
+    
+    detach();
+    data->cells[row][col].set_question(question);
+    data->cells[row][col].set_answer(answer);
+    mark_cell_dirty(row, col);
+}
+
+void board::set_cell_media(size_t row, size_t col, const shared_text& path, MediaType type) {
+    if (!is_valid_position(row, col)) return;
+    
+    const cell& current = data->cells[row][col];
+    if (current.has_content(current.get_question_text(), current.get_answer_text(), path, type)) return;
+    
+    detach();
+    data->cells[row][col].set_media(path, type);
+    mark_cell_dirty(row, col);
 }
 
 size_t board::get_rows() const {
-    return rows;
+    return data->rows;
 }
 
 size_t board::get_cols() const {
-    return cols;
+    return data->cols;
 }
 
 const std::string& board::get_category(size_t col) const {
-    static const std::string empty_category = "";
-    if (col < cols) {
-        return categories[col];
+    return get_category_text(col).str();
+}
+
+const shared_text& board::get_category_text(size_t col) const {
+    static const shared_text empty_category;
+    if (col < data->cols) {
+        return data->categories[col];
     }
     return empty_category;
 }
 
 const cell& board::get_cell(size_t row, size_t col) const {
-    return cells[row][col];
+    return data->cells[row][col];
 }
 
 cell& board::get_cell(size_t row, size_t col) {
-    return cells[row][col];
+    detach();
+    return data->cells[row][col];
+}
+
+bool board::is_valid_position(size_t row, size_t col) const {
+    return row < data->rows && col < data->cols;
+}
+
+bool board::shares_data_with(const board& other) const {
+    return data == other.data;
 }
 
-void board::reveal_cell(size_t row, size_t col) {
-    if (is_valid_position(row, col)) {
-        cells[row][col].reveal();
+int board::get_cell_points(size_t row) const {
+    return static_cast<int>((row + 1) * 100);
+}
+
+void board::mark_cell_dirty(size_t row, size_t col) {
+    if (structure_dirty) return;
+    size_t index = row * data->cols + col;
+    if (!dirty->cell_bits[index]) {
+        detach_dirty();
+        dirty->cell_bits[index] = true;
+        dirty->cell_list.emplace_back(row, col);
     }
 }
 
-void board::reset_board() {
-    for (auto& row : cells) {
-        for (auto& cell : row) {
-            cell.reset();
-        }
+void board::mark_category_dirty(size_t col) {
+    if (structure_dirty) return;
+    if (!dirty->category_bits[col]) {
+        detach_dirty();
+        dirty->category_bits[col] = true;
+        dirty->category_list.push_back(col);
     }
 }
 
-bool board::is_valid_position(size_t row, size_t col) const {
-    return row < rows && col < cols;
+bool board::needs_full_save() const {
+    return structure_dirty;
 }
 
-int board::get_cell_points(size_t row) const {
-    return static_cast<int>((row + 1) * 100);
+bool board::has_unsaved_changes() const {
+    return structure_dirty || !dirty->cell_list.empty() || !dirty->category_list.empty();
+}
+
+const std::vector<cell_position>& board::dirty_cells() const {
+    return dirty->cell_list;
+}
+
+const std::vector<size_t>& board::dirty_categories() const {
+    return dirty->category_list;
 }
 
+void board::mark_clean() {
+    // A fresh state, so snapshots still sharing the old one keep their edits
+    structure_dirty = false;
+    dirty = std::make_shared<dirty_state>();
+    dirty->cell_bits.assign(data->rows * data->cols, false);
+    dirty->category_bits.assign(data->cols, false);
+}
+
+void board::mark_all_dirty() {
+    structure_dirty = true;
+    dirty = std::make_shared<dirty_state>();
+}
+
+memory_usage board::cell_memory() const {
+    memory_usage usage;
+    usage.bytes = sizeof(board_data) + data->cells.capacity() * sizeof(std::vector<cell>);
+    for (const auto& row_cells : data->cells) {
+        usage.objects += row_cells.size();
+        usage.bytes += row_cells.capacity() * sizeof(cell);
+    }
+    return usage;
+}
+
+memory_usage board::text_memory() const {
+    memory_usage usage;
+    auto count = [&usage](const shared_text& text) {
+        if (!text.empty()) {
+            ++usage.objects;
+            usage.bytes += text.heap_bytes();
+        }
+    };
+    usage.bytes += data->categories.capacity() * sizeof(shared_text);
+    for (const auto& category : data->categories) {
+        count(category);
+    }
+    for (const auto& row_cells : data->cells) {
+        for (const auto& game_cell : row_cells) {
+            count(game_cell.get_question_text());
+            count(game_cell.get_answer_text());
+            count(game_cell.get_media_path_text());
+        }
+    }
+    return usage;
+}
@@ -0,0 +1,63 @@
+#include "model/board_analysis.h"
+#include <cctype>
+#include <map>
+#include <string>
+
+namespace {
+
+// Questions that differ only in case or spacing count as duplicates
+std::string duplicate_key(const std::string& question) {
+    std::string key;
+    key.reserve(question.size());
+    bool pending_space = false;
+    for (unsigned char c : question) {
+        if (std::isspace(c)) {
+            pending_space = !key.empty();
+            continue;
+        }
+        if (pending_space) {
+            key += ' ';
+            pending_space = false;
+        }
+        key += static_cast<char>(std::tolower(c));
+    }
+    return key;
+}
+
+}
+
+board_analysis board_analysis::analyze(const board& game_board) {
+    board_analysis result;
+    result.column_points.assign(game_board.get_cols(), 0);
+    std::map<std::string, std::vector<cell_position>> questions;
+    
+    for (size_t row = 0; row < game_board.get_rows(); ++row) {
+        for (size_t col = 0; col < game_board.get_cols(); ++col) {
+            const cell& game_cell = game_board.get_cell(row, col);
+            result.column_points[col] += game_cell.get_points();
+            result.total_points += game_cell.get_points();
+            if (game_cell.has_media()) {
+                ++result.media_cells;
+            }
+            
+            switch (game_cell.get_content_state()) {
+                case ContentState::EMPTY:
+                    result.empty_cells.emplace_back(row, col);
+                    continue;
+                case ContentState::QUESTION_ONLY:
+                    result.missing_answers.emplace_back(row, col);
+                    break;
+                case ContentState::COMPLETE:
+                    break;
+            }
+            questions[duplicate_key(game_cell.get_question())].emplace_back(row, col);
+        }
+    }
+    
+    for (auto& [key, positions] : questions) {
+        if (positions.size() > 1) {
+            result.duplicate_questions.push_back(std::move(positions));
+        }
+    }
+    return result;
+}
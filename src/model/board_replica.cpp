@@ -0,0 +1,102 @@
+#include "model/board_replica.h"
+#include <algorithm>
+
+board_replica::board_replica(uint32_t replica_id) : replica_id(replica_id), clock(0) {
+}
+
+crdt_stamp board_replica::next_stamp() {
+    return {++clock, replica_id};
+}
+
+board_operation board_replica::set_dimensions(size_t rows, size_t cols) {
+    board_operation operation;
+    operation.kind = board_operation_kind::DIMENSIONS;
+    operation.stamp = next_stamp();
+    operation.row = static_cast<uint32_t>(rows);
+    operation.col = static_cast<uint32_t>(cols);
+    merge(operation);
+    return operation;
+}
+
+board_operation board_replica::set_category(size_t col, const shared_text& name) {
+    board_operation operation;
+    operation.kind = board_operation_kind::CATEGORY;
+    operation.stamp = next_stamp();
+    operation.col = static_cast<uint32_t>(col);
+    operation.text = name;
+    merge(operation);
+    return operation;
+}
+
+board_operation board_replica::set_cell(size_t row, size_t col, const shared_text& question, const shared_text& answer,
+                                        const shared_text& media_path, MediaType media_type) {
+    board_operation operation;
+    operation.kind = board_operation_kind::CELL;
+    operation.stamp = next_stamp();
+    operation.row = static_cast<uint32_t>(row);
+    operation.col = static_cast<uint32_t>(col);
+    operation.text = question;
+    operation.answer = answer;
+    operation.media_path = media_path;
+    operation.media_type = media_path.empty() ? MediaType::NONE : media_type;
+    merge(operation);
+    return operation;
+}
+
+bool board_replica::merge_into(board_operation& current, const board_operation& operation) {
+    if (!(current.stamp < operation.stamp)) return false;
+    current = operation;
+    return true;
+}
+
+bool board_replica::merge(const board_operation& operation) {
+    // Later local edits must outrank everything this replica has seen
+    clock = std::max(clock, operation.stamp.counter);
+    
+    switch (operation.kind) {
+        case board_operation_kind::DIMENSIONS:
+            if (!dimensions) {
+                dimensions = operation;
+                return true;
+            }
+            return merge_into(*dimensions, operation);
+        case board_operation_kind::CATEGORY: {
+            auto [entry, inserted] = categories.try_emplace(operation.col, operation);
+            return inserted || merge_into(entry->second, operation);
+        }
+        case board_operation_kind::CELL: {
+            auto [entry, inserted] = cells.try_emplace(cell_key(operation.row, operation.col), operation);
+            return inserted || merge_into(entry->second, operation);
+        }
+    }
+    return false;
+}
+
+std::vector<board_operation> board_replica::state() const {
+    std::vector<board_operation> operations;
+    operations.reserve(register_count());
+    if (dimensions) {
+        operations.push_back(*dimensions);
+    }
+    for (const auto& [col, operation] : categories) {
+        operations.push_back(operation);
+    }
+    for (const auto& [key, operation] : cells) {
+        operations.push_back(operation);
+    }
+    return operations;
+}
+
+const board_operation* board_replica::find_category(size_t col) const {
+    auto entry = categories.find(static_cast<uint32_t>(col));
+    return entry != categories.end() ? &entry->second : nullptr;
+}
+
+const board_operation* board_replica::find_cell(size_t row, size_t col) const {
+    auto entry = cells.find(cell_key(static_cast<uint32_t>(row), static_cast<uint32_t>(col)));
+    return entry != cells.end() ? &entry->second : nullptr;
+}
+
+size_t board_replica::register_count() const {
+    return (dimensions ? 1 : 0) + categories.size() + cells.size();
+}
@@ -1,60 +1,78 @@
 #include "../../include/model/cell.h"
 
-void cell::set_question(const std::string& question) {
+void cell::set_question(const shared_text& question) {
     this->question = question;
+    refresh_content_hash();
 }
 
-void cell::set_answer(const std::string& answer) {
+void cell::set_answer(const shared_text& answer) {
     this->answer = answer;
+    refresh_content_hash();
 }
 
 void cell::set_points(int points) {
     this->points = points;
 }
 
-void cell::set_is_revealed(bool is_revealed) {
-    this->is_revealed = is_revealed;
+void cell::set_media(const shared_text& path, MediaType type) {
+    this->media_path = path;
+    this->media_type = path.empty() ? MediaType::NONE : type;
+    refresh_content_hash();
 }
 
-const std::string& cell::get_answer() const {
-    return this->answer;
+// Order-sensitive mix of the per-field hashes, so swapping question and answer changes the result
+uint64_t cell::hash_content(const shared_text& question, const shared_text& answer,
+                            const shared_text& media_path, MediaType media_type) {
+    uint64_t hash = 0;
+    auto mix = [&hash](uint64_t value) {
+        hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    };
+    mix(question.hash());
+    mix(answer.hash());
+    mix(media_path.hash());
+    mix(static_cast<uint64_t>(media_type));
+    return hash;
 }
 
-const std::string& cell::get_question() const {
-    return this->question;
+bool cell::has_content(const shared_text& question, const shared_text& answer, const shared_text& media_path,
+                       MediaType media_type) const {
+    if (media_path.empty()) media_type = MediaType::NONE;
+    if (hash_content(question, answer, media_path, media_type) != content_hash) return false;
+    return media_type == this->media_type && question == this->question && answer == this->answer &&
+           media_path == this->media_path;
 }
 
-int cell::get_points() const {
-    return this->points;
+void cell::refresh_content_hash() {
+    content_hash = hash_content(question, answer, media_path, media_type);
 }
 
-bool cell::get_is_revealed() const {
-    return this->is_revealed;
+const std::string& cell::get_answer() const {
+    return this->answer.str();
 }
 
-void cell::reveal() {
-    this->is_revealed = true;
+const std::string& cell::get_question() const {
+    return this->question.str();
 }
 
-void cell::reset() {
-    this->is_revealed = false;
-    this->attempted_teams.clear();
+int cell::get_points() const {
+    return this->points;
 }
 
-// Team attempt tracking methods
-void cell::add_attempted_team(size_t team_index) {
-    attempted_teams.insert(team_index);
+const std::string& cell::get_media_path() const {
+    return this->media_path.str();
 }
 
-bool cell::has_team_attempted(size_t team_index) const {
-    return attempted_teams.find(team_index) != attempted_teams.end();
+MediaType cell::get_media_type() const {
+    return this->media_type;
 }
 
-const std::set<size_t>& cell::get_attempted_teams() const {
-    return attempted_teams;
+bool cell::has_media() const {
+    return this->media_type != MediaType::NONE;
 }
 
-void cell::clear_attempted_teams() {
-    attempted_teams.clear();
+ContentState cell::get_content_state() const {
+    if (question.is_blank()) {
+        return ContentState::EMPTY;
+    }
+    return answer.is_blank() ? ContentState::QUESTION_ONLY : ContentState::COMPLETE;
 }
-
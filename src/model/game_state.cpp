@@ -1,4 +1,6 @@
 #include "model/game_state.h"
+#include "util/trace.h"
+#include <algorithm>
 
 GameState::GameState(size_t rows, size_t cols)
     : current_mode(GameMode::CONFIG), current_team_index(0) {
@@ -6,19 +8,28 @@ GameState::GameState(size_t rows, size_t cols)
     teams.emplace_back("Team 1");
     teams.emplace_back("Team 2");
     teams.emplace_back("Team 3");
+    for (const auto& entry : teams) {
+        team_ranks.add(entry.get_score());
+    }
 }
 
 void GameState::start_config_mode() {
     current_mode = GameMode::CONFIG;
+    play.reset();
 }
 
 void GameState::start_game_mode() {
+    TRACE_SCOPE("GameState::start_game_mode");
     current_mode = GameMode::PLAYING;
     current_team_index = 0;
+    game_started_at = std::chrono::steady_clock::now();
     for (auto& team : teams) {
         team.set_score(0);
+        team.clear_history();
     }
-    game_board->reset_board();
+    team_ranks.reset(0);
+    // Play state starts fresh in the compiled copy; the editable board is left untouched
+    play = std::make_unique<play_board>(play_board::compile(*game_board, teams.size()));
 }
 
 GameMode GameState::get_current_mode() const {
@@ -31,27 +42,49 @@ void GameState::configure_board_size(size_t rows, size_t cols) {
     }
 }
 
-void GameState::set_category_name(size_t col, const std::string& name) {
+void GameState::set_category_name(size_t col, const shared_text& name) {
     if (current_mode == GameMode::CONFIG) {
         game_board->set_category(col, name);
     }
 }
 
-void GameState::set_question_answer(size_t row, size_t col, const std::string& question, const std::string& answer) {
+void GameState::set_question_answer(size_t row, size_t col, const shared_text& question, const shared_text& answer) {
     if (current_mode == GameMode::CONFIG) {
         game_board->set_cell_content(row, col, question, answer);
     }
 }
 
+void GameState::set_question_media(size_t row, size_t col, const shared_text& path, MediaType type) {
+    if (current_mode == GameMode::CONFIG) {
+        game_board->set_cell_media(row, col, path, type);
+    }
+}
+
+bool GameState::load_board(const board& loaded_board) {
+    if (current_mode != GameMode::CONFIG) {
+        return false;
+    }
+    *game_board = loaded_board;
+    game_board->mark_all_dirty();
+    return true;
+}
+
+void GameState::mark_board_saved() {
+    game_board->mark_clean();
+}
+
 const board* GameState::get_board() const {
     return game_board.get();
 }
 
+const play_board* GameState::get_play_board() const {
+    return play.get();
+}
+
 bool GameState::select_cell(size_t row, size_t col) {
-    if (current_mode == GameMode::PLAYING && game_board->is_valid_position(row, col)) {
-        const cell& game_cell = game_board->get_cell(row, col);
+    if (current_mode == GameMode::PLAYING && play && play->is_valid_position(row, col)) {
         // Allow selection if cell is not revealed and not currently in progress
-        if (!game_cell.get_is_revealed() && !is_question_in_progress(row, col)) {
+        if (!play->is_revealed(row, col) && !play->is_in_progress(row, col)) {
             // Don't mark as revealed yet - only mark when question is completely finished
             return true;
         }
@@ -59,9 +92,13 @@ bool GameState::select_cell(size_t row, size_t col) {
     return false;
 }
 
-bool GameState::add_team(const std::string& team_name) {
-    if (teams.size() < max_teams) {
+bool GameState::add_team(const shared_text& team_name) {
+    if (teams.size() < MAX_TEAMS) {
         teams.emplace_back(team_name);
+        team_ranks.add(teams.back().get_score());
+        if (play) {
+            play->reserve_teams(teams.size());
+        }
         return true;
     }
     return false;
@@ -71,16 +108,29 @@ void GameState::switch_to_next_team() {
     current_team_index = (current_team_index + 1) % teams.size();
 }
 
-void GameState::add_to_current_team_score(int points) {
+void GameState::record_current_team_score_change(int delta, int row, int col) {
     if (!teams.empty()) {
-        teams[current_team_index].set_score(teams[current_team_index].get_score() + points);
+        auto elapsed = std::chrono::steady_clock::now() - game_started_at;
+        int64_t elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+        teams[current_team_index].record_score_change(delta, elapsed_ms, row, col);
+        team_ranks.update(current_team_index, teams[current_team_index].get_score());
     }
 }
 
+void GameState::add_to_current_team_score(int points) {
+    record_current_team_score_change(points, -1, -1);
+}
+
 void GameState::subtract_from_current_team_score(int points) {
-    if (!teams.empty()) {
-        teams[current_team_index].set_score(teams[current_team_index].get_score() - points);
-    }
+    record_current_team_score_change(-points, -1, -1);
+}
+
+void GameState::add_to_current_team_score(int points, size_t row, size_t col) {
+    record_current_team_score_change(points, static_cast<int>(row), static_cast<int>(col));
+}
+
+void GameState::subtract_from_current_team_score(int points, size_t row, size_t col) {
+    record_current_team_score_change(-points, static_cast<int>(row), static_cast<int>(col));
 }
 
 int GameState::get_current_team_score() const {
@@ -98,34 +148,46 @@ const std::vector<team>& GameState::get_teams() const {
     return teams;
 }
 
-void GameState::set_team_name(size_t team_index, const std::string& new_name) {
+void GameState::set_team_name(size_t team_index, const shared_text& new_name) {
     if (team_index < teams.size() && !new_name.empty()) {
         teams[team_index].set_name(new_name);
     }
 }
 
+const rank_index& GameState::get_team_ranks() const {
+    return team_ranks;
+}
+
+const turn_timer_settings& GameState::get_turn_timer_settings() const {
+    return timer_settings;
+}
+
+void GameState::set_turn_timer_settings(const turn_timer_settings& settings) {
+    timer_settings.answer_seconds = std::max(settings.answer_seconds, 0);
+    timer_settings.steal_seconds = std::max(settings.steal_seconds, 0);
+}
+
 void GameState::reset_game() {
     start_game_mode();
 }
 
 // Point stealing functionality
 bool GameState::can_current_team_attempt(size_t row, size_t col) const {
-    if (current_mode != GameMode::PLAYING || !game_board->is_valid_position(row, col)) {
+    if (current_mode != GameMode::PLAYING || !play || !play->is_valid_position(row, col)) {
         return false;
     }
     
-    const cell& game_cell = game_board->get_cell(row, col);
-    return !game_cell.has_team_attempted(current_team_index);
+    return !play->has_team_attempted(row, col, current_team_index);
 }
 
 void GameState::mark_current_team_attempted(size_t row, size_t col) {
-    if (current_mode == GameMode::PLAYING && game_board->is_valid_position(row, col)) {
-        get_cell_mutable(row, col).add_attempted_team(current_team_index);
+    if (current_mode == GameMode::PLAYING && play) {
+        play->mark_attempted(row, col, current_team_index);
     }
 }
 
 bool GameState::switch_to_next_available_team(size_t row, size_t col) {
-    if (current_mode != GameMode::PLAYING || !game_board->is_valid_position(row, col)) {
+    if (current_mode != GameMode::PLAYING || !play || !play->is_valid_position(row, col)) {
         return false;
     }
     
@@ -134,13 +196,12 @@ bool GameState::switch_to_next_available_team(size_t row, size_t col) {
         return false;
     }
     
-    const cell& game_cell = game_board->get_cell(row, col);
     size_t original_team = current_team_index;
     
     // Try each team to find one that hasn't attempted this question
     for (size_t i = 0; i < teams.size(); ++i) {
         switch_to_next_team();
-        if (!game_cell.has_team_attempted(current_team_index)) {
+        if (!play->has_team_attempted(row, col, current_team_index)) {
             return true;  // Found a team that can attempt
         }
         if (current_team_index == original_team) {
@@ -155,23 +216,13 @@ size_t GameState::get_current_team_index() const {
     return current_team_index;
 }
 
-// Helper method to get mutable cell reference
-cell& GameState::get_cell_mutable(size_t row, size_t col) {
-    return game_board->get_cell(row, col);
-}
-
 bool GameState::is_question_in_progress(size_t row, size_t col) const {
-    if (!game_board->is_valid_position(row, col)) {
-        return false;
-    }
-    
-    const cell& game_cell = game_board->get_cell(row, col);
     // Question is in progress if some teams have attempted but it's not revealed
-    return !game_cell.get_attempted_teams().empty() && !game_cell.get_is_revealed();
+    return play && play->is_valid_position(row, col) && play->is_in_progress(row, col);
 }
 
 void GameState::complete_question(size_t row, size_t col) {
-    if (current_mode == GameMode::PLAYING && game_board->is_valid_position(row, col)) {
-        game_board->reveal_cell(row, col);
+    if (current_mode == GameMode::PLAYING && play) {
+        play->reveal(row, col);
     }
 }
@@ -0,0 +1,126 @@
+#include "model/play_board.h"
+#include "util/trace.h"
+#include <algorithm>
+#include <bit>
+#include <string_view>
+#include <unordered_map>
+
+play_board play_board::compile(const board& source, size_t team_count) {
+    TRACE_SCOPE("play_board::compile");
+    play_board compiled;
+    compiled.rows = source.get_rows();
+    compiled.cols = source.get_cols();
+    const size_t cell_count = compiled.rows * compiled.cols;
+    
+    // Views point into the shared_text payloads kept alive by texts
+    std::unordered_map<std::string_view, uint32_t> interned;
+    interned.reserve(cell_count * 2 + compiled.cols);
+    compiled.texts.reserve(cell_count + compiled.cols + 1);
+    compiled.texts.emplace_back();
+    interned.emplace(std::string_view(), 0);
+    auto intern = [&compiled, &interned](const shared_text& text) {
+        auto [entry, inserted] = interned.try_emplace(text.str(), static_cast<uint32_t>(compiled.texts.size()));
+        if (inserted) {
+            compiled.texts.push_back(text);
+        }
+        return entry->second;
+    };
+    
+    compiled.categories.reserve(compiled.cols);
+    for (size_t col = 0; col < compiled.cols; ++col) {
+        compiled.categories.push_back(intern(source.get_category_text(col)));
+    }
+    compiled.clues.reserve(cell_count);
+    for (size_t row = 0; row < compiled.rows; ++row) {
+        for (size_t col = 0; col < compiled.cols; ++col) {
+            const cell& source_cell = source.get_cell(row, col);
+            compiled.clues.push_back({intern(source_cell.get_question_text()), intern(source_cell.get_answer_text()),
+                                      intern(source_cell.get_media_path_text()), source_cell.get_points(),
+                                      source_cell.get_media_type()});
+        }
+    }
+    
+    compiled.revealed.assign(cell_count, 0);
+    compiled.attempts.assign(cell_count, 0);
+    compiled.words_per_cell = std::max<size_t>(1, (team_count + 63) / 64);
+    compiled.attempted_bits.assign(cell_count * compiled.words_per_cell, 0);
+    return compiled;
+}
+
+const shared_text& play_board::get_category_text(size_t col) const {
+    return texts[col < cols ? categories[col] : 0];
+}
+
+bool play_board::has_team_attempted(size_t row, size_t col, size_t team_index) const {
+    size_t word = team_index / 64;
+    if (word >= words_per_cell) return false;
+    return (attempted_bits[index_of(row, col) * words_per_cell + word] >> (team_index % 64)) & 1u;
+}
+
+bool play_board::is_in_progress(size_t row, size_t col) const {
+    size_t index = index_of(row, col);
+    return attempts[index] > 0 && !revealed[index];
+}
+
+std::vector<size_t> play_board::attempted_teams(size_t row, size_t col) const {
+    std::vector<size_t> teams;
+    size_t index = index_of(row, col);
+    if (attempts[index] == 0) return teams;
+    
+    teams.reserve(attempts[index]);
+    const uint64_t* words = &attempted_bits[index * words_per_cell];
+    for (size_t word = 0; word < words_per_cell; ++word) {
+        for (uint64_t bits = words[word]; bits != 0; bits &= bits - 1) {
+            teams.push_back(word * 64 + static_cast<size_t>(std::countr_zero(bits)));
+        }
+    }
+    return teams;
+}
+
+void play_board::reveal(size_t row, size_t col) {
+    if (!is_valid_position(row, col)) return;
+    uint8_t& flag = revealed[index_of(row, col)];
+    if (!flag) {
+        flag = 1;
+        ++revealed_total;
+    }
+}
+
+void play_board::mark_attempted(size_t row, size_t col, size_t team_index) {
+    if (!is_valid_position(row, col)) return;
+    reserve_teams(team_index + 1);
+    
+    size_t index = index_of(row, col);
+    uint64_t& word = attempted_bits[index * words_per_cell + team_index / 64];
+    uint64_t bit = uint64_t(1) << (team_index % 64);
+    if (!(word & bit)) {
+        word |= bit;
+        ++attempts[index];
+    }
+}
+
+void play_board::reserve_teams(size_t team_count) {
+    size_t needed = (team_count + 63) / 64;
+    if (needed <= words_per_cell) return;
+    
+    std::vector<uint64_t> widened(rows * cols * needed, 0);
+    for (size_t index = 0; index < rows * cols; ++index) {
+        for (size_t word = 0; word < words_per_cell; ++word) {
+            widened[index * needed + word] = attempted_bits[index * words_per_cell + word];
+        }
+    }
+    attempted_bits = std::move(widened);
+    words_per_cell = needed;
+}
+
+memory_usage play_board::memory() const {
+    memory_usage usage;
+    usage.objects = texts.size();
+    usage.bytes = texts.capacity() * sizeof(shared_text) + categories.capacity() * sizeof(uint32_t) +
+                  clues.capacity() * sizeof(clue) + revealed.capacity() + attempts.capacity() * sizeof(uint16_t) +
+                  attempted_bits.capacity() * sizeof(uint64_t);
+    for (const shared_text& text : texts) {
+        usage.bytes += text.heap_bytes();
+    }
+    return usage;
+}
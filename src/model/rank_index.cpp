@@ -0,0 +1,189 @@
+#include "model/rank_index.h"
+#include <algorithm>
+
+namespace {
+
+// Priorities only need to look random; hashing the team index keeps them reproducible
+uint32_t priority_for(uint32_t team_index) {
+    uint64_t x = team_index + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return static_cast<uint32_t>(x ^ (x >> 31));
+}
+
+}
+
+void rank_index::add(int score) {
+    uint32_t item = static_cast<uint32_t>(nodes.size());
+    nodes.push_back({score, priority_for(item)});
+    root = insert(root, item);
+}
+
+void rank_index::update(size_t team_index, int new_score) {
+    uint32_t item = static_cast<uint32_t>(team_index);
+    if (team_index >= nodes.size() || nodes[item].score == new_score) return;
+    
+    root = erase(root, item);
+    nodes[item].score = new_score;
+    nodes[item].left = NONE;
+    nodes[item].right = NONE;
+    nodes[item].size = 1;
+    root = insert(root, item);
+}
+
+void rank_index::reset(int score) {
+    size_t count = nodes.size();
+    clear();
+    nodes.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        add(score);
+    }
+}
+
+void rank_index::clear() {
+    nodes.clear();
+    root = NONE;
+}
+
+uint32_t rank_index::merge(uint32_t a, uint32_t b) {
+    if (a == NONE) return b;
+    if (b == NONE) return a;
+    if (nodes[a].priority > nodes[b].priority) {
+        nodes[a].right = merge(nodes[a].right, b);
+        pull(a);
+        return a;
+    }
+    nodes[b].left = merge(a, nodes[b].left);
+    pull(b);
+    return b;
+}
+
+uint32_t rank_index::insert(uint32_t n, uint32_t item) {
+    if (n == NONE) return item;
+    if (nodes[item].priority > nodes[n].priority) {
+        // item becomes the root of this subtree; split n around it
+        uint32_t* left_slot = &nodes[item].left;
+        uint32_t* right_slot = &nodes[item].right;
+        std::vector<uint32_t> path;
+        uint32_t current = n;
+        while (current != NONE) {
+            path.push_back(current);
+            if (ahead(current, item)) {
+                *left_slot = current;
+                left_slot = &nodes[current].right;
+                current = nodes[current].right;
+            } else {
+                *right_slot = current;
+                right_slot = &nodes[current].left;
+                current = nodes[current].left;
+            }
+        }
+        *left_slot = NONE;
+        *right_slot = NONE;
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            pull(*it);
+        }
+        pull(item);
+        return item;
+    }
+    if (ahead(item, n)) {
+        nodes[n].left = insert(nodes[n].left, item);
+    } else {
+        nodes[n].right = insert(nodes[n].right, item);
+    }
+    pull(n);
+    return n;
+}
+
+uint32_t rank_index::erase(uint32_t n, uint32_t item) {
+    if (n == item) {
+        return merge(nodes[n].left, nodes[n].right);
+    }
+    if (ahead(item, n)) {
+        nodes[n].left = erase(nodes[n].left, item);
+    } else {
+        nodes[n].right = erase(nodes[n].right, item);
+    }
+    pull(n);
+    return n;
+}
+
+size_t rank_index::position_of(size_t team_index) const {
+    uint32_t item = static_cast<uint32_t>(team_index);
+    size_t position = size_of(nodes[item].left);
+    uint32_t current = root;
+    while (current != item) {
+        if (ahead(item, current)) {
+            current = nodes[current].left;
+        } else {
+            position += size_of(nodes[current].left) + 1;
+            current = nodes[current].right;
+        }
+    }
+    return position;
+}
+
+size_t rank_index::rank_of(size_t team_index) const {
+    int score = nodes[team_index].score;
+    return score == INT32_MAX ? 1 : count_at_least(score + 1) + 1;
+}
+
+size_t rank_index::team_at(size_t position) const {
+    uint32_t current = root;
+    while (current != NONE) {
+        size_t left_size = size_of(nodes[current].left);
+        if (position < left_size) {
+            current = nodes[current].left;
+        } else if (position == left_size) {
+            return current;
+        } else {
+            position -= left_size + 1;
+            current = nodes[current].right;
+        }
+    }
+    return NONE;
+}
+
+std::vector<size_t> rank_index::range(size_t first, size_t count) const {
+    std::vector<size_t> out;
+    if (first >= nodes.size()) return out;
+    count = std::min(count, nodes.size() - first);
+    out.reserve(count);
+    collect(root, first, count, out);
+    return out;
+}
+
+void rank_index::collect(uint32_t n, size_t first, size_t count, std::vector<size_t>& out) const {
+    // first is relative to this subtree; stop once count teams are gathered
+    if (n == NONE || out.size() == count) return;
+    size_t left_size = size_of(nodes[n].left);
+    if (first < left_size) {
+        collect(nodes[n].left, first, count, out);
+    }
+    if (out.size() < count && first <= left_size) {
+        out.push_back(n);
+    }
+    if (out.size() < count) {
+        collect(nodes[n].right, first > left_size ? first - left_size - 1 : 0, count, out);
+    }
+}
+
+size_t rank_index::count_at_least(int score) const {
+    size_t count = 0;
+    uint32_t current = root;
+    while (current != NONE) {
+        if (nodes[current].score >= score) {
+            count += size_of(nodes[current].left) + 1;
+            current = nodes[current].right;
+        } else {
+            current = nodes[current].left;
+        }
+    }
+    return count;
+}
+
+size_t rank_index::count_between(int low, int high) const {
+    if (low > high) return 0;
+    size_t upper = high == INT32_MAX ? 0 : count_at_least(high + 1);
+    return count_at_least(low) - upper;
+}
@@ -0,0 +1,51 @@
+#include "model/shared_text.h"
+
+namespace {
+
+uint64_t fnv1a(const std::string& utf8) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : utf8) {
+        hash = (hash ^ c) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Same rule as QString::trimmed(), so Unicode spaces (e.g. NBSP) count as blank too
+bool is_whitespace_only(const QString& utf16) {
+    return utf16.trimmed().isEmpty();
+}
+
+}
+
+const shared_text::payload& shared_text::empty_payload() {
+    static const payload empty{std::string(), QString(), true, fnv1a(std::string())};
+    return empty;
+}
+
+size_t shared_text::heap_bytes() const {
+    if (!data) return 0;
+    // make_shared puts the control block (two counters and a vtable) next to the payload
+    return sizeof(payload) + 2 * sizeof(long) + sizeof(void*) +
+           data->utf8.capacity() + static_cast<size_t>(data->utf16.capacity()) * sizeof(QChar);
+}
+
+shared_text::shared_text(const char* utf8)
+    : shared_text(std::string(utf8 ? utf8 : "")) {
+}
+
+shared_text::shared_text(const std::string& utf8) {
+    if (!utf8.empty()) {
+        QString utf16 = QString::fromStdString(utf8);
+        bool blank = is_whitespace_only(utf16);
+        data = std::make_shared<const payload>(payload{utf8, std::move(utf16), blank, fnv1a(utf8)});
+    }
+}
+
+shared_text::shared_text(const QString& utf16) {
+    if (!utf16.isEmpty()) {
+        std::string utf8 = utf16.toStdString();
+        bool blank = is_whitespace_only(utf16);
+        uint64_t hash = fnv1a(utf8);
+        data = std::make_shared<const payload>(payload{std::move(utf8), utf16, blank, hash});
+    }
+}
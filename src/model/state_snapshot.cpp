@@ -0,0 +1,108 @@
+#include "model/state_snapshot.h"
+#include "util/trace.h"
+
+snapshot_publisher::snapshot_publisher() {
+    publish();
+}
+
+std::shared_ptr<const game_snapshot> snapshot_publisher::current() const {
+#if defined(__cpp_lib_atomic_shared_ptr)
+    return published.load(std::memory_order_acquire);
+#else
+    return std::atomic_load_explicit(&published, std::memory_order_acquire);
+#endif
+}
+
+void snapshot_publisher::load_board(const board& source) {
+    TRACE_SCOPE("snapshot_publisher::load_board");
+    board_touched = true;
+    draft.rows = source.get_rows();
+    draft.cols = source.get_cols();
+    draft.categories.assign(draft.cols);
+    draft.cells.assign(draft.rows * draft.cols);
+    draft.revealed.assign(draft.rows * draft.cols, 0);
+    for (size_t col = 0; col < draft.cols; ++col) {
+        set_category(col, source.get_category_text(col));
+    }
+    for (size_t row = 0; row < draft.rows; ++row) {
+        for (size_t col = 0; col < draft.cols; ++col) {
+            set_cell(row, col, source.get_cell(row, col));
+        }
+    }
+}
+
+void snapshot_publisher::set_category(size_t col, const shared_text& name) {
+    board_touched = true;
+    if (col < draft.cols) {
+        draft.categories.set(col, name);
+    }
+}
+
+void snapshot_publisher::set_cell(size_t row, size_t col, const cell& source) {
+    board_touched = true;
+    if (row < draft.rows && col < draft.cols) {
+        draft.cells.set(row * draft.cols + col, {source.get_question_text(), source.get_answer_text(),
+                                                 source.get_media_path_text(), source.get_media_type(),
+                                                 source.get_points()});
+    }
+}
+
+void snapshot_publisher::set_revealed(size_t row, size_t col) {
+    board_touched = true;
+    if (row < draft.rows && col < draft.cols) {
+        draft.revealed.set(row * draft.cols + col, 1);
+    }
+}
+
+void snapshot_publisher::clear_revealed() {
+    board_touched = true;
+    draft.revealed.assign(draft.rows * draft.cols, 0);
+}
+
+void snapshot_publisher::load_teams(const std::vector<team>& source) {
+    teams_touched = true;
+    draft.teams.assign(0);
+    draft.total_score = 0;
+    for (size_t i = 0; i < source.size(); ++i) {
+        set_team(i, source[i]);
+    }
+}
+
+void snapshot_publisher::set_team(size_t team_index, const team& source) {
+    teams_touched = true;
+    snapshot_team entry{source.get_name_text(), source.get_score()};
+    if (team_index == draft.teams.size()) {
+        draft.teams.push_back(entry);
+    } else if (team_index < draft.teams.size()) {
+        draft.total_score -= draft.teams[team_index].score;
+        draft.teams.set(team_index, entry);
+    } else {
+        return;
+    }
+    draft.total_score += entry.score;
+}
+
+void snapshot_publisher::set_mode(GameMode mode) {
+    teams_touched = true;
+    draft.mode = mode;
+}
+
+void snapshot_publisher::set_current_team(size_t team_index) {
+    teams_touched = true;
+    draft.current_team = team_index;
+}
+
+void snapshot_publisher::publish() {
+    ++draft.version;
+    if (board_touched) draft.board_version = draft.version;
+    if (teams_touched) draft.teams_version = draft.version;
+    board_touched = false;
+    teams_touched = false;
+    // The copy takes a reference to each chunk; the draft's next write to one clones it
+    auto next = std::make_shared<const game_snapshot>(draft);
+#if defined(__cpp_lib_atomic_shared_ptr)
+    published.store(std::move(next), std::memory_order_release);
+#else
+    std::atomic_store_explicit(&published, std::move(next), std::memory_order_release);
+#endif
+}
@@ -0,0 +1,261 @@
+#include "model/win_probability.h"
+#include "util/trace.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+// xoshiro256+ seeded through splitmix64; fast and good enough for doubles
+class xoshiro256 {
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    explicit xoshiro256(uint64_t seed) {
+        for (uint64_t& word : state) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = state[0] + state[3];
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    double uniform() { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+};
+
+constexpr size_t LANES = win_probability_engine::LANES;
+
+// Plays LANES games to the end and adds each lane's winner to wins
+void play_lanes(const win_probability_input& input, const std::vector<double>& answer_cdf,
+                xoshiro256& rng, std::vector<int32_t>& scores, std::vector<double>& wins) {
+    const size_t teams = input.scores.size();
+    for (size_t team = 0; team < teams; ++team) {
+        std::fill_n(&scores[team * LANES], LANES, static_cast<int32_t>(input.scores[team]));
+    }
+
+    size_t picker = input.current_team % teams;
+    std::array<int32_t, LANES> answered_by;
+    for (int points : input.remaining_points) {
+        // Offset from the picker of the first team to answer correctly; teams means nobody did
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            double u = rng.uniform();
+            int32_t offset = 0;
+            for (double threshold : answer_cdf) {
+                offset += u >= threshold;
+            }
+            answered_by[lane] = std::min<int32_t>(offset, static_cast<int32_t>(teams));
+        }
+
+        for (size_t team = 0; team < teams; ++team) {
+            const int32_t team_offset = static_cast<int32_t>((team + teams - picker) % teams);
+            int32_t* team_scores = &scores[team * LANES];
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                int32_t missed = team_offset < answered_by[lane];
+                int32_t answered = team_offset == answered_by[lane];
+                team_scores[lane] += (answered - missed) * points;
+            }
+        }
+        picker = (picker + 1) % teams;
+    }
+
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        int32_t best = scores[lane];
+        for (size_t team = 1; team < teams; ++team) {
+            best = std::max(best, scores[team * LANES + lane]);
+        }
+        int leaders = 0;
+        for (size_t team = 0; team < teams; ++team) {
+            leaders += scores[team * LANES + lane] == best;
+        }
+        double share = 1.0 / leaders;
+        for (size_t team = 0; team < teams; ++team) {
+            if (scores[team * LANES + lane] == best) {
+                wins[team] += share;
+            }
+        }
+    }
+}
+
+}
+
+win_probability_engine::win_probability_engine(size_t thread_count)
+    : thread_count(thread_count), generation(0), stopping(false), helper_task(nullptr), helper_round(0),
+      helpers_running(0), helpers_stopping(false) {
+    if (this->thread_count == 0) {
+        this->thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 1; i < this->thread_count; ++i) {
+        helpers.emplace_back(&win_probability_engine::helper_loop, this, i);
+    }
+    coordinator = std::thread(&win_probability_engine::coordinator_loop, this);
+}
+
+win_probability_engine::~win_probability_engine() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        pending.reset();
+        generation.fetch_add(1);
+    }
+    wake.notify_all();
+    coordinator.join();
+
+    {
+        std::lock_guard<std::mutex> lock(helper_mutex);
+        helpers_stopping = true;
+    }
+    helper_wake.notify_all();
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+}
+
+void win_probability_engine::request(win_probability_input input, result_callback on_result) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Abort the estimate in flight; its result would be stale
+        uint64_t request_generation = generation.fetch_add(1) + 1;
+        pending.emplace(job{std::move(input), std::move(on_result), request_generation});
+    }
+    wake.notify_all();
+}
+
+void win_probability_engine::cancel() {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.reset();
+    generation.fetch_add(1);
+}
+
+void win_probability_engine::coordinator_loop() {
+    tracer::set_thread_name("win_probability");
+    uint64_t seed = 1;
+    while (true) {
+        job next;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this]() { return stopping || pending.has_value(); });
+            if (stopping) return;
+            next = std::move(*pending);
+            pending.reset();
+        }
+
+        win_probability_result result = run(next.input, MAX_SIMULATIONS, TIME_BUDGET_MS, seed++, next.generation);
+        if (generation.load() == next.generation && next.on_result) {
+            next.on_result(result);
+        }
+    }
+}
+
+void win_probability_engine::helper_loop(size_t worker_index) {
+    tracer::set_thread_name("win_probability_helper");
+    uint64_t seen_round = 0;
+    while (true) {
+        const std::function<void(size_t)>* task;
+        {
+            std::unique_lock<std::mutex> lock(helper_mutex);
+            helper_wake.wait(lock, [&]() { return helpers_stopping || helper_round != seen_round; });
+            if (helpers_stopping) return;
+            seen_round = helper_round;
+            task = helper_task;
+        }
+        (*task)(worker_index);
+        {
+            std::lock_guard<std::mutex> lock(helper_mutex);
+            if (--helpers_running == 0) {
+                helper_done.notify_one();
+            }
+        }
+    }
+}
+
+void win_probability_engine::run_on_workers(const std::function<void(size_t)>& task) {
+    {
+        std::lock_guard<std::mutex> lock(helper_mutex);
+        helper_task = &task;
+        helpers_running = helpers.size();
+        ++helper_round;
+    }
+    helper_wake.notify_all();
+    task(0);
+    std::unique_lock<std::mutex> lock(helper_mutex);
+    helper_done.wait(lock, [this]() { return helpers_running == 0; });
+    helper_task = nullptr;
+}
+
+win_probability_result win_probability_engine::simulate(const win_probability_input& input, uint64_t max_simulations,
+                                                        int time_budget_ms, uint64_t seed) {
+    return run(input, max_simulations, time_budget_ms, seed, generation.load());
+}
+
+win_probability_result win_probability_engine::run(const win_probability_input& input, uint64_t max_simulations,
+                                                   int time_budget_ms, uint64_t seed, uint64_t job_generation) {
+    TRACE_SCOPE("win_probability_engine::simulate");
+    std::lock_guard<std::mutex> run_lock(run_mutex);
+    const auto started = std::chrono::steady_clock::now();
+    const auto deadline = started + std::chrono::milliseconds(time_budget_ms);
+    const size_t teams = input.scores.size();
+
+    win_probability_result result;
+    result.probabilities.assign(teams, 0.0);
+    if (teams == 0) {
+        return result;
+    }
+
+    // P(one of the first k+1 teams answers) until it rounds to one
+    std::vector<double> answer_cdf;
+    double miss = 1.0;
+    for (size_t k = 0; k < teams && miss > 0x1.0p-53; ++k) {
+        miss *= 1.0 - CORRECT_PROBABILITY;
+        answer_cdf.push_back(1.0 - miss);
+    }
+
+    std::atomic<uint64_t> simulations_started{0};
+    std::vector<std::vector<double>> worker_wins(thread_count, std::vector<double>(teams, 0.0));
+    std::vector<uint64_t> worker_simulations(thread_count, 0);
+
+    const std::function<void(size_t)> worker = [&](size_t worker_index) {
+        xoshiro256 rng(seed * 0x100000001b3ULL + worker_index);
+        std::vector<int32_t> scores(teams * LANES);
+        std::vector<double>& wins = worker_wins[worker_index];
+        while (simulations_started.fetch_add(LANES) < max_simulations) {
+            play_lanes(input, answer_cdf, rng, scores, wins);
+            worker_simulations[worker_index] += LANES;
+            if (generation.load(std::memory_order_relaxed) != job_generation ||
+                std::chrono::steady_clock::now() >= deadline) {
+                break;
+            }
+        }
+    };
+    run_on_workers(worker);
+
+    for (size_t i = 0; i < thread_count; ++i) {
+        result.simulations += worker_simulations[i];
+        for (size_t team = 0; team < teams; ++team) {
+            result.probabilities[team] += worker_wins[i][team];
+        }
+    }
+    if (result.simulations > 0) {
+        for (double& probability : result.probabilities) {
+            probability /= static_cast<double>(result.simulations);
+        }
+    }
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    return result;
+}
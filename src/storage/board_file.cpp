@@ -0,0 +1,269 @@
+#include "storage/board_file.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include "util/trace.h"
+
+namespace {
+
+void append_record(QByteArray& out, const QJsonObject& record) {
+    out += QJsonDocument(record).toJson(QJsonDocument::Compact);
+    out += '\n';
+}
+
+QJsonObject cell_record(const cell& game_cell, size_t row, size_t col) {
+    QJsonObject record;
+    record["cell"] = QJsonArray{static_cast<qint64>(row), static_cast<qint64>(col)};
+    record["question"] = game_cell.get_question_text().qstr();
+    record["answer"] = game_cell.get_answer_text().qstr();
+    if (game_cell.has_media()) {
+        record["media"] = game_cell.get_media_path_text().qstr();
+        record["media_type"] = board_file::media_type_name(game_cell.get_media_type());
+    }
+    return record;
+}
+
+// Files are held to board's limits, so a damaged or hostile one can't allocate without bound
+bool is_valid_size(qint64 rows, qint64 cols) {
+    return rows > 0 && cols > 0 && rows <= static_cast<qint64>(board::MAX_ROWS) &&
+           cols <= static_cast<qint64>(board::MAX_COLS);
+}
+
+void apply_cell_record(board& game_board, const QJsonObject& record) {
+    QJsonArray position = record["cell"].toArray();
+    size_t row = static_cast<size_t>(position.at(0).toInteger());
+    size_t col = static_cast<size_t>(position.at(1).toInteger());
+    game_board.set_cell_content(row, col, record["question"].toString(), record["answer"].toString());
+    game_board.set_cell_media(row, col, record["media"].toString(),
+                              board_file::media_type_from_name(record["media_type"].toString()));
+}
+
+}
+
+board_format board_file::format_for_path(const QString& path) {
+    return path.endsWith(".json", Qt::CaseInsensitive) ? board_format::JSON_DOCUMENT : board_format::JSON_LINES;
+}
+
+QString board_file::format_suffix(board_format format) {
+    return format == board_format::JSON_DOCUMENT ? "json" : "jpdy";
+}
+
+QString board_file::media_type_name(MediaType type) {
+    switch (type) {
+        case MediaType::IMAGE: return "image";
+        case MediaType::AUDIO: return "audio";
+        case MediaType::VIDEO: return "video";
+        case MediaType::NONE: break;
+    }
+    return "none";
+}
+
+MediaType board_file::media_type_from_name(const QString& name) {
+    if (name == "image") return MediaType::IMAGE;
+    if (name == "audio") return MediaType::AUDIO;
+    if (name == "video") return MediaType::VIDEO;
+    return MediaType::NONE;
+}
+
+QByteArray board_file::serialize(const board& game_board, board_format format) {
+    TRACE_SCOPE("board_file::serialize");
+    QByteArray out;
+    
+    QJsonObject header;
+    header["format"] = "jpdy-board";
+    header["version"] = FORMAT_VERSION;
+    header["rows"] = static_cast<qint64>(game_board.get_rows());
+    header["cols"] = static_cast<qint64>(game_board.get_cols());
+    
+    if (format == board_format::JSON_DOCUMENT) {
+        QJsonArray categories;
+        for (size_t col = 0; col < game_board.get_cols(); ++col) {
+            categories.append(game_board.get_category_text(col).qstr());
+        }
+        QJsonArray cells;
+        for (size_t row = 0; row < game_board.get_rows(); ++row) {
+            for (size_t col = 0; col < game_board.get_cols(); ++col) {
+                cells.append(cell_record(game_board.get_cell(row, col), row, col));
+            }
+        }
+        header["categories"] = categories;
+        header["cells"] = cells;
+        return QJsonDocument(header).toJson(QJsonDocument::Indented);
+    }
+    
+    append_record(out, header);
+    
+    for (size_t col = 0; col < game_board.get_cols(); ++col) {
+        QJsonObject record;
+        record["category"] = static_cast<qint64>(col);
+        record["name"] = game_board.get_category_text(col).qstr();
+        append_record(out, record);
+    }
+    
+    for (size_t row = 0; row < game_board.get_rows(); ++row) {
+        for (size_t col = 0; col < game_board.get_cols(); ++col) {
+            append_record(out, cell_record(game_board.get_cell(row, col), row, col));
+        }
+    }
+    return out;
+}
+
+std::optional<board> board_file::parse(const QByteArray& data, QString* error) {
+    TRACE_SCOPE("board_file::parse");
+    auto fail = [error](const QString& message) -> std::optional<board> {
+        if (error) *error = message;
+        return std::nullopt;
+    };
+    
+    const QList<QByteArray> lines = data.split('\n');
+    int last_line = static_cast<int>(lines.size());
+    while (last_line > 0 && lines[last_line - 1].trimmed().isEmpty()) {
+        --last_line;
+    }
+    
+    std::optional<board> result;
+    int line_number = 0;
+    
+    for (const QByteArray& line : lines) {
+        ++line_number;
+        if (line.trimmed().isEmpty()) continue;
+        
+        QJsonParseError parse_error;
+        QJsonDocument document = QJsonDocument::fromJson(line, &parse_error);
+        if (parse_error.error != QJsonParseError::NoError || !document.isObject()) {
+            // A torn final record from an interrupted append is ignored
+            if (line_number == last_line && result) {
+                break;
+            }
+            return fail(QString("line %1: %2").arg(line_number).arg(parse_error.errorString()));
+        }
+        QJsonObject record = document.object();
+        
+        if (!result) {
+            if (record["format"].toString() != "jpdy-board") {
+                return fail("not a jpdy board file");
+            }
+            if (record["version"].toInt() > FORMAT_VERSION) {
+                return fail(QString("unsupported format version %1").arg(record["version"].toInt()));
+            }
+            qint64 rows = record["rows"].toInteger();
+            qint64 cols = record["cols"].toInteger();
+            if (!is_valid_size(rows, cols)) {
+                return fail("invalid board size");
+            }
+            result.emplace(static_cast<size_t>(rows), static_cast<size_t>(cols));
+            continue;
+        }
+        
+        if (record.contains("rows") && record.contains("cols")) {
+            qint64 rows = record["rows"].toInteger();
+            qint64 cols = record["cols"].toInteger();
+            if (!is_valid_size(rows, cols)) {
+                return fail(QString("line %1: invalid board size").arg(line_number));
+            }
+            result->resize_board(static_cast<size_t>(rows), static_cast<size_t>(cols));
+        } else if (record.contains("category")) {
+            result->set_category(static_cast<size_t>(record["category"].toInteger()), record["name"].toString());
+        } else if (record.contains("cell")) {
+            apply_cell_record(*result, record);
+        }
+    }
+    
+    if (!result) {
+        return fail("empty board file");
+    }
+    return result;
+}
+
+std::optional<board> board_file::parse_document(const QByteArray& data, QString* error) {
+    TRACE_SCOPE("board_file::parse_document");
+    auto fail = [error](const QString& message) -> std::optional<board> {
+        if (error) *error = message;
+        return std::nullopt;
+    };
+    
+    QJsonParseError parse_error;
+    QJsonDocument document = QJsonDocument::fromJson(data, &parse_error);
+    if (parse_error.error != QJsonParseError::NoError || !document.isObject()) {
+        return fail(QString("offset %1: %2").arg(parse_error.offset).arg(parse_error.errorString()));
+    }
+    QJsonObject root = document.object();
+    if (root["format"].toString() != "jpdy-board") {
+        return fail("not a jpdy board file");
+    }
+    if (root["version"].toInt() > FORMAT_VERSION) {
+        return fail(QString("unsupported format version %1").arg(root["version"].toInt()));
+    }
+    qint64 rows = root["rows"].toInteger();
+    qint64 cols = root["cols"].toInteger();
+    if (!is_valid_size(rows, cols)) {
+        return fail("invalid board size");
+    }
+    
+    board result(static_cast<size_t>(rows), static_cast<size_t>(cols));
+    const QJsonArray categories = root["categories"].toArray();
+    for (qsizetype col = 0; col < categories.size(); ++col) {
+        result.set_category(static_cast<size_t>(col), categories.at(col).toString());
+    }
+    for (const QJsonValue& value : root["cells"].toArray()) {
+        apply_cell_record(result, value.toObject());
+    }
+    return result;
+}
+
+bool board_file::write(const QString& path, const board& game_board, QString* error) {
+    TRACE_SCOPE("board_file::write");
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+    file.write(serialize(game_board, format_for_path(path)));
+    if (!file.commit()) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+size_t board_file::delta_record_count(const board& game_board) {
+    return game_board.dirty_categories().size() + game_board.dirty_cells().size();
+}
+
+bool board_file::append_delta(const QString& path, const board& game_board, QString* error) {
+    TRACE_SCOPE("board_file::append_delta");
+    QByteArray out;
+    for (size_t col : game_board.dirty_categories()) {
+        QJsonObject record;
+        record["category"] = static_cast<qint64>(col);
+        record["name"] = game_board.get_category_text(col).qstr();
+        append_record(out, record);
+    }
+    for (const auto& [row, col] : game_board.dirty_cells()) {
+        append_record(out, cell_record(game_board.get_cell(row, col), row, col));
+    }
+    if (out.isEmpty()) return true;
+    
+    // Not atomic, but parse() drops a torn final record, so an interrupted append loses only itself
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append) || file.write(out) != out.size() || !file.flush()) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+std::optional<board> board_file::read(const QString& path, QString* error) {
+    TRACE_SCOPE("board_file::read");
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) *error = file.errorString();
+        return std::nullopt;
+    }
+    if (format_for_path(path) == board_format::JSON_DOCUMENT) {
+        return parse_document(file.readAll(), error);
+    }
+    return parse(file.readAll(), error);
+}
@@ -0,0 +1,852 @@
+#include "util/benchmarks.h"
+#include "model/win_probability.h"
+#include "model/rank_index.h"
+#include "model/board_replica.h"
+#include "controller/game_controller.h"
+#include "controller/collaboration_session.h"
+#include "controller/scoreboard_server.h"
+#include "view/board_table_model.h"
+#include "view/clue_text_view.h"
+#include "view/question_dialog.h"
+#include "storage/board_file.h"
+#include "util/log.h"
+#include <QApplication>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QEventLoop>
+#include <QFileInfo>
+#include <QImage>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+#include <QTemporaryDir>
+#include <QTextEdit>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <thread>
+
+namespace {
+
+int benchmark_win_probability() {
+    struct scenario {
+        const char* name;
+        size_t teams;
+        size_t rows;
+        size_t cols;
+    };
+    const scenario scenarios[] = {
+        {"3 teams, 5x6 board", 3, 5, 6},
+        {"5 teams, 5x6 board", 5, 5, 6},
+        {"20 teams, 10x8 board", 20, 10, 8},
+    };
+
+    win_probability_engine engine;
+    std::printf("win-probability (%u hardware threads)\n", std::thread::hardware_concurrency());
+    for (const scenario& s : scenarios) {
+        win_probability_input input;
+        input.scores.assign(s.teams, 0);
+        for (size_t row = 0; row < s.rows; ++row) {
+            for (size_t col = 0; col < s.cols; ++col) {
+                input.remaining_points.push_back(static_cast<int>((row + 1) * 100));
+            }
+        }
+
+        win_probability_result result = engine.simulate(input, UINT64_MAX, 1000, 42);
+        std::printf("  %-24s %12.0f simulations/s\n", s.name,
+                    static_cast<double>(result.simulations) / (result.elapsed_ms / 1000.0));
+    }
+    return 0;
+}
+
+int benchmark_batch_edits() {
+    int argc = 1;
+    char name[] = "jpdy";
+    char* argv[] = {name, nullptr};
+    QCoreApplication app(argc, argv);
+    struct scenario {
+        const char* name;
+        std::function<void(GameController&)> edit;
+    };
+    const size_t rows = 100;
+    const size_t cols = 40;
+    const scenario scenarios[] = {
+        {"paste column (100 cells)", [](GameController& controller) {
+            for (size_t row = 0; row < rows; ++row) {
+                controller.set_question_answer(row, 3, "Pasted question", "Pasted answer");
+            }
+        }},
+        {"rename categories (40)", [](GameController& controller) {
+            for (size_t col = 0; col < cols; ++col) {
+                controller.set_category_name(col, "Category");
+            }
+        }},
+        {"fill board (4000 cells)", [](GameController& controller) {
+            for (size_t row = 0; row < rows; ++row) {
+                for (size_t col = 0; col < cols; ++col) {
+                    controller.set_question_answer(row, col, "Question", "Answer");
+                }
+            }
+        }},
+        {"clear board", [](GameController& controller) { controller.clear_board(); }},
+    };
+
+    std::printf("batch-edits (%zux%zu board, refreshes = board_changed / model notifications)\n", rows, cols);
+    std::printf("  %-26s %20s %20s\n", "", "unbatched", "batched");
+    for (const scenario& s : scenarios) {
+        int refreshes[2] = {0, 0};
+        int model_notifications[2] = {0, 0};
+        double elapsed_ms[2] = {0.0, 0.0};
+
+        for (int batched = 0; batched < 2; ++batched) {
+            GameController controller;
+            controller.configure_board_size(rows, cols);
+            BoardTableModel model(&controller);
+            QObject::connect(&controller, &GameController::board_changed, [&refreshes, batched]() {
+                ++refreshes[batched];
+            });
+            QObject::connect(&model, &QAbstractItemModel::dataChanged, [&model_notifications, batched]() {
+                ++model_notifications[batched];
+            });
+            QObject::connect(&model, &QAbstractItemModel::headerDataChanged, [&model_notifications, batched]() {
+                ++model_notifications[batched];
+            });
+
+            auto started = std::chrono::steady_clock::now();
+            if (batched) {
+                board_batch batch(&controller);
+                s.edit(controller);
+            } else if (std::string(s.name) == "clear board") {
+                // clear_board always batches; replay its edits one by one
+                for (size_t col = 0; col < cols; ++col) {
+                    controller.set_category_name(col, "");
+                    for (size_t row = 0; row < rows; ++row) {
+                        controller.set_question_answer(row, col, "", "");
+                        controller.set_question_media(row, col, "", MediaType::NONE);
+                    }
+                }
+            } else {
+                s.edit(controller);
+            }
+            elapsed_ms[batched] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+        }
+
+        std::printf("  %-26s %6d / %-5d %6.2f ms %6d / %-5d %6.2f ms\n", s.name,
+                    refreshes[0], model_notifications[0], elapsed_ms[0],
+                    refreshes[1], model_notifications[1], elapsed_ms[1]);
+    }
+    return 0;
+}
+
+int benchmark_incremental_save() {
+    const size_t rows = 100;
+    const size_t cols = 100;
+    QTemporaryDir directory;
+    const QString path = directory.filePath("bank.jpdy");
+
+    board bank(rows, cols);
+    for (size_t row = 0; row < rows; ++row) {
+        for (size_t col = 0; col < cols; ++col) {
+            bank.set_cell_content(row, col, "Question " + std::to_string(row * cols + col), "Answer");
+        }
+    }
+
+    auto timed = [](const std::function<bool()>& save) {
+        auto started = std::chrono::steady_clock::now();
+        bool ok = save();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+        return ok ? ms : -1.0;
+    };
+
+    std::printf("incremental-save (%zux%zu board)\n", rows, cols);
+    double full_ms = timed([&]() { return board_file::write(path, bank); });
+    qint64 full_bytes = QFileInfo(path).size();
+    bank.mark_clean();
+    std::printf("  %-26s %10lld bytes %8.2f ms\n", "full write", static_cast<long long>(full_bytes), full_ms);
+
+    bank.set_cell_content(42, 17, "Edited question", "Edited answer");
+    double delta_ms = timed([&]() { return board_file::append_delta(path, bank); });
+    qint64 delta_bytes = QFileInfo(path).size() - full_bytes;
+    std::printf("  %-26s %10lld bytes %8.2f ms\n", "one edit, delta append", static_cast<long long>(delta_bytes), delta_ms);
+
+    std::optional<board> reloaded = board_file::read(path);
+    bool round_trip = reloaded && reloaded->get_cell(42, 17).get_question() == "Edited question";
+    std::printf("  %-26s %s\n", "reload sees the edit", round_trip ? "yes" : "NO");
+    return round_trip ? 0 : 1;
+}
+
+int benchmark_rank_index() {
+    const size_t team_count = 10000;
+    const size_t updates = 200000;
+    const size_t queries = 2000;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick_team(0, team_count - 1);
+    std::uniform_int_distribution<int> pick_delta(-10, 10);
+
+    rank_index ranks;
+    std::vector<int> scores(team_count, 0);
+    for (size_t i = 0; i < team_count; ++i) {
+        ranks.add(0);
+    }
+
+    auto elapsed_ns = [](std::chrono::steady_clock::time_point started) {
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count();
+    };
+
+    auto started = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < updates; ++i) {
+        size_t team_index = pick_team(rng);
+        scores[team_index] += pick_delta(rng) * 100;
+        ranks.update(team_index, scores[team_index]);
+    }
+    double update_ns = elapsed_ns(started) / updates;
+
+    std::vector<size_t> probes(queries);
+    for (size_t& probe : probes) {
+        probe = pick_team(rng);
+    }
+
+    // Baseline: what answering each query took before, by sorting all teams
+    auto sorted_order = [&scores]() {
+        std::vector<size_t> order(scores.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&scores](size_t a, size_t b) {
+            return scores[a] != scores[b] ? scores[a] > scores[b] : a < b;
+        });
+        return order;
+    };
+
+    size_t checksum = 0;
+    started = std::chrono::steady_clock::now();
+    for (size_t probe : probes) {
+        checksum += ranks.position_of(probe);
+    }
+    double rank_ns = elapsed_ns(started) / queries;
+
+    started = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < queries; ++i) {
+        checksum += ranks.top(10).front();
+    }
+    double top_ns = elapsed_ns(started) / queries;
+
+    const size_t baseline_queries = 50;
+    bool matches = true;
+    started = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < baseline_queries; ++i) {
+        std::vector<size_t> order = sorted_order();
+        size_t position = std::find(order.begin(), order.end(), probes[i]) - order.begin();
+        matches = matches && position == ranks.position_of(probes[i]);
+    }
+    double sort_ns = elapsed_ns(started) / baseline_queries;
+
+    std::vector<size_t> order = sorted_order();
+    matches = matches && ranks.range(0, team_count) == order;
+
+    std::printf("rank-index (%zu teams, %zu random score updates)\n", team_count, updates);
+    std::printf("  %-26s %12.0f ns\n", "score update", update_ns);
+    std::printf("  %-26s %12.0f ns\n", "rank of a team", rank_ns);
+    std::printf("  %-26s %12.0f ns\n", "top 10", top_ns);
+    std::printf("  %-26s %12.0f ns\n", "rank by sorting (before)", sort_ns);
+    std::printf("  %-26s %s\n", "matches a full sort", matches ? "yes" : "NO");
+    return matches && checksum > 0 ? 0 : 1;
+}
+
+int benchmark_crdt_merge() {
+    const size_t rows = 100;
+    const size_t cols = 40;
+    const size_t edits = 50000;
+    const size_t frame_operations = 64;
+
+    // Two editors start from the same board, then edit random cells concurrently
+    board_replica first(1);
+    board_replica second(2);
+    first.set_dimensions(rows, cols);
+    for (const board_operation& operation : first.state()) {
+        second.merge(operation);
+    }
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<size_t> pick_row(0, rows - 1);
+    std::uniform_int_distribution<size_t> pick_col(0, cols - 1);
+    std::vector<board_operation> first_edits;
+    std::vector<board_operation> second_edits;
+    for (size_t i = 0; i < edits; ++i) {
+        std::string text = "Clue " + std::to_string(i);
+        first_edits.push_back(first.set_cell(pick_row(rng), pick_col(rng), text, "A", "", MediaType::NONE));
+        second_edits.push_back(second.set_cell(pick_row(rng), pick_col(rng), text, "B", "", MediaType::NONE));
+    }
+
+    auto exchange = [frame_operations](const std::vector<board_operation>& operations, board_replica& target) {
+        for (size_t start = 0; start < operations.size(); start += frame_operations) {
+            size_t end = std::min(operations.size(), start + frame_operations);
+            QByteArray frame = CollaborationSession::encode({operations.begin() + start, operations.begin() + end});
+            std::optional<std::vector<board_operation>> decoded = CollaborationSession::decode(frame.mid(sizeof(quint32)));
+            for (const board_operation& operation : *decoded) {
+                target.merge(operation);
+            }
+        }
+    };
+
+    auto started = std::chrono::steady_clock::now();
+    for (const board_operation& operation : second_edits) {
+        first.merge(operation);
+    }
+    double merge_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+    started = std::chrono::steady_clock::now();
+    exchange(first_edits, second);
+    double wire_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+    bool converged = first.register_count() == second.register_count();
+    for (size_t row = 0; row < rows && converged; ++row) {
+        for (size_t col = 0; col < cols && converged; ++col) {
+            const board_operation* a = first.find_cell(row, col);
+            const board_operation* b = second.find_cell(row, col);
+            converged = (a == nullptr) == (b == nullptr) &&
+                        (!a || (a->stamp.counter == b->stamp.counter && a->stamp.replica == b->stamp.replica &&
+                                a->content_hash() == b->content_hash()));
+        }
+    }
+
+    std::printf("crdt-merge (%zux%zu board, %zu concurrent edits per editor)\n", rows, cols, edits);
+    std::printf("  %-26s %12.0f ops/s\n", "merge", edits / (merge_ms / 1000.0));
+    std::printf("  %-26s %12.0f ops/s\n", "encode, decode and merge", edits / (wire_ms / 1000.0));
+    std::printf("  %-26s %s\n", "replicas converged", converged ? "yes" : "NO");
+
+    // End to end over loopback: an edit on the host until the joined board has it
+    int argc = 1;
+    char name[] = "jpdy";
+    char* argv[] = {name, nullptr};
+    QCoreApplication app(argc, argv);
+    GameController host_controller;
+    GameController editor_controller;
+    host_controller.configure_board_size(rows, cols);
+    CollaborationSession host_session(&host_controller);
+    CollaborationSession editor_session(&editor_controller);
+    QString error;
+    if (!host_session.host(0, QHostAddress::LocalHost, &error)) {
+        std::printf("  %-26s %s\n", "loopback", qPrintable(error));
+        return 1;
+    }
+
+    auto wait_until = [](const std::function<bool()>& done) {
+        QElapsedTimer timeout;
+        timeout.start();
+        while (!done() && timeout.elapsed() < 5000) {
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents, 10);
+        }
+        return done();
+    };
+
+    editor_session.join("127.0.0.1", host_session.get_port());
+    bool synced = wait_until([&editor_controller]() { return editor_controller.get_board()->get_rows() == rows; });
+
+    const int round_trips = 200;
+    double worst_ms = 0.0;
+    double total_ms = 0.0;
+    for (int i = 0; i < round_trips && synced; ++i) {
+        size_t row = pick_row(rng);
+        size_t col = pick_col(rng);
+        std::string text = "Live " + std::to_string(i);
+        QElapsedTimer latency;
+        latency.start();
+        host_controller.set_question_answer(row, col, text, "Answer");
+        synced = wait_until([&]() { return editor_controller.get_board()->get_cell(row, col).get_question() == text; });
+        double ms = latency.nsecsElapsed() / 1e6;
+        worst_ms = std::max(worst_ms, ms);
+        total_ms += ms;
+    }
+    std::printf("  %-26s %9.3f ms average, %.3f ms worst\n", "loopback edit to board", total_ms / round_trips, worst_ms);
+    std::printf("  %-26s %9.3f ms\n", "last remote apply", editor_session.get_last_apply_ns() / 1e6);
+    return converged && synced ? 0 : 1;
+}
+
+int benchmark_game_start() {
+    int argc = 1;
+    char name[] = "jpdy";
+    char* argv[] = {name, nullptr};
+    QCoreApplication app(argc, argv);
+    const size_t rows = 100;
+    const size_t cols = 100;
+    const size_t team_count = 20;
+    GameController controller;
+    controller.configure_board_size(rows, cols);
+    {
+        board_batch batch(&controller);
+        for (size_t row = 0; row < rows; ++row) {
+            for (size_t col = 0; col < cols; ++col) {
+                // Repeated answers are common in real banks and are interned once
+                controller.set_question_answer(row, col, "Question " + std::to_string(row * cols + col),
+                                               "Answer " + std::to_string(col % 10));
+            }
+        }
+    }
+    for (size_t i = controller.get_teams().size(); i < team_count; ++i) {
+        controller.add_team("Team " + std::to_string(i + 1));
+    }
+    // Stands in for an autosave snapshot; the game must not force a copy of it
+    board snapshot = *controller.get_board();
+
+    auto started = std::chrono::steady_clock::now();
+    controller.start_game_mode();
+    double start_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    const play_board* play = controller.get_play_board();
+
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<size_t> pick_row(0, rows - 1);
+    std::uniform_int_distribution<size_t> pick_col(0, cols - 1);
+    const size_t clicks = 5000;
+    size_t accepted = 0;
+    started = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < clicks; ++i) {
+        size_t row = pick_row(rng);
+        size_t col = pick_col(rng);
+        if (!controller.select_cell(row, col)) continue;
+        ++accepted;
+        // One wrong answer, then a steal that gets it right
+        controller.mark_current_team_attempted(row, col);
+        controller.switch_to_next_available_team(row, col);
+        controller.can_current_team_attempt(row, col);
+        controller.complete_question(row, col);
+    }
+    double click_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count() /
+                      std::max<size_t>(accepted, 1);
+
+    std::printf("game-start (%zux%zu board, %zu teams)\n", rows, cols, team_count);
+    std::printf("  %-26s %10.2f ms\n", "compile play board", start_ms);
+    std::printf("  %-26s %10zu of %zu\n", "interned texts", play->interned_text_count(), rows * cols * 3 + cols);
+    std::printf("  %-26s %10zu bytes\n", "play board memory", play->memory().bytes);
+    std::printf("  %-26s %10.2f us\n", "per clue played", click_us);
+    std::printf("  %-26s %s\n", "editable board untouched", snapshot.shares_data_with(*controller.get_board()) ? "yes" : "NO");
+    return snapshot.shares_data_with(*controller.get_board()) ? 0 : 1;
+}
+
+int benchmark_snapshot_reads() {
+    int argc = 1;
+    char name[] = "jpdy";
+    char* argv[] = {name, nullptr};
+    QCoreApplication app(argc, argv);
+    const size_t rows = 100;
+    const size_t cols = 100;
+    const size_t team_count = GameState::MAX_TEAMS;
+    GameController controller;
+    controller.configure_board_size(rows, cols);
+    for (size_t i = controller.get_teams().size(); i < team_count; ++i) {
+        controller.add_team("Team " + std::to_string(i + 1));
+    }
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<size_t> pick_row(0, rows - 1);
+    std::uniform_int_distribution<size_t> pick_col(0, cols - 1);
+
+    // Board edits while configuring: one published version per edit
+    const size_t edits = 5000;
+    auto started = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < edits; ++i) {
+        controller.set_question_answer(pick_row(rng), pick_col(rng), "Question " + std::to_string(i), "Answer");
+    }
+    double edit_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count() / edits;
+    std::shared_ptr<const game_snapshot> before = controller.get_snapshot();
+    controller.set_question_answer(0, 0, "One more", "Answer");
+    std::shared_ptr<const game_snapshot> after = controller.get_snapshot();
+    size_t shared_chunks_after_edit = after->cells.chunks_shared_with(before->cells);
+
+    // For comparison, what building every version from scratch would cost
+    started = std::chrono::steady_clock::now();
+    const size_t full_copies = 50;
+    for (size_t i = 0; i < full_copies; ++i) {
+        snapshot_publisher fresh;
+        fresh.load_board(*controller.get_board());
+        fresh.load_teams(controller.get_teams());
+        fresh.publish();
+    }
+    double full_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count() / full_copies;
+
+    // Readers check every version they see against its own running total while
+    // the owning thread keeps scoring; a torn read would break the sum
+    controller.start_game_mode();
+    std::atomic<bool> done{false};
+    std::atomic<size_t> reads{0};
+    std::atomic<size_t> torn{0};
+    unsigned reader_count = std::max(2u, std::thread::hardware_concurrency()) - 1;
+    std::vector<std::thread> readers;
+    for (unsigned i = 0; i < reader_count; ++i) {
+        readers.emplace_back([&controller, &done, &reads, &torn]() {
+            size_t local_reads = 0;
+            uint64_t last_version = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                std::shared_ptr<const game_snapshot> snapshot = controller.get_snapshot();
+                int64_t sum = 0;
+                for (size_t team = 0; team < snapshot->teams.size(); ++team) {
+                    sum += snapshot->teams[team].score;
+                }
+                if (sum != snapshot->total_score || snapshot->version < last_version) {
+                    torn.fetch_add(1, std::memory_order_relaxed);
+                }
+                last_version = snapshot->version;
+                ++local_reads;
+            }
+            reads.fetch_add(local_reads, std::memory_order_relaxed);
+        });
+    }
+
+    const size_t score_changes = 200000;
+    started = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < score_changes; ++i) {
+        controller.add_to_score(100);
+        controller.switch_to_next_team();
+    }
+    double writer_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    done = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    std::printf("snapshot-reads (%zux%zu board, %zu teams, %u reader threads)\n", rows, cols, team_count, reader_count);
+    std::printf("  %-30s %10.2f us\n", "board edit + publish", edit_us);
+    std::printf("  %-30s %10.2f us\n", "full rebuild, for comparison", full_us);
+    std::printf("  %-30s %10zu of %zu\n", "cell chunks shared after edit", shared_chunks_after_edit, after->cells.chunk_count());
+    std::printf("  %-30s %10.2f us\n", "score + turn, two publishes", writer_s * 1e6 / score_changes);
+    std::printf("  %-30s %10.0f per second\n", "snapshot reads", reads.load() / writer_s);
+    std::printf("  %-30s %10zu\n", "inconsistent reads", torn.load());
+    return torn.load() == 0 ? 0 : 1;
+}
+
+// One request on a keep-alive connection; returns the status code, or 0 if the response never came
+int http_exchange(QTcpSocket& socket, const QByteArray& request, QByteArray* etag = nullptr) {
+    socket.write(request);
+    QByteArray response;
+    qsizetype header_end = -1;
+    while ((header_end = response.indexOf("\r\n\r\n")) < 0) {
+        if (!socket.waitForReadyRead(15000)) return 0;
+        response += socket.readAll();
+    }
+    qsizetype length = 0;
+    for (const QByteArray& line : response.left(header_end).split('\n')) {
+        QByteArray lower = line.trimmed().toLower();
+        if (lower.startsWith("content-length:")) {
+            length = lower.mid(15).trimmed().toLongLong();
+        } else if (etag && lower.startsWith("etag:")) {
+            *etag = line.trimmed().mid(5).trimmed();
+        }
+    }
+    while (response.size() < header_end + 4 + length) {
+        if (!socket.waitForReadyRead(15000)) return 0;
+        response += socket.readAll();
+    }
+    return response.mid(9, 3).toInt();
+}
+
+int benchmark_scoreboard_http() {
+    int argc = 1;
+    char name[] = "jpdy";
+    char* argv[] = {name, nullptr};
+    QCoreApplication app(argc, argv);
+    const size_t team_count = 100;
+    GameController controller;
+    controller.configure_board_size(10, 10);
+    for (size_t i = controller.get_teams().size(); i < team_count; ++i) {
+        controller.add_team("Team " + std::to_string(i + 1));
+    }
+    controller.start_game_mode();
+    ScoreboardServer server(&controller);
+    QString error;
+    if (!server.start(0, &error)) {
+        std::printf("scoreboard-http: %s\n", qPrintable(error));
+        return 1;
+    }
+    const quint16 port = server.get_port();
+    std::printf("scoreboard-http (%zu teams, 10x10 board, port %u)\n", team_count, port);
+
+    // Clients hammer the server while this thread keeps scoring like a live game
+    auto load = [&controller, port](const char* label, bool conditional) {
+        const int clients = 8;
+        const auto duration = std::chrono::milliseconds(1000);
+        std::atomic<size_t> completed{0};
+        std::atomic<size_t> failed{0};
+        std::vector<QThread*> threads;
+        auto started = std::chrono::steady_clock::now();
+        for (int i = 0; i < clients; ++i) {
+            threads.push_back(QThread::create([&, conditional]() {
+                QTcpSocket socket;
+                socket.connectToHost(QHostAddress::LocalHost, port);
+                if (!socket.waitForConnected(5000)) {
+                    ++failed;
+                    return;
+                }
+                QByteArray etag;
+                size_t local = 0;
+                while (std::chrono::steady_clock::now() - started < duration) {
+                    QByteArray request = "GET /state HTTP/1.1\r\nHost: localhost\r\n";
+                    if (conditional && !etag.isEmpty()) request += "If-None-Match: " + etag + "\r\n";
+                    int status = http_exchange(socket, request + "\r\n", &etag);
+                    if (status != 200 && status != 304) {
+                        ++failed;
+                        return;
+                    }
+                    ++local;
+                }
+                completed += local;
+            }));
+            threads.back()->start();
+        }
+        size_t changes = 0;
+        while (std::chrono::steady_clock::now() - started < duration) {
+            controller.add_to_score(100);
+            controller.switch_to_next_team();
+            ++changes;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        for (QThread* thread : threads) {
+            thread->wait();
+            delete thread;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        std::printf("  %-28s %10.0f requests/s (%zu state changes, %zu failed)\n", label, completed / seconds, changes,
+                    failed.load());
+        return failed.load() == 0;
+    };
+    bool ok = load("full responses", false);
+    ok = load("If-None-Match", true) && ok;
+
+    // Long poll: time from a score change until the parked request answers
+    const int polls = 50;
+    double total_ms = 0.0;
+    double worst_ms = 0.0;
+    for (int i = 0; i < polls && ok; ++i) {
+        std::atomic<bool> parked{false};
+        std::chrono::steady_clock::time_point changed_at;
+        std::chrono::steady_clock::time_point answered_at;
+        int status = 0;
+        QThread* poller = QThread::create([&]() {
+            QTcpSocket socket;
+            socket.connectToHost(QHostAddress::LocalHost, port);
+            if (!socket.waitForConnected(5000)) return;
+            QByteArray etag;
+            http_exchange(socket, "GET /teams HTTP/1.1\r\nHost: localhost\r\n\r\n", &etag);
+            parked = true;
+            status = http_exchange(socket, "GET /teams?wait=10 HTTP/1.1\r\nHost: localhost\r\nIf-None-Match: " + etag +
+                                           "\r\n\r\n");
+            answered_at = std::chrono::steady_clock::now();
+        });
+        poller->start();
+        while (!parked && !poller->isFinished()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        // Give the second request time to reach the server and park
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        changed_at = std::chrono::steady_clock::now();
+        controller.add_to_score(100);
+        poller->wait();
+        delete poller;
+        if (status != 200) {
+            ok = false;
+            break;
+        }
+        double ms = std::chrono::duration<double, std::milli>(answered_at - changed_at).count();
+        total_ms += ms;
+        worst_ms = std::max(worst_ms, ms);
+    }
+    std::printf("  %-28s %10.3f ms average, %.3f ms worst\n", "long-poll wakeup", total_ms / polls, worst_ms);
+    std::printf("  %-28s %10llu\n", "requests served", static_cast<unsigned long long>(server.get_requests_served()));
+    return ok ? 0 : 1;
+}
+
+
+int benchmark_logging() {
+    QTemporaryDir directory;
+    log_settings settings;
+    settings.path = QDir(directory.path()).filePath("bench.log").toStdString();
+    settings.max_file_bytes = 256 * 1024;
+    settings.kept_files = 2;
+    settings.stderr_level = LogLevel::CRITICAL;
+    logger::start(settings);
+
+    const int filtered_calls = 10000000;
+    auto started = std::chrono::steady_clock::now();
+    for (int i = 0; i < filtered_calls; ++i) {
+        LOG_VERBOSE(LogCategory::ANIMATION, "frame {} took {} ms", i, 0.5);
+    }
+    double filtered_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count() /
+                         filtered_calls;
+
+    // Bursts that fit the per-thread buffer, with pauses the flusher drains in, like real warnings
+    const unsigned threads = std::max(2u, std::thread::hardware_concurrency());
+    const int bursts = 20;
+    const int burst_size = static_cast<int>(logger::RECORDS_PER_THREAD / 2);
+    std::atomic<int64_t> logged_ns{0};
+    std::vector<std::thread> writers;
+    for (unsigned t = 0; t < threads; ++t) {
+        writers.emplace_back([t, &logged_ns, burst_size]() {
+            std::string path = "/boards/round-" + std::to_string(t) + ".jpdy";
+            int64_t spent = 0;
+            for (int burst = 0; burst < bursts; ++burst) {
+                auto burst_started = std::chrono::steady_clock::now();
+                for (int i = 0; i < burst_size; ++i) {
+                    LOG_WARNING(LogCategory::STORAGE, "Autosave to {} failed: {} (attempt {})", path, "disk full", i);
+                }
+                spent += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - burst_started).count();
+                std::this_thread::sleep_for(std::chrono::milliseconds(logger::FLUSH_INTERVAL_MS * 2));
+            }
+            logged_ns += spent;
+        });
+    }
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    const double records = static_cast<double>(threads) * bursts * burst_size;
+    double logged_per_call_ns = logged_ns.load() / records;
+    logger::stop();
+
+    // What each message used to cost: formatted and written on the calling thread
+    std::string sync_path = QDir(directory.path()).filePath("sync.log").toStdString();
+    std::FILE* sync_file = std::fopen(sync_path.c_str(), "w");
+    const int sync_calls = 20000;
+    started = std::chrono::steady_clock::now();
+    for (int i = 0; i < sync_calls && sync_file; ++i) {
+        std::fprintf(sync_file, "Autosave to %s failed: %s (attempt %d)\n", "/boards/round-0.jpdy", "disk full", i);
+        std::fflush(sync_file);
+    }
+    double sync_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count() / sync_calls;
+    if (sync_file) std::fclose(sync_file);
+
+    size_t lines = 0;
+    for (const char* suffix : {"", ".1", ".2"}) {
+        QFile file(QString::fromStdString(settings.path + suffix));
+        if (file.open(QIODevice::ReadOnly)) {
+            lines += static_cast<size_t>(file.readAll().count('\n'));
+        }
+    }
+
+    std::printf("logging (%u threads, %d records each)\n", threads, bursts * burst_size);
+    std::printf("  %-26s %10.2f ns\n", "filtered out", filtered_ns);
+    std::printf("  %-26s %10.2f ns\n", "logged (deferred)", logged_per_call_ns);
+    std::printf("  %-26s %10.2f ns\n", "synchronous fprintf+flush", sync_ns);
+    std::printf("  %-26s %10llu\n", "dropped", static_cast<unsigned long long>(logger::dropped_count()));
+    std::printf("  %-26s %10zu (rotated at %zu KiB, %d kept)\n", "lines on disk", lines, settings.max_file_bytes / 1024,
+                settings.kept_files);
+    return logger::dropped_count() == 0 ? 0 : 1;
+}
+
+int benchmark_clue_open() {
+    // Text layout needs a platform plugin; offscreen keeps the benchmark windowless
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    int argc = 1;
+    char name[] = "jpdy";
+    char* argv[] = {name, nullptr};
+    QApplication app(argc, argv);
+
+    static const char* const words[] = {"This", "river", "empties", "into", "the", "Gulf", "of", "Mexico", "after",
+                                        "crossing", "ten", "states", "and", "its", "delta", "is", "home", "to",
+                                        "famous", "jazz", "city", "whose", "nickname", "means", "Big", "Easy"};
+    const size_t clues = 300;
+    std::mt19937 rng(29);
+    std::uniform_int_distribution<size_t> word_count(12, 60);
+    std::uniform_int_distribution<size_t> pick_word(0, std::size(words) - 1);
+    std::vector<QString> texts;
+    for (size_t i = 0; i < clues; ++i) {
+        QStringList clue;
+        for (size_t w = word_count(rng); w > 0; --w) {
+            clue << words[pick_word(rng)];
+        }
+        texts.push_back(clue.join(' '));
+    }
+
+    // Both widgets get the dialog's clue box: its font, border, padding and size
+    const QSize box(540, 160);
+    QTextEdit editor;
+    editor.setReadOnly(true);
+    editor.setFont(QuestionDialog::clue_font());
+    editor.setStyleSheet("QTextEdit { border: 3px solid #0f3460; padding: 15px; }");
+    editor.resize(box);
+    ClueTextView view;
+    view.setFont(QuestionDialog::clue_font());
+    view.setStyleSheet("ClueTextView { border: 3px solid #0f3460; padding: 15px; }");
+    view.resize(box);
+    QImage frame(box, QImage::Format_ARGB32_Premultiplied);
+    // The first render delivers the pending resizes, so both viewports have their real width
+    editor.render(&frame);
+    view.render(&frame);
+
+    // Stands in for the cache's worker threads; not part of the time to open
+    std::vector<std::unique_ptr<QTextDocument>> prepared;
+    auto started = std::chrono::steady_clock::now();
+    for (const QString& text : texts) {
+        prepared.push_back(ClueTextView::build_document(text, QuestionDialog::clue_font(), view.text_width()));
+    }
+    double prepare_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+    // Each open sets the clue and paints the first frame the audience sees
+    auto time_opens = [&frame, clues](QWidget& widget, const std::function<void(size_t)>& open, double* worst_ms) {
+        double total_ms = 0;
+        *worst_ms = 0;
+        for (size_t i = 0; i < clues; ++i) {
+            auto opened = std::chrono::steady_clock::now();
+            open(i);
+            widget.render(&frame);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - opened).count();
+            total_ms += ms;
+            *worst_ms = std::max(*worst_ms, ms);
+        }
+        return total_ms / static_cast<double>(clues);
+    };
+    double set_text_worst = 0;
+    double set_text_ms = time_opens(editor, [&editor, &texts](size_t i) { editor.setText(texts[i]); }, &set_text_worst);
+    double adopt_worst = 0;
+    double adopt_ms = time_opens(view, [&view, &prepared](size_t i) { view.set_document(std::move(prepared[i])); },
+                                 &adopt_worst);
+    bool kept_layout = view.relayout_count() == 0;
+
+    std::printf("clue-open (%zu clues of 12-60 words, %dpx wide)\n", clues, view.text_width());
+    std::printf("  %-26s %9.3f ms average, %.3f ms worst\n", "QTextEdit::setText", set_text_ms, set_text_worst);
+    std::printf("  %-26s %9.3f ms average, %.3f ms worst\n", "prepared document", adopt_ms, adopt_worst);
+    std::printf("  %-26s %9.2f ms for all clues\n", "preparing (off GUI thread)", prepare_ms);
+    std::printf("  %-26s %s\n", "prepared layouts kept", kept_layout ? "yes" : "NO");
+    return kept_layout ? 0 : 1;
+}
+
+}
+
+int benchmarks::run(const std::string& name) {
+    if (name == "win-probability") {
+        return benchmark_win_probability();
+    }
+    if (name == "batch-edits") {
+        return benchmark_batch_edits();
+    }
+    if (name == "incremental-save") {
+        return benchmark_incremental_save();
+    }
+    if (name == "rank-index") {
+        return benchmark_rank_index();
+    }
+    if (name == "crdt-merge") {
+        return benchmark_crdt_merge();
+    }
+    if (name == "game-start") {
+        return benchmark_game_start();
+    }
+    if (name == "snapshot-reads") {
+        return benchmark_snapshot_reads();
+    }
+    if (name == "scoreboard-http") {
+        return benchmark_scoreboard_http();
+    }
+    if (name == "logging") {
+        return benchmark_logging();
+    }
+    if (name == "clue-open") {
+        return benchmark_clue_open();
+    }
+    std::fprintf(stderr, "Unknown benchmark '%s'. Available: win-probability, batch-edits, incremental-save, rank-index, crdt-merge, game-start, snapshot-reads, scoreboard-http, logging, clue-open\n",
+                 name.c_str());
+    return 2;
+}
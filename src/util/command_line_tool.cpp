@@ -0,0 +1,197 @@
+#include "util/command_line_tool.h"
+#include "model/board_analysis.h"
+#include "model/game_state.h"
+#include "storage/board_file.h"
+#include <QFileInfo>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct file_result {
+    std::string output;
+    bool ok = true;
+};
+
+using file_job = std::function<file_result(const QString& path)>;
+
+std::string format_position(const cell_position& position) {
+    return "(" + std::to_string(position.first + 1) + ", " + std::to_string(position.second + 1) + ")";
+}
+
+std::string format_positions(const std::vector<cell_position>& positions) {
+    std::string text;
+    for (const cell_position& position : positions) {
+        if (!text.empty()) text += " ";
+        text += format_position(position);
+    }
+    return text;
+}
+
+// Reads a board and loads it into a fresh GameState, the same path the GUI takes
+std::unique_ptr<GameState> load_game(const QString& path, file_result& result) {
+    QString error;
+    std::optional<board> loaded = board_file::read(path, &error);
+    if (!loaded) {
+        result.ok = false;
+        result.output = path.toStdString() + ": error: " + error.toStdString() + "\n";
+        return nullptr;
+    }
+    auto state = std::make_unique<GameState>(loaded->get_rows(), loaded->get_cols());
+    state->load_board(*loaded);
+    return state;
+}
+
+file_result validate_file(const QString& path) {
+    file_result result;
+    std::unique_ptr<GameState> state = load_game(path, result);
+    if (!state) return result;
+    
+    board_analysis analysis = board_analysis::analyze(*state->get_board());
+    std::string name = path.toStdString();
+    if (!analysis.empty_cells.empty()) {
+        result.output += name + ": " + std::to_string(analysis.empty_cells.size()) + " empty cells: " +
+                         format_positions(analysis.empty_cells) + "\n";
+    }
+    if (!analysis.missing_answers.empty()) {
+        result.output += name + ": " + std::to_string(analysis.missing_answers.size()) + " questions without answers: " +
+                         format_positions(analysis.missing_answers) + "\n";
+    }
+    for (const auto& duplicates : analysis.duplicate_questions) {
+        result.output += name + ": duplicate question at " + format_positions(duplicates) + "\n";
+    }
+    result.ok = !analysis.has_problems();
+    if (result.ok) {
+        result.output = name + ": ok\n";
+    }
+    return result;
+}
+
+file_result stats_file(const QString& path) {
+    file_result result;
+    std::unique_ptr<GameState> state = load_game(path, result);
+    if (!state) return result;
+    
+    const board& game_board = *state->get_board();
+    board_analysis analysis = board_analysis::analyze(game_board);
+    size_t cells = game_board.get_rows() * game_board.get_cols();
+    
+    char line[256];
+    std::snprintf(line, sizeof(line), "%s: %zux%zu, %zu cells, %zu complete, %zu empty, %zu without answer, "
+                  "%zu duplicate groups, %zu with media, %d points\n",
+                  path.toStdString().c_str(), game_board.get_rows(), game_board.get_cols(), cells,
+                  cells - analysis.empty_cells.size() - analysis.missing_answers.size(),
+                  analysis.empty_cells.size(), analysis.missing_answers.size(),
+                  analysis.duplicate_questions.size(), analysis.media_cells, analysis.total_points);
+    result.output = line;
+    for (size_t col = 0; col < game_board.get_cols(); ++col) {
+        std::snprintf(line, sizeof(line), "  %-32s %8d points\n", game_board.get_category(col).c_str(),
+                      analysis.column_points[col]);
+        result.output += line;
+    }
+    return result;
+}
+
+file_result convert_file(const QString& input, const QString& output) {
+    file_result result;
+    std::unique_ptr<GameState> state = load_game(input, result);
+    if (!state) return result;
+    
+    QString error;
+    if (!board_file::write(output, *state->get_board(), &error)) {
+        result.ok = false;
+        result.output = output.toStdString() + ": error: " + error.toStdString() + "\n";
+        return result;
+    }
+    result.output = input.toStdString() + " -> " + output.toStdString() + "\n";
+    return result;
+}
+
+// Runs job over every path on a small thread pool and prints results in argument order
+int process_files(const std::vector<QString>& paths, const file_job& job) {
+    auto started = std::chrono::steady_clock::now();
+    std::vector<file_result> results(paths.size());
+    std::atomic<size_t> next{0};
+    
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < paths.size(); i = next.fetch_add(1)) {
+            results[i] = job(paths[i]);
+        }
+    };
+    size_t thread_count = std::min<size_t>(paths.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> helpers;
+    for (size_t i = 1; i < thread_count; ++i) {
+        helpers.emplace_back(worker);
+    }
+    worker();
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+    
+    size_t failures = 0;
+    for (const file_result& result : results) {
+        std::fputs(result.output.c_str(), stdout);
+        failures += result.ok ? 0 : 1;
+    }
+    double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    std::fprintf(stderr, "%zu files, %zu with problems, %.1f ms on %zu threads\n", paths.size(), failures,
+                 elapsed_ms, thread_count);
+    return failures == 0 ? 0 : 1;
+}
+
+int usage() {
+    std::fputs("Usage:\n"
+               "  jpdy validate FILE...             report empty cells, missing answers and duplicate questions\n"
+               "  jpdy stats FILE...                print size, completeness and point totals\n"
+               "  jpdy convert INPUT OUTPUT         convert between .jpdy and .json by file suffix\n"
+               "  jpdy convert --to jpdy|json FILE...  convert each file next to itself\n",
+               stderr);
+    return 2;
+}
+
+}
+
+bool command_line_tool::handles(const std::string& command) {
+    return command == "validate" || command == "stats" || command == "convert";
+}
+
+int command_line_tool::run(int argc, char* argv[]) {
+    if (argc < 3) {
+        return usage();
+    }
+    const std::string command = argv[1];
+    std::vector<QString> arguments;
+    for (int i = 2; i < argc; ++i) {
+        arguments.push_back(QString::fromLocal8Bit(argv[i]));
+    }
+    
+    if (command == "validate") {
+        return process_files(arguments, validate_file);
+    }
+    if (command == "stats") {
+        return process_files(arguments, stats_file);
+    }
+    
+    if (arguments.front() == "--to") {
+        if (arguments.size() < 3 || (arguments[1] != "jpdy" && arguments[1] != "json")) {
+            return usage();
+        }
+        const QString suffix = arguments[1];
+        std::vector<QString> inputs(arguments.begin() + 2, arguments.end());
+        return process_files(inputs, [&suffix](const QString& input) {
+            QFileInfo info(input);
+            return convert_file(input, info.path() + "/" + info.completeBaseName() + "." + suffix);
+        });
+    }
+    if (arguments.size() != 2) {
+        return usage();
+    }
+    const QString output = arguments[1];
+    return process_files({arguments[0]}, [&output](const QString& input) { return convert_file(input, output); });
+}
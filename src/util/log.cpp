@@ -0,0 +1,393 @@
+#include "util/log.h"
+#include "util/trace.h"
+#include <cctype>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Single producer (the owning thread), single consumer (whoever holds drain_mutex)
+struct record_ring {
+    std::vector<log_record> records;
+    std::atomic<uint64_t> head{0};  // Next slot the owner writes
+    std::atomic<uint64_t> tail{0};  // Next slot the flusher reads
+    std::atomic<uint64_t> dropped{0};
+    uint64_t dropped_reported = 0;  // Flusher only
+
+    record_ring() : records(logger::RECORDS_PER_THREAD) {}
+};
+
+std::mutex registry_mutex;
+std::vector<std::shared_ptr<record_ring>>& registry() {
+    static std::vector<std::shared_ptr<record_ring>> rings;
+    return rings;
+}
+
+record_ring& local_ring() {
+    thread_local record_ring* ring = [] {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        registry().push_back(std::make_shared<record_ring>());
+        return registry().back().get();
+    }();
+    return *ring;
+}
+
+class rotating_file {
+public:
+    bool open(const log_settings& settings) {
+        close();
+        path = settings.path;
+        max_bytes = settings.max_file_bytes;
+        kept_files = settings.kept_files;
+        if (path.empty()) return true;
+        std::error_code ignored;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ignored);
+        file = std::fopen(path.c_str(), "ab");
+        if (!file) return false;
+        written = static_cast<size_t>(std::ftell(file));
+        return true;
+    }
+
+    void write(const std::string& line) {
+        if (!file) return;
+        if (written > 0 && written + line.size() > max_bytes) {
+            rotate();
+            if (!file) return;
+        }
+        std::fwrite(line.data(), 1, line.size(), file);
+        written += line.size();
+    }
+
+    void flush() {
+        if (file) std::fflush(file);
+    }
+
+    void close() {
+        if (file) std::fclose(file);
+        file = nullptr;
+    }
+
+private:
+    std::string path;
+    size_t max_bytes = 0;
+    int kept_files = 0;
+    std::FILE* file = nullptr;
+    size_t written = 0;
+
+    void rotate() {
+        close();
+        std::error_code ignored;
+        if (kept_files <= 0) {
+            std::filesystem::remove(path, ignored);
+        } else {
+            std::filesystem::remove(path + "." + std::to_string(kept_files), ignored);
+            for (int i = kept_files - 1; i >= 1; --i) {
+                std::filesystem::rename(path + "." + std::to_string(i), path + "." + std::to_string(i + 1), ignored);
+            }
+            std::filesystem::rename(path, path + ".1", ignored);
+        }
+        file = std::fopen(path.c_str(), "wb");
+        written = 0;
+    }
+};
+
+struct flusher_state {
+    std::mutex drain_mutex;  // Held while draining; never taken by a logging thread
+    rotating_file file;
+    LogLevel stderr_level = LogLevel::WARNING;
+    int64_t wall_offset_ns = 0;  // Wall clock minus tracer::now_ns(), for timestamps
+
+    std::mutex control_mutex;  // Serializes start and stop
+    std::thread thread;
+    std::atomic<bool> stopping{false};
+    // Set while the flusher waits for work; the first record after that wakes it
+    std::atomic<bool> idle{false};
+    std::atomic<uint32_t> wake{0};
+
+    // Builds the registry first so it is destroyed after us and the last drain can still reach it
+    flusher_state() { registry(); }
+    // A missing stop() still gets its final flush instead of std::terminate
+    ~flusher_state() {
+        if (thread.joinable()) {
+            stopping = true;
+            idle = false;
+            wake.fetch_add(1);
+            wake.notify_one();
+            thread.join();
+        }
+    }
+};
+
+flusher_state& state() {
+    static flusher_state instance;
+    return instance;
+}
+
+void append_argument(std::string& out, const log_record& record, size_t index) {
+    char number[32];
+    const log_record::arg_value& value = record.values[index];
+    switch (record.kinds[index]) {
+        case log_record::arg_kind::SIGNED:
+            std::snprintf(number, sizeof(number), "%" PRId64, value.signed_value);
+            out += number;
+            break;
+        case log_record::arg_kind::UNSIGNED:
+            std::snprintf(number, sizeof(number), "%" PRIu64, value.unsigned_value);
+            out += number;
+            break;
+        case log_record::arg_kind::REAL:
+            std::snprintf(number, sizeof(number), "%g", value.real_value);
+            out += number;
+            break;
+        case log_record::arg_kind::TEXT:
+            out.append(record.text + value.text.offset, value.text.length);
+            break;
+    }
+}
+
+void format_record(const log_record& record, int64_t wall_offset_ns, std::string& out) {
+    int64_t wall_ns = static_cast<int64_t>(record.timestamp_ns) + wall_offset_ns;
+    std::time_t seconds = static_cast<std::time_t>(wall_ns / 1000000000);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+    char stamp[48];
+    size_t length = std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+    std::snprintf(stamp + length, sizeof(stamp) - length, ".%03d", static_cast<int>((wall_ns / 1000000) % 1000));
+
+    out.clear();
+    out += stamp;
+    out += ' ';
+    out += logger::level_name(record.level);
+    out += ' ';
+    out += logger::category_name(record.category);
+    out += ": ";
+    size_t next_arg = 0;
+    for (const char* c = record.format; *c; ++c) {
+        if (c[0] == '{' && c[1] == '}' && next_arg < record.arg_count) {
+            append_argument(out, record, next_arg++);
+            ++c;
+        } else {
+            out += *c;
+        }
+    }
+    out += '\n';
+}
+
+// Formats and writes every committed record; returns how many there were
+size_t drain() {
+    flusher_state& flusher = state();
+    std::lock_guard<std::mutex> drain_lock(flusher.drain_mutex);
+    std::vector<std::shared_ptr<record_ring>> rings;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        rings = registry();
+    }
+
+    TRACE_SCOPE("logger::drain");
+    size_t drained = 0;
+    std::string line;
+    for (const auto& ring : rings) {
+        uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        for (; tail < head; ++tail) {
+            const log_record& record = ring->records[tail % logger::RECORDS_PER_THREAD];
+            format_record(record, flusher.wall_offset_ns, line);
+            flusher.file.write(line);
+            if (record.level >= flusher.stderr_level) {
+                std::fputs(line.c_str(), stderr);
+            }
+            ++drained;
+        }
+        // Hands the slots back to the owner
+        ring->tail.store(tail, std::memory_order_release);
+
+        uint64_t dropped = ring->dropped.load(std::memory_order_relaxed);
+        if (dropped != ring->dropped_reported) {
+            line = "logger: " + std::to_string(dropped - ring->dropped_reported) + " messages dropped, buffer full\n";
+            flusher.file.write(line);
+            std::fputs(line.c_str(), stderr);
+            ring->dropped_reported = dropped;
+        }
+    }
+    if (drained > 0) {
+        flusher.file.flush();
+    }
+    return drained;
+}
+
+bool has_pending() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (const auto& ring : registry()) {
+        if (ring->head.load(std::memory_order_seq_cst) != ring->tail.load(std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void flusher_main() {
+    tracer::set_thread_name("log flusher");
+    flusher_state& flusher = state();
+    while (true) {
+        uint32_t seen = flusher.wake.load(std::memory_order_acquire);
+        size_t drained = drain();
+        if (flusher.stopping.load()) {
+            drain();
+            return;
+        }
+        if (drained > 0) {
+            // More tends to follow; let it gather rather than waking per record
+            std::this_thread::sleep_for(std::chrono::milliseconds(logger::FLUSH_INTERVAL_MS));
+            continue;
+        }
+        flusher.idle.store(true, std::memory_order_seq_cst);
+        // A record committed before idle was visible would never wake us, so look once more
+        if (has_pending()) {
+            flusher.idle.store(false, std::memory_order_relaxed);
+            continue;
+        }
+        flusher.wake.wait(seen, std::memory_order_acquire);
+    }
+}
+
+void wake_flusher() {
+    flusher_state& flusher = state();
+    flusher.idle.store(false, std::memory_order_relaxed);
+    flusher.wake.fetch_add(1, std::memory_order_release);
+    flusher.wake.notify_one();
+}
+
+}
+
+bool logger::start(const log_settings& settings) {
+    flusher_state& flusher = state();
+    std::lock_guard<std::mutex> control_lock(flusher.control_mutex);
+    if (flusher.thread.joinable()) {
+        flusher.stopping = true;
+        wake_flusher();
+        flusher.thread.join();
+    }
+
+    bool opened;
+    {
+        std::lock_guard<std::mutex> drain_lock(flusher.drain_mutex);
+        opened = flusher.file.open(settings);
+        flusher.stderr_level = settings.stderr_level;
+        auto wall = std::chrono::system_clock::now().time_since_epoch();
+        flusher.wall_offset_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(wall).count() -
+                                 static_cast<int64_t>(tracer::now_ns());
+    }
+    flusher.stopping = false;
+    flusher.idle = false;
+    flusher.thread = std::thread(flusher_main);
+    return opened;
+}
+
+void logger::stop() {
+    flusher_state& flusher = state();
+    std::lock_guard<std::mutex> control_lock(flusher.control_mutex);
+    if (flusher.thread.joinable()) {
+        flusher.stopping = true;
+        wake_flusher();
+        flusher.thread.join();
+    }
+    std::lock_guard<std::mutex> drain_lock(flusher.drain_mutex);
+    flusher.file.close();
+}
+
+void logger::flush() {
+    drain();
+}
+
+void logger::set_min_level(LogLevel level) {
+    uint32_t current = filter.load(std::memory_order_relaxed);
+    uint32_t updated;
+    do {
+        updated = (current & 0xffffu) | (static_cast<uint32_t>(level) << LEVEL_SHIFT);
+    } while (!filter.compare_exchange_weak(current, updated, std::memory_order_relaxed));
+}
+
+void logger::set_category_enabled(LogCategory category, bool enabled) {
+    uint32_t bit = 1u << static_cast<uint32_t>(category);
+    if (enabled) {
+        filter.fetch_or(bit, std::memory_order_relaxed);
+    } else {
+        filter.fetch_and(~bit, std::memory_order_relaxed);
+    }
+}
+
+uint64_t logger::dropped_count() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    uint64_t total = 0;
+    for (const auto& ring : registry()) {
+        total += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+const char* logger::level_name(LogLevel level) {
+    switch (level) {
+        case LogLevel::VERBOSE: return "verbose";
+        case LogLevel::INFO: return "info";
+        case LogLevel::WARNING: return "warning";
+        case LogLevel::CRITICAL: return "critical";
+    }
+    return "unknown";
+}
+
+const char* logger::category_name(LogCategory category) {
+    switch (category) {
+        case LogCategory::GENERAL: return "general";
+        case LogCategory::ANIMATION: return "animation";
+        case LogCategory::STORAGE: return "storage";
+        case LogCategory::NETWORK: return "network";
+        case LogCategory::COUNT: break;
+    }
+    return "unknown";
+}
+
+bool logger::parse_level(std::string_view name, LogLevel& level) {
+    for (LogLevel candidate : {LogLevel::VERBOSE, LogLevel::INFO, LogLevel::WARNING, LogLevel::CRITICAL}) {
+        std::string_view candidate_name = level_name(candidate);
+        if (name.size() == candidate_name.size() &&
+            std::equal(name.begin(), name.end(), candidate_name.begin(),
+                       [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; })) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+log_record* logger::begin_record() {
+    record_ring& ring = local_ring();
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) >= RECORDS_PER_THREAD) {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    log_record* record = &ring.records[head % RECORDS_PER_THREAD];
+    record->timestamp_ns = tracer::now_ns();
+    return record;
+}
+
+void logger::commit_record() {
+    record_ring& ring = local_ring();
+    // Sequentially consistent so the flusher's idle check and this publish cannot both miss
+    ring.head.store(ring.head.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+    flusher_state& flusher = state();
+    if (flusher.idle.load(std::memory_order_seq_cst) && flusher.idle.exchange(false)) {
+        wake_flusher();
+    }
+}
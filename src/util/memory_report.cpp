@@ -0,0 +1,47 @@
+#include "util/memory_report.h"
+#include <cstdio>
+
+namespace {
+
+std::string format_bytes(size_t bytes) {
+    char text[32];
+    if (bytes >= 1024 * 1024) {
+        std::snprintf(text, sizeof(text), "%.1f MiB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+    } else if (bytes >= 1024) {
+        std::snprintf(text, sizeof(text), "%.1f KiB", static_cast<double>(bytes) / 1024.0);
+    } else {
+        std::snprintf(text, sizeof(text), "%zu B", bytes);
+    }
+    return text;
+}
+
+}
+
+void memory_report::add(const std::string& subsystem, const memory_usage& usage) {
+    rows.push_back({subsystem, usage.objects, usage.bytes});
+}
+
+void memory_report::add_count(const std::string& subsystem, size_t objects) {
+    rows.push_back({subsystem, objects, std::nullopt});
+}
+
+size_t memory_report::measured_bytes() const {
+    size_t total = 0;
+    for (const entry& row : rows) {
+        total += row.bytes.value_or(0);
+    }
+    return total;
+}
+
+std::string memory_report::to_text() const {
+    std::string text = "Memory report:\n";
+    char line[160];
+    for (const entry& row : rows) {
+        std::string bytes = row.bytes ? format_bytes(*row.bytes) : std::string("-");
+        std::snprintf(line, sizeof(line), "  %-28s %10zu objects %12s\n", row.subsystem.c_str(), row.objects, bytes.c_str());
+        text += line;
+    }
+    std::snprintf(line, sizeof(line), "  %-28s %31s\n", "total measured", format_bytes(measured_bytes()).c_str());
+    text += line;
+    return text;
+}
@@ -0,0 +1,39 @@
+#include "util/startup_timer.h"
+#include "util/trace.h"
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+const auto process_start = std::chrono::steady_clock::now();
+
+std::vector<std::pair<std::string, double>>& milestone_list() {
+    static std::vector<std::pair<std::string, double>> list;
+    return list;
+}
+
+}
+
+void startup_timer::mark(const std::string& milestone) {
+    TRACE_INSTANT("startup_timer::mark");
+    milestone_list().emplace_back(milestone, elapsed_ms());
+}
+
+double startup_timer::elapsed_ms() {
+    auto elapsed = std::chrono::steady_clock::now() - process_start;
+    return std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+const std::vector<std::pair<std::string, double>>& startup_timer::milestones() {
+    return milestone_list();
+}
+
+std::string startup_timer::report() {
+    std::string text = "Startup timing (ms since process start):\n";
+    char line[128];
+    for (const auto& [milestone, ms] : milestone_list()) {
+        std::snprintf(line, sizeof(line), "  %8.2f  %s\n", ms, milestone.c_str());
+        text += line;
+    }
+    return text;
+}
@@ -0,0 +1,178 @@
+#include "util/trace.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct trace_event {
+    const char* name;
+    uint64_t start_ns;
+    uint64_t end_ns;
+    bool instant;
+};
+
+// Fields are atomic so the exporter may read a slot while its owner rewrites it;
+// a torn copy is detected afterwards from head and thrown away
+struct trace_slot {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> start_ns{0};
+    std::atomic<uint64_t> end_ns{0};
+    std::atomic<bool> instant{false};
+};
+
+// Written only by its owning thread; the registry keeps it alive after the thread exits
+struct thread_buffer {
+    uint32_t thread_id;
+    std::string thread_name;  // Guarded by registry_mutex
+    std::vector<trace_slot> events;
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> cleared_head{0};  // Events before this index were cleared
+
+    explicit thread_buffer(uint32_t id) : thread_id(id), events(tracer::EVENTS_PER_THREAD) {}
+};
+
+std::mutex registry_mutex;
+std::vector<std::shared_ptr<thread_buffer>>& registry() {
+    static std::vector<std::shared_ptr<thread_buffer>> buffers;
+    return buffers;
+}
+
+thread_buffer& local_buffer() {
+    thread_local thread_buffer* buffer = [] {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        auto& buffers = registry();
+        buffers.push_back(std::make_shared<thread_buffer>(static_cast<uint32_t>(buffers.size() + 1)));
+        return buffers.back().get();
+    }();
+    return *buffer;
+}
+
+void push_event(const trace_event& event) {
+    thread_buffer& buffer = local_buffer();
+    uint64_t index = buffer.head.load(std::memory_order_relaxed);
+    // Orders the previous head store before this slot's stores; pairs with the exporter's acquire fence
+    std::atomic_thread_fence(std::memory_order_release);
+    trace_slot& slot = buffer.events[index % tracer::EVENTS_PER_THREAD];
+    slot.name.store(event.name, std::memory_order_relaxed);
+    slot.start_ns.store(event.start_ns, std::memory_order_relaxed);
+    slot.end_ns.store(event.end_ns, std::memory_order_relaxed);
+    slot.instant.store(event.instant, std::memory_order_relaxed);
+    buffer.head.store(index + 1, std::memory_order_release);
+}
+
+void write_json_string(std::ofstream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) >= 0x20) {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+}
+
+uint64_t tracer::now_ns() {
+    static const auto epoch = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::steady_clock::now() - epoch;
+    // Offset by one so a recorded timestamp is never zero
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) + 1;
+}
+
+void tracer::record_span(const char* name, uint64_t start_ns, uint64_t end_ns) {
+    push_event({name, start_ns, end_ns, false});
+}
+
+void tracer::record_instant(const char* name) {
+    uint64_t now = now_ns();
+    push_event({name, now, now, true});
+}
+
+void tracer::set_thread_name(const std::string& name) {
+    thread_buffer& buffer = local_buffer();
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    buffer.thread_name = name;
+}
+
+bool tracer::export_chrome_trace(const std::string& path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+
+    std::vector<std::pair<std::shared_ptr<thread_buffer>, std::string>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for (const auto& buffer : registry()) {
+            buffers.emplace_back(buffer, buffer->thread_name);
+        }
+    }
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&out, &first]() {
+        if (!first) out << ",\n";
+        first = false;
+    };
+
+    std::vector<trace_event> events;
+    for (const auto& [buffer, thread_name] : buffers) {
+        if (!thread_name.empty()) {
+            separator();
+            out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->thread_id
+                << ",\"args\":{\"name\":";
+            write_json_string(out, thread_name);
+            out << "}}";
+        }
+
+        // Copy without stopping the owner, then keep only the slots it cannot have
+        // started overwriting meanwhile: the one at the newest head may be in progress
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t first_index = std::max(buffer->cleared_head.load(std::memory_order_acquire),
+                                        head - std::min<uint64_t>(head, EVENTS_PER_THREAD));
+        events.clear();
+        for (uint64_t i = first_index; i < head; ++i) {
+            const trace_slot& slot = buffer->events[i % EVENTS_PER_THREAD];
+            events.push_back({slot.name.load(std::memory_order_relaxed), slot.start_ns.load(std::memory_order_relaxed),
+                              slot.end_ns.load(std::memory_order_relaxed), slot.instant.load(std::memory_order_relaxed)});
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t head_after = buffer->head.load(std::memory_order_relaxed);
+        uint64_t intact_from = head_after >= EVENTS_PER_THREAD ? head_after - EVENTS_PER_THREAD + 1 : 0;
+        for (uint64_t i = std::max(first_index, intact_from); i < head; ++i) {
+            const trace_event& event = events[i - first_index];
+            separator();
+            out << "{\"name\":";
+            write_json_string(out, event.name ? event.name : "");
+            out << ",\"pid\":1,\"tid\":" << buffer->thread_id
+                << ",\"ts\":" << static_cast<double>(event.start_ns) / 1000.0;
+            if (event.instant) {
+                out << ",\"ph\":\"i\",\"s\":\"t\"}";
+            } else {
+                out << ",\"ph\":\"X\",\"dur\":" << static_cast<double>(event.end_ns - event.start_ns) / 1000.0 << "}";
+            }
+        }
+    }
+
+    out << "]}\n";
+    return static_cast<bool>(out);
+}
+
+void tracer::clear() {
+    // Only the owner writes head; clearing just moves the point exports start from
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (auto& buffer : registry()) {
+        buffer->cleared_head.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+}
@@ -0,0 +1,123 @@
+#include "view/animation_clock.h"
+#include <algorithm>
+#include "util/trace.h"
+
+AnimationClock::AnimationClock(QObject* parent)
+    : QObject(parent), frame_timer(this), next_id(1), last_tick_ms(0), ticking(false) {
+    frame_timer.setTimerType(Qt::PreciseTimer);
+    frame_timer.setInterval(FRAME_INTERVAL_MS);
+    connect(&frame_timer, &QTimer::timeout, this, &AnimationClock::tick);
+    clock.start();
+}
+
+AnimationClock::effect_id AnimationClock::start(QObject* target, int duration_ms, const QEasingCurve& curve,
+                                                step_function step, finish_function on_finished, int delay_ms) {
+    const qint64 now = clock.elapsed();
+    effect_id id = next_id++;
+    effects.push_back({id, target, now + std::max(delay_ms, 0), std::max(duration_ms, 1), curve,
+                       std::move(step), std::move(on_finished), false});
+    
+    // Apply the start value now, as QPropertyAnimation does, so nothing flashes for a frame
+    if (delay_ms <= 0 && target && effects.back().step) {
+        step_function first_step = effects.back().step;
+        first_step(effects.back().curve.valueForProgress(0.0));
+    }
+    
+    if (!frame_timer.isActive()) {
+        last_tick_ms = now;
+        frame_timer.start();
+    }
+    return id;
+}
+
+void AnimationClock::stop(effect_id id) {
+    for (auto& entry : effects) {
+        if (entry.id == id) {
+            entry.removed = true;
+        }
+    }
+    if (!ticking) {
+        compact();
+        stop_if_idle();
+    }
+}
+
+bool AnimationClock::is_running(effect_id id) const {
+    return std::any_of(effects.begin(), effects.end(),
+                       [id](const effect& entry) { return entry.id == id && !entry.removed; });
+}
+
+size_t AnimationClock::active_count() const {
+    return static_cast<size_t>(std::count_if(effects.begin(), effects.end(),
+                                             [](const effect& entry) { return !entry.removed; }));
+}
+
+void AnimationClock::tick() {
+    TRACE_SCOPE("AnimationClock::tick");
+    ticking = true;
+    QElapsedTimer cost;
+    cost.start();
+    
+    const qint64 now = clock.elapsed();
+    const double interval = static_cast<double>(now - last_tick_ms);
+    last_tick_ms = now;
+    if (interval > FRAME_INTERVAL_MS * 1.5) {
+        ++stats.late_frames;
+        TRACE_INSTANT("AnimationClock::late_frame");
+    }
+    stats.worst_interval_ms = std::max(stats.worst_interval_ms, interval);
+    
+    // Callbacks may start or stop effects; new ones are appended and picked up next frame
+    std::vector<finish_function> finished;
+    const size_t count = effects.size();
+    for (size_t i = 0; i < count; ++i) {
+        effect& entry = effects[i];
+        if (entry.removed) continue;
+        if (!entry.target) {
+            entry.removed = true;
+            continue;
+        }
+        if (now < entry.start_ms) continue;
+        
+        double progress = std::min(1.0, static_cast<double>(now - entry.start_ms) / entry.duration_ms);
+        if (entry.step) {
+            // Copy first: the step may append to effects and reallocate it
+            step_function step = entry.step;
+            step(entry.curve.valueForProgress(progress));
+        }
+        effect& current = effects[i];
+        if (progress >= 1.0 && !current.removed) {
+            current.removed = true;
+            if (current.on_finished) {
+                finished.push_back(std::move(current.on_finished));
+            }
+        }
+    }
+    compact();
+    ticking = false;
+    
+    for (auto& on_finished : finished) {
+        on_finished();
+    }
+    
+    double cost_ms = static_cast<double>(cost.nsecsElapsed()) / 1e6;
+    ++stats.frames;
+    stats.last_cost_ms = cost_ms;
+    stats.total_cost_ms += cost_ms;
+    stats.worst_cost_ms = std::max(stats.worst_cost_ms, cost_ms);
+    
+    stop_if_idle();
+}
+
+void AnimationClock::stop_if_idle() {
+    if (effects.empty() && frame_timer.isActive()) {
+        frame_timer.stop();
+        TRACE_INSTANT("AnimationClock::idle");
+        emit idle();
+    }
+}
+
+void AnimationClock::compact() {
+    effects.erase(std::remove_if(effects.begin(), effects.end(), [](const effect& entry) { return entry.removed; }),
+                  effects.end());
+}
@@ -1,12 +1,12 @@
 #include "view/animation_manager.h"
 #include <QEasingCurve>
 #include <QRect>
-#include <QDebug>
+#include <algorithm>
+#include "util/trace.h"
 
-AnimationManager::AnimationManager(QWidget* parent_widget, QObject* parent)
-    : QObject(parent), parent_widget(parent_widget), correct_sequence(nullptr), 
-      incorrect_sequence(nullptr), animation_feedback_label(nullptr), 
-      animation_completion_timer(nullptr), animation_in_progress(false) {
+AnimationManager::AnimationManager(QWidget* parent_widget, AnimationClock* clock, QObject* parent)
+    : QObject(parent), parent_widget(parent_widget), clock(clock), animation_feedback_label(nullptr),
+      feedback_opacity(nullptr), animation_in_progress(false) {
     setup_animations();
 }
 
@@ -15,57 +15,30 @@ AnimationManager::~AnimationManager() {
 }
 
 void AnimationManager::setup_animations() {
-    animation_completion_timer = new QTimer(this);
-    animation_completion_timer->setSingleShot(true);
     animation_feedback_label = new QLabel(parent_widget);
     animation_feedback_label->setAlignment(Qt::AlignCenter);
     animation_feedback_label->setStyleSheet(
         "QLabel { background-color: rgba(0, 0, 0, 0.7); color: white; "
         "font-size: 28px; font-weight: bold; border-radius: 10px; padding: 20px; }"
     );
+    feedback_opacity = new QGraphicsOpacityEffect(animation_feedback_label);
+    animation_feedback_label->setGraphicsEffect(feedback_opacity);
     animation_feedback_label->setVisible(false);
     animation_feedback_label->setGeometry(0, 0, parent_widget->width(), parent_widget->height());
     animation_in_progress = false;
-    correct_sequence = nullptr;
-    incorrect_sequence = nullptr;
 }
 
 void AnimationManager::cleanup_animations() {
-    if (correct_sequence) {
-        correct_sequence->stop();
-        correct_sequence->deleteLater();
-        correct_sequence = nullptr;
-    }
-    
-    if (incorrect_sequence) {
-        incorrect_sequence->stop();
-        incorrect_sequence->deleteLater();
-        incorrect_sequence = nullptr;
-    }
-    
-    if (animation_completion_timer) {
-        animation_completion_timer->stop();
-        animation_completion_timer->disconnect();
+    TRACE_SCOPE("AnimationManager::cleanup_animations");
+    for (AnimationClock::effect_id id : running_effects) {
+        clock->stop(id);
     }
+    running_effects.clear();
     
     cleanup_leftover_labels();
     
-    // Clean up any running property animations that might still be active
-    QList<QPropertyAnimation*> running_animations = parent_widget->findChildren<QPropertyAnimation*>();
-    for (QPropertyAnimation* anim : running_animations) {
-        if (anim->state() == QAbstractAnimation::Running) {
-            anim->stop();
-            anim->deleteLater();
-        }
-    }
-    
-    // Clean up any animation groups that might still be active
-    QList<QAnimationGroup*> running_groups = parent_widget->findChildren<QAnimationGroup*>();
-    for (QAnimationGroup* group : running_groups) {
-        if (group->state() == QAbstractAnimation::Running) {
-            group->stop();
-            group->deleteLater();
-        }
+    if (animation_feedback_label) {
+        animation_feedback_label->setVisible(false);
     }
     
     // Reset animation state
@@ -76,7 +49,6 @@ void AnimationManager::play_correct_animation(int points) {
     if (animation_in_progress) return;
     
     animation_in_progress = true;
-    setup_timeout_protection(true);
     create_correct_animation_sequence(points);
 }
 
@@ -84,211 +56,109 @@ void AnimationManager::play_incorrect_animation(int points) {
     if (animation_in_progress) return;
     
     animation_in_progress = true;
-    setup_timeout_protection(false);
     create_incorrect_animation_sequence(points);
 }
 
-void AnimationManager::create_correct_animation_sequence(int points) {
-    if (correct_sequence) {
-        correct_sequence->stop();
-        correct_sequence->deleteLater();
-    }
-    
-    correct_sequence = new QSequentialAnimationGroup(this);
-    
-    animation_feedback_label->setText("CORRECT!");
+void AnimationManager::show_feedback(const QString& text, const QString& background) {
+    animation_feedback_label->setText(text);
     animation_feedback_label->setStyleSheet(
-        "QLabel { background-color: rgba(76, 175, 80, 0.9); color: white; "
-        "font-size: 32px; font-weight: bold; border-radius: 15px; padding: 30px; }"
+        QString("QLabel { background-color: %1; color: white; "
+                "font-size: 32px; font-weight: bold; border-radius: 15px; padding: 30px; }").arg(background)
     );
     animation_feedback_label->setGeometry(50, 100, parent_widget->width() - 100, 120);
     animation_feedback_label->setVisible(true);
+}
+
+void AnimationManager::fade(QLabel* label, QGraphicsOpacityEffect* opacity, double from, double to,
+                            int duration_ms, int delay_ms) {
+    QEasingCurve curve(to > from ? QEasingCurve::OutQuad : QEasingCurve::InQuad);
+    running_effects.push_back(clock->start(label, duration_ms, curve, [opacity, from, to](double progress) {
+        opacity->setOpacity(from + (to - from) * progress);
+    }, {}, delay_ms));
+}
+
+void AnimationManager::create_overlay_animation(std::function<void()> on_finished) {
+    fade(animation_feedback_label, feedback_opacity, 0.0, 1.0, OVERLAY_FADE_DURATION);
     
-    // Create fade-in animation for overlay
-    QPropertyAnimation* overlay_fade_in = new QPropertyAnimation(animation_feedback_label, "windowOpacity");
-    overlay_fade_in->setDuration(OVERLAY_FADE_DURATION);
-    overlay_fade_in->setStartValue(0.0);
-    overlay_fade_in->setEndValue(1.0);
-    overlay_fade_in->setEasingCurve(QEasingCurve::OutQuad);
-    
-    // Create points animation
+    // The fade-out carries the completion so the sequence ends on the clock, not a watchdog timer
+    running_effects.push_back(clock->start(animation_feedback_label, OVERLAY_FADE_DURATION, QEasingCurve::InQuad,
+        [this](double progress) { feedback_opacity->setOpacity(1.0 - progress); },
+        std::move(on_finished), OVERLAY_FADE_DURATION));
+}
+
+void AnimationManager::create_correct_animation_sequence(int points) {
+    TRACE_SCOPE("AnimationManager::create_correct_animation_sequence");
+    show_feedback("CORRECT!", "rgba(76, 175, 80, 0.9)");
     create_points_animation(points);
-    
-    // Create fade-out animation for overlay
-    QPropertyAnimation* overlay_fade_out = new QPropertyAnimation(animation_feedback_label, "windowOpacity");
-    overlay_fade_out->setDuration(OVERLAY_FADE_DURATION);
-    overlay_fade_out->setStartValue(1.0);
-    overlay_fade_out->setEndValue(0.0);
-    overlay_fade_out->setEasingCurve(QEasingCurve::InQuad);
-    
-    // Add animations to sequence
-    correct_sequence->addAnimation(overlay_fade_in);
-    correct_sequence->addAnimation(overlay_fade_out);
-    
-    // Connect completion signal
-    connect(correct_sequence, &QSequentialAnimationGroup::finished, 
-            this, &AnimationManager::on_correct_sequence_finished);
-    
-    // Start the animation
-    correct_sequence->start();
+    create_overlay_animation([this]() { on_correct_sequence_finished(); });
 }
 
 void AnimationManager::create_incorrect_animation_sequence(int points) {
-    if (incorrect_sequence) {
-        incorrect_sequence->stop();
-        incorrect_sequence->deleteLater();
-    }
-    
-    incorrect_sequence = new QSequentialAnimationGroup(this);
-    
-    animation_feedback_label->setText("INCORRECT!");
-    animation_feedback_label->setStyleSheet(
-        "QLabel { background-color: rgba(244, 67, 54, 0.9); color: white; "
-        "font-size: 32px; font-weight: bold; border-radius: 15px; padding: 30px; }"
-    );
-    animation_feedback_label->setGeometry(50, 100, parent_widget->width() - 100, 120);
-    animation_feedback_label->setVisible(true);
-    
-    // Create fade-in animation for overlay
-    QPropertyAnimation* overlay_fade_in = new QPropertyAnimation(animation_feedback_label, "windowOpacity");
-    overlay_fade_in->setDuration(OVERLAY_FADE_DURATION);
-    overlay_fade_in->setStartValue(0.0);
-    overlay_fade_in->setEndValue(1.0);
-    overlay_fade_in->setEasingCurve(QEasingCurve::OutQuad);
-    
-    // Create shake animation for the dialog
+    TRACE_SCOPE("AnimationManager::create_incorrect_animation_sequence");
+    show_feedback("INCORRECT!", "rgba(244, 67, 54, 0.9)");
     create_shake_animation();
     
-    // Create points deduction animation
-    QLabel* deduction_label = new QLabel(parent_widget);
-    deduction_label->setStyleSheet(
-        "QLabel { color: #f44336; font-size: 36px; font-weight: bold; "
-        "background-color: rgba(0, 0, 0, 0.8); border-radius: 10px; padding: 15px; }"
-    );
-    deduction_label->setAlignment(Qt::AlignCenter);
-    deduction_label->setGeometry(parent_widget->width() / 2 - 100, parent_widget->height() / 2 + 50, 200, 100);
-    deduction_label->setText(QString("-$%1").arg(points));
-    deduction_label->setVisible(true);
-    
-    // Create fade-out animation for overlay
-    QPropertyAnimation* overlay_fade_out = new QPropertyAnimation(animation_feedback_label, "windowOpacity");
-    overlay_fade_out->setDuration(OVERLAY_FADE_DURATION);
-    overlay_fade_out->setStartValue(1.0);
-    overlay_fade_out->setEndValue(0.0);
-    overlay_fade_out->setEasingCurve(QEasingCurve::InQuad);
-    
-    // Add animations to sequence
-    incorrect_sequence->addAnimation(overlay_fade_in);
-    incorrect_sequence->addAnimation(overlay_fade_out);
-    
-    // Clean up the deduction label when animation finishes
-    connect(incorrect_sequence, &QSequentialAnimationGroup::finished, [deduction_label]() {
+    QLabel* deduction_label = create_points_label(QString("-$%1").arg(points), "#f44336",
+                                                  parent_widget->height() / 2 + 50);
+    create_overlay_animation([this, deduction_label]() {
         deduction_label->deleteLater();
+        on_incorrect_sequence_finished();
     });
-    
-    // Connect completion signal
-    connect(incorrect_sequence, &QSequentialAnimationGroup::finished, 
-            this, &AnimationManager::on_incorrect_sequence_finished);
-    
-    // Start the animation
-    incorrect_sequence->start();
 }
 
-void AnimationManager::create_points_animation(int points) {
-    QLabel* points_animation_label = new QLabel(parent_widget);
-    points_animation_label->setObjectName("points_animation_label");
-    points_animation_label->setStyleSheet(
-        "QLabel { color: #4caf50; font-size: 36px; font-weight: bold; "
-        "background-color: rgba(0, 0, 0, 0.8); border-radius: 10px; padding: 15px; }"
+QLabel* AnimationManager::create_points_label(const QString& text, const QString& color, int top) {
+    QLabel* label = new QLabel(parent_widget);
+    label->setObjectName("points_animation_label");
+    label->setStyleSheet(
+        QString("QLabel { color: %1; font-size: 36px; font-weight: bold; "
+                "background-color: rgba(0, 0, 0, 0.8); border-radius: 10px; padding: 15px; }").arg(color)
     );
-    points_animation_label->setAlignment(Qt::AlignCenter);
-    points_animation_label->setGeometry(parent_widget->width() / 2 - 100, parent_widget->height() / 2 - 50, 200, 100);
-    points_animation_label->setText(QString("+$%1").arg(points));
-    points_animation_label->setVisible(true);
-    
-    // Create animations for the points
-    QPropertyAnimation* points_fade_in = new QPropertyAnimation(points_animation_label, "windowOpacity");
-    points_fade_in->setDuration(POINTS_COUNT_DURATION / 3);
-    points_fade_in->setStartValue(0.0);
-    points_fade_in->setEndValue(1.0);
-    points_fade_in->setEasingCurve(QEasingCurve::OutQuad);
-    
-    QPropertyAnimation* points_move = new QPropertyAnimation(points_animation_label, "geometry");
-    points_move->setDuration(POINTS_COUNT_DURATION);
-    points_move->setStartValue(points_animation_label->geometry());
-    QRect final_rect = points_animation_label->geometry();
-    final_rect.moveTop(final_rect.top() - 50);
-    points_move->setEndValue(final_rect);
-    points_move->setEasingCurve(QEasingCurve::OutQuad);
-    
-    QPropertyAnimation* points_fade_out = new QPropertyAnimation(points_animation_label, "windowOpacity");
-    points_fade_out->setDuration(POINTS_COUNT_DURATION / 3);
-    points_fade_out->setStartValue(1.0);
-    points_fade_out->setEndValue(0.0);
-    points_fade_out->setEasingCurve(QEasingCurve::InQuad);
-    
-    QParallelAnimationGroup* points_group = new QParallelAnimationGroup(this);
-    points_group->addAnimation(points_fade_in);
-    points_group->addAnimation(points_move);
-    points_group->addAnimation(points_fade_out);
-    
-    // Clean up the temporary label when animation finishes
-    connect(points_group, &QParallelAnimationGroup::finished, [points_animation_label, points_group]() {
-        points_animation_label->hide();
-        points_animation_label->deleteLater();
-        points_group->deleteLater();
-    });
-    
-    points_group->start();
+    label->setAlignment(Qt::AlignCenter);
+    label->setGeometry(parent_widget->width() / 2 - 100, top, 200, 100);
+    label->setText(text);
+    label->setVisible(true);
+    return label;
 }
 
-void AnimationManager::create_shake_animation() {
-    QRect original_geometry = parent_widget->geometry();
-    
-    QPropertyAnimation* shake_animation = new QPropertyAnimation(parent_widget, "geometry");
-    shake_animation->setDuration(SHAKE_DURATION);
-    shake_animation->setEasingCurve(QEasingCurve::InOutQuad);
-    
-    // Define shake positions
-    QRect shake_left = original_geometry;
-    shake_left.moveLeft(original_geometry.left() - 10);
-    
-    QRect shake_right = original_geometry;
-    shake_right.moveLeft(original_geometry.left() + 10);
-    
-    // Create keyframe values for shake effect
-    shake_animation->setKeyValueAt(0.0, original_geometry);
-    shake_animation->setKeyValueAt(0.1, shake_left);
-    shake_animation->setKeyValueAt(0.2, shake_right);
-    shake_animation->setKeyValueAt(0.3, shake_left);
-    shake_animation->setKeyValueAt(0.4, shake_right);
-    shake_animation->setKeyValueAt(0.5, shake_left);
-    shake_animation->setKeyValueAt(0.6, shake_right);
-    shake_animation->setKeyValueAt(0.7, shake_left);
-    shake_animation->setKeyValueAt(0.8, shake_right);
-    shake_animation->setKeyValueAt(0.9, shake_left);
-    shake_animation->setKeyValueAt(1.0, original_geometry);
-    
-    shake_animation->start();
-    
-    connect(shake_animation, &QPropertyAnimation::finished, [shake_animation]() {
-        shake_animation->deleteLater();
-    });
+void AnimationManager::create_points_animation(int points) {
+    QLabel* points_animation_label = create_points_label(QString("+$%1").arg(points), "#4caf50",
+                                                         parent_widget->height() / 2 - 50);
+    QGraphicsOpacityEffect* opacity = new QGraphicsOpacityEffect(points_animation_label);
+    points_animation_label->setGraphicsEffect(opacity);
+    
+    // Rise for the whole duration, fading in over the first third and out over the last
+    const int fade_duration = POINTS_COUNT_DURATION / 3;
+    fade(points_animation_label, opacity, 0.0, 1.0, fade_duration);
+    fade(points_animation_label, opacity, 1.0, 0.0, fade_duration, POINTS_COUNT_DURATION - fade_duration);
+    
+    const QRect start_rect = points_animation_label->geometry();
+    running_effects.push_back(clock->start(points_animation_label, POINTS_COUNT_DURATION, QEasingCurve::OutQuad,
+        [points_animation_label, start_rect](double progress) {
+            points_animation_label->move(start_rect.left(), start_rect.top() - static_cast<int>(50 * progress));
+        },
+        [points_animation_label]() {
+            points_animation_label->hide();
+            points_animation_label->deleteLater();
+        }));
 }
 
-void AnimationManager::setup_timeout_protection(bool is_correct) {
-    animation_completion_timer->stop();
-    animation_completion_timer->disconnect();
+void AnimationManager::create_shake_animation() {
+    const QPoint original_position = parent_widget->pos();
     
-    if (is_correct) {
-        connect(animation_completion_timer, &QTimer::timeout, 
-                this, &AnimationManager::on_correct_animation_timeout);
-        animation_completion_timer->start(TOTAL_CORRECT_DURATION + 500);
-    } else {
-        connect(animation_completion_timer, &QTimer::timeout, 
-                this, &AnimationManager::on_incorrect_animation_timeout);
-        animation_completion_timer->start(TOTAL_INCORRECT_DURATION + 500);
-    }
+    // Keyframes every tenth of the way: rest, then alternate 10px left and right, then rest
+    auto offset_at = [](int keyframe) {
+        if (keyframe <= 0 || keyframe >= 10) return 0;
+        return keyframe % 2 == 1 ? -10 : 10;
+    };
+    
+    running_effects.push_back(clock->start(parent_widget, SHAKE_DURATION, QEasingCurve::InOutQuad,
+        [this, original_position, offset_at](double progress) {
+            double position = progress * 10.0;
+            int keyframe = std::min(static_cast<int>(position), 9);
+            double fraction = position - keyframe;
+            double offset = offset_at(keyframe) + (offset_at(keyframe + 1) - offset_at(keyframe)) * fraction;
+            parent_widget->move(original_position.x() + static_cast<int>(offset), original_position.y());
+        }));
 }
 
 void AnimationManager::cleanup_leftover_labels() {
@@ -302,26 +172,10 @@ void AnimationManager::cleanup_leftover_labels() {
     }
 }
 
-void AnimationManager::on_correct_animation_timeout() {
-    if (animation_in_progress) {
-        qWarning("Correct animation timeout - forcing completion");
-        on_correct_sequence_finished();
-    }
-}
-
-void AnimationManager::on_incorrect_animation_timeout() {
-    if (animation_in_progress) {
-        qWarning("Incorrect animation timeout - forcing completion");
-        on_incorrect_sequence_finished();
-    }
-}
-
 void AnimationManager::on_correct_sequence_finished() {
+    TRACE_INSTANT("AnimationManager::correct_sequence_finished");
     animation_in_progress = false;
-    
-    if (animation_completion_timer) {
-        animation_completion_timer->stop();
-    }
+    std::erase_if(running_effects, [this](AnimationClock::effect_id id) { return !clock->is_running(id); });
     
     if (animation_feedback_label) {
         animation_feedback_label->setVisible(false);
@@ -331,11 +185,9 @@ void AnimationManager::on_correct_sequence_finished() {
 }
 
 void AnimationManager::on_incorrect_sequence_finished() {
+    TRACE_INSTANT("AnimationManager::incorrect_sequence_finished");
     animation_in_progress = false;
-    
-    if (animation_completion_timer) {
-        animation_completion_timer->stop();
-    }
+    std::erase_if(running_effects, [this](AnimationClock::effect_id id) { return !clock->is_running(id); });
     
     if (animation_feedback_label) {
         animation_feedback_label->setVisible(false);
@@ -0,0 +1,95 @@
+#include "view/board_render_cache.h"
+#include <QPainter>
+#include <QTextOption>
+#include "util/trace.h"
+
+BoardRenderCache::BoardRenderCache(QObject* parent)
+    : QObject(parent), renders(0), requests(0) {
+    tiles.setMaxCost(TILE_BUDGET_BYTES);
+    layouts.setMaxCost(LAYOUT_CAPACITY);
+}
+
+QFont BoardRenderCache::font_for(TextRole role) {
+    QFont font;
+    if (role == TextRole::CATEGORY) {
+        font.setPixelSize(16);
+        font.setBold(true);
+    } else {
+        font.setPixelSize(11);
+    }
+    return font;
+}
+
+QPixmap BoardRenderCache::tile(int points, TileState state, const QSize& size, qreal device_pixel_ratio) {
+    ++requests;
+    QString key = QString("%1/%2/%3x%4@%5").arg(points).arg(static_cast<int>(state))
+                      .arg(size.width()).arg(size.height()).arg(device_pixel_ratio);
+    if (QPixmap* cached = tiles.object(key)) {
+        return *cached;
+    }
+    
+    QPixmap rendered = render_tile(points, state, size, device_pixel_ratio);
+    ++renders;
+    qint64 cost = static_cast<qint64>(rendered.width()) * rendered.height() * rendered.depth() / 8;
+    tiles.insert(key, new QPixmap(rendered), cost);
+    return rendered;
+}
+
+QPixmap BoardRenderCache::render_tile(int points, TileState state, const QSize& size, qreal device_pixel_ratio) {
+    TRACE_SCOPE("BoardRenderCache::render_tile");
+    QPixmap pixmap(size * device_pixel_ratio);
+    pixmap.setDevicePixelRatio(device_pixel_ratio);
+    pixmap.fill(Qt::transparent);
+    
+    QColor fill("#16213e");
+    QColor border("#0f3460");
+    QColor text_color("#ffd700");
+    QString label = QString("$%1").arg(points);
+    int font_size = 18;
+    if (state == TileState::HOVERED) {
+        fill = QColor("#0f3460");
+    } else if (state == TileState::USED) {
+        fill = QColor("#333");
+        border = QColor("#555");
+        text_color = QColor("#666");
+        label = "USED";
+        font_size = 14;
+    }
+    
+    QPainter painter(&pixmap);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QPen(border, 3));
+    painter.setBrush(fill);
+    painter.drawRoundedRect(QRectF(1.5, 1.5, size.width() - 3, size.height() - 3), CORNER_RADIUS, CORNER_RADIUS);
+    
+    QFont font;
+    font.setPixelSize(font_size);
+    font.setBold(true);
+    painter.setFont(font);
+    painter.setPen(text_color);
+    painter.drawText(QRect(QPoint(0, 0), size), Qt::AlignCenter, label);
+    return pixmap;
+}
+
+QStaticText BoardRenderCache::text_layout(const QString& text, TextRole role, int width) {
+    QString key = QString("%1/%2/").arg(static_cast<int>(role)).arg(width) + text;
+    if (QStaticText* cached = layouts.object(key)) {
+        return *cached;
+    }
+    
+    TRACE_SCOPE("BoardRenderCache::text_layout");
+    QStaticText layout(text);
+    layout.setTextFormat(Qt::PlainText);
+    layout.setTextWidth(width);
+    QTextOption option;
+    option.setAlignment(role == TextRole::CATEGORY ? Qt::AlignCenter : Qt::AlignLeft);
+    option.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
+    layout.setTextOption(option);
+    layout.prepare(QTransform(), font_for(role));
+    layouts.insert(key, new QStaticText(layout), 1);
+    return layout;
+}
+
+QColor BoardRenderCache::team_color(size_t team_index) {
+    return QColor::fromHsv(static_cast<int>((team_index * 67) % 360), 200, 255);
+}
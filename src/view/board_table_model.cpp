@@ -0,0 +1,120 @@
+#include "view/board_table_model.h"
+#include "util/trace.h"
+#include <algorithm>
+
+BoardTableModel::BoardTableModel(GameController* controller, QObject* parent)
+    : QAbstractTableModel(parent), game_controller(controller), shown_rows(0), shown_cols(0) {
+    if (const board* board = game_controller->get_board()) {
+        shown_rows = static_cast<int>(board->get_rows());
+        shown_cols = static_cast<int>(board->get_cols());
+    }
+    
+    connect(game_controller, &GameController::board_changes_committed, this, &BoardTableModel::on_board_changes_committed);
+}
+
+int BoardTableModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : shown_rows;
+}
+
+int BoardTableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : shown_cols;
+}
+
+QVariant BoardTableModel::data(const QModelIndex& index, int role) const {
+    const board* board = game_controller->get_board();
+    if (!board || !index.isValid()) return QVariant();
+    
+    size_t row = static_cast<size_t>(index.row());
+    size_t col = static_cast<size_t>(index.column());
+    if (!board->is_valid_position(row, col)) return QVariant();
+    
+    const cell& game_cell = board->get_cell(row, col);
+    switch (role) {
+        case Qt::DisplayRole:
+        case Qt::ToolTipRole:
+        case QuestionRole:
+            return game_cell.get_question_text().qstr();
+        case AnswerRole:
+            return game_cell.get_answer_text().qstr();
+        case MediaPathRole:
+            return game_cell.get_media_path_text().qstr();
+        case PointsRole:
+            return board->get_cell_points(row);
+        case ContentStateRole:
+            return static_cast<int>(game_cell.get_content_state());
+        default:
+            return QVariant();
+    }
+}
+
+QVariant BoardTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    const board* board = game_controller->get_board();
+    if (!board || section < 0) return QVariant();
+    
+    if (orientation == Qt::Horizontal && section < shown_cols) {
+        if (role == Qt::DisplayRole) {
+            const shared_text& category = board->get_category_text(static_cast<size_t>(section));
+            return category.empty() ? QString("Category %1").arg(section + 1) : category.qstr();
+        }
+        if (role == Qt::EditRole) {
+            return board->get_category_text(static_cast<size_t>(section)).qstr();
+        }
+    } else if (orientation == Qt::Vertical && section < shown_rows && role == Qt::DisplayRole) {
+        return QString("$%1").arg(board->get_cell_points(static_cast<size_t>(section)));
+    }
+    return QVariant();
+}
+
+bool BoardTableModel::setHeaderData(int section, Qt::Orientation orientation, const QVariant& value, int role) {
+    if (orientation != Qt::Horizontal || role != Qt::EditRole || section < 0 || section >= shown_cols) {
+        return false;
+    }
+    // headerDataChanged follows from the controller's change set
+    game_controller->set_category_name(static_cast<size_t>(section), value.toString());
+    return true;
+}
+
+Qt::ItemFlags BoardTableModel::flags(const QModelIndex& index) const {
+    if (!index.isValid()) return Qt::NoItemFlags;
+    // Cells are edited through CellEditDialog rather than an inline editor
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
+void BoardTableModel::on_board_changes_committed(const board_change_set& changes) {
+    TRACE_SCOPE("BoardTableModel::on_board_changes_committed");
+    if (changes.reset) {
+        beginResetModel();
+        const board* board = game_controller->get_board();
+        shown_rows = board ? static_cast<int>(board->get_rows()) : 0;
+        shown_cols = board ? static_cast<int>(board->get_cols()) : 0;
+        endResetModel();
+        return;
+    }
+    
+    // One notification per batch, covering the bounding range of what changed
+    if (!changes.categories.empty()) {
+        int first = static_cast<int>(*changes.categories.begin());
+        int last = std::min(static_cast<int>(*changes.categories.rbegin()), shown_cols - 1);
+        if (first <= last) {
+            emit headerDataChanged(Qt::Horizontal, first, last);
+        }
+    }
+    
+    if (!changes.cells.empty()) {
+        int top = shown_rows;
+        int left = shown_cols;
+        int bottom = -1;
+        int right = -1;
+        for (const auto& [row, col] : changes.cells) {
+            if (static_cast<int>(row) >= shown_rows || static_cast<int>(col) >= shown_cols) continue;
+            top = std::min(top, static_cast<int>(row));
+            bottom = std::max(bottom, static_cast<int>(row));
+            left = std::min(left, static_cast<int>(col));
+            right = std::max(right, static_cast<int>(col));
+        }
+        if (top <= bottom && left <= right) {
+            emit dataChanged(index(top, left), index(bottom, right),
+                             {Qt::DisplayRole, Qt::ToolTipRole, QuestionRole, AnswerRole, MediaPathRole, ContentStateRole});
+        }
+    }
+}
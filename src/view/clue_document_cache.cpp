@@ -0,0 +1,145 @@
+#include "view/clue_document_cache.h"
+#include <QMetaObject>
+#include <QThread>
+#include <algorithm>
+#include "view/clue_text_view.h"
+#include "util/trace.h"
+
+ClueDocumentCache::ClueDocumentCache(GameController* controller, const QFont& font, int text_width, QObject* parent)
+    : QObject(parent), game_controller(controller), document_font(font), document_text_width(text_width),
+      next_generation(1), hits(0), misses(0) {
+    layout_pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+
+    connect(game_controller, &GameController::mode_changed, this, &ClueDocumentCache::on_mode_changed);
+    connect(game_controller, &GameController::board_changes_committed,
+            this, &ClueDocumentCache::on_board_changes_committed);
+}
+
+ClueDocumentCache::~ClueDocumentCache() {
+    // Queued results for this object are dropped once it is destroyed
+    layout_pool.clear();
+    layout_pool.waitForDone();
+}
+
+quint64 ClueDocumentCache::cell_key(size_t row, size_t col) {
+    return (static_cast<quint64>(row) << 32) | static_cast<quint64>(col);
+}
+
+void ClueDocumentCache::set_text_width(int width) {
+    if (width <= 0 || width == document_text_width) return;
+
+    document_text_width = width;
+    prepared.clear();
+    pending_generations.clear();
+    if (game_controller->get_current_mode() == GameMode::PLAYING) {
+        prepare_unrevealed();
+    }
+}
+
+void ClueDocumentCache::prepare_unrevealed() {
+    TRACE_SCOPE("ClueDocumentCache::prepare_unrevealed");
+    const play_board* board = game_controller->get_play_board();
+    if (!board) return;
+
+    // Drop entries that fell outside the board after a resize
+    for (auto it = prepared.begin(); it != prepared.end();) {
+        size_t row = static_cast<size_t>(it->first >> 32);
+        size_t col = static_cast<size_t>(it->first & 0xffffffffu);
+        it = board->is_valid_position(row, col) ? std::next(it) : prepared.erase(it);
+    }
+
+    QThread* gui_thread = thread();
+    for (size_t row = 0; row < board->get_rows(); ++row) {
+        for (size_t col = 0; col < board->get_cols(); ++col) {
+            if (board->is_revealed(row, col)) continue;
+
+            quint64 key = cell_key(row, col);
+            const shared_text& question = board->get_question_text(row, col);
+            const shared_text& answer = board->get_answer_text(row, col);
+
+            auto existing = prepared.find(key);
+            if (existing != prepared.end() && existing->second.question_document && existing->second.answer_document &&
+                existing->second.question_text == question && existing->second.answer_text == answer) {
+                continue;
+            }
+
+            quint64 generation = next_generation++;
+            pending_generations[key] = generation;
+
+            // shared_text copies only bump a reference count, and the payload is immutable
+            layout_pool.start([this, key, generation, question, answer, font = document_font,
+                               text_width = document_text_width, gui_thread]() {
+                TRACE_SCOPE("ClueDocumentCache::layout");
+                auto clue = std::make_shared<prepared_clue>();
+                clue->question_text = question;
+                clue->answer_text = answer;
+                clue->question_document = ClueTextView::build_document(question.qstr(), font, text_width);
+                clue->answer_document = ClueTextView::build_document(answer.qstr(), font, text_width);
+                clue->question_document->moveToThread(gui_thread);
+                clue->answer_document->moveToThread(gui_thread);
+
+                QMetaObject::invokeMethod(this, [this, key, generation, clue]() {
+                    on_prepared(key, generation, clue);
+                }, Qt::QueuedConnection);
+            });
+        }
+    }
+}
+
+void ClueDocumentCache::on_prepared(quint64 key, quint64 generation, std::shared_ptr<prepared_clue> clue) {
+    auto pending = pending_generations.find(key);
+    if (pending == pending_generations.end() || pending->second != generation) {
+        return;  // Superseded by an edit, a width change or a newer preparation
+    }
+    pending_generations.erase(pending);
+    prepared[key] = std::move(*clue);
+}
+
+std::unique_ptr<QTextDocument> ClueDocumentCache::take(size_t row, size_t col, const shared_text& text, bool question) {
+    auto it = prepared.find(cell_key(row, col));
+    if (it != prepared.end()) {
+        prepared_clue& clue = it->second;
+        std::unique_ptr<QTextDocument>& document = question ? clue.question_document : clue.answer_document;
+        const shared_text& source = question ? clue.question_text : clue.answer_text;
+        if (document && source == text) {
+            ++hits;
+            std::unique_ptr<QTextDocument> result = std::move(document);
+            if (!clue.question_document && !clue.answer_document) {
+                prepared.erase(it);
+            }
+            return result;
+        }
+    }
+
+    ++misses;
+    TRACE_SCOPE("ClueDocumentCache::layout_on_miss");
+    return ClueTextView::build_document(text.qstr(), document_font, document_text_width);
+}
+
+std::unique_ptr<QTextDocument> ClueDocumentCache::take_question(size_t row, size_t col, const shared_text& text) {
+    return take(row, col, text, true);
+}
+
+std::unique_ptr<QTextDocument> ClueDocumentCache::take_answer(size_t row, size_t col, const shared_text& text) {
+    return take(row, col, text, false);
+}
+
+void ClueDocumentCache::on_mode_changed(GameMode new_mode) {
+    if (new_mode == GameMode::PLAYING) {
+        prepare_unrevealed();
+    }
+}
+
+void ClueDocumentCache::on_board_changes_committed(const board_change_set& changes) {
+    // Covers batched edits too, which skip the per-cell signal
+    if (changes.reset) {
+        prepared.clear();
+        pending_generations.clear();
+        return;
+    }
+    for (const auto& [row, col] : changes.cells) {
+        quint64 key = cell_key(row, col);
+        prepared.erase(key);
+        pending_generations.erase(key);
+    }
+}
@@ -0,0 +1,86 @@
+#include "view/clue_text_view.h"
+#include <QAbstractTextDocumentLayout>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QScrollBar>
+#include <algorithm>
+#include <cmath>
+#include "util/trace.h"
+
+ClueTextView::ClueTextView(QWidget* parent)
+    : QAbstractScrollArea(parent), relayouts(0) {
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    setFocusPolicy(Qt::NoFocus);
+}
+
+ClueTextView::~ClueTextView() = default;
+
+std::unique_ptr<QTextDocument> ClueTextView::build_document(const QString& text, const QFont& font, int text_width) {
+    auto document = std::make_unique<QTextDocument>();
+    document->setDefaultFont(font);
+    document->setTextWidth(text_width);
+    // Same detection QTextEdit::setText() does
+    if (Qt::mightBeRichText(text)) {
+        document->setHtml(text);
+    } else {
+        document->setPlainText(text);
+    }
+    // Asking for the size forces shaping and line layout now rather than at first paint
+    document->documentLayout()->documentSize();
+    return document;
+}
+
+int ClueTextView::text_width() const {
+    return viewport()->width();
+}
+
+void ClueTextView::set_document(std::unique_ptr<QTextDocument> document) {
+    current = std::move(document);
+    verticalScrollBar()->setValue(0);
+    // Until a layout first sizes the view its width means nothing; resizeEvent fits the document then
+    if (testAttribute(Qt::WA_Resized)) {
+        fit_width();
+    }
+    update_scroll_range();
+    viewport()->update();
+}
+
+void ClueTextView::fit_width() {
+    if (!current || current->textWidth() == text_width()) return;
+
+    TRACE_SCOPE("ClueTextView::relayout");
+    ++relayouts;
+    current->setTextWidth(text_width());
+    current->documentLayout()->documentSize();
+}
+
+void ClueTextView::update_scroll_range() {
+    int content_height = current ? static_cast<int>(std::ceil(current->size().height())) : 0;
+    verticalScrollBar()->setPageStep(viewport()->height());
+    verticalScrollBar()->setSingleStep(fontMetrics().height());
+    verticalScrollBar()->setRange(0, std::max(0, content_height - viewport()->height()));
+}
+
+void ClueTextView::resizeEvent(QResizeEvent* event) {
+    QAbstractScrollArea::resizeEvent(event);
+    fit_width();
+    update_scroll_range();
+    if (!verticalScrollBar()->isVisible()) {
+        emit text_width_changed(text_width());
+    }
+}
+
+void ClueTextView::paintEvent(QPaintEvent* event) {
+    if (!current) return;
+
+    QPainter painter(viewport());
+    int offset = verticalScrollBar()->value();
+    painter.translate(0, -offset);
+
+    QAbstractTextDocumentLayout::PaintContext context;
+    context.palette = palette();
+    context.palette.setColor(QPalette::Text, palette().color(foregroundRole()));
+    context.clip = QRectF(event->rect().translated(0, offset));
+    current->documentLayout()->draw(&painter, context);
+}
@@ -0,0 +1,55 @@
+#include "view/config_cell_delegate.h"
+#include <QPainter>
+#include "view/board_table_model.h"
+
+ConfigCellDelegate::ConfigCellDelegate(QObject* parent)
+    : QStyledItemDelegate(parent) {
+}
+
+void ConfigCellDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    auto state = static_cast<ContentState>(index.data(BoardTableModel::ContentStateRole).toInt());
+    
+    QColor fill("#16213e");
+    QColor border("#0f3460");
+    int border_width = 2;
+    if (state == ContentState::COMPLETE) {
+        fill = QColor("#1a4d1a");
+        border = QColor("#00ff00");
+        border_width = 3;
+    } else if (state == ContentState::QUESTION_ONLY) {
+        fill = QColor("#4d1a4d");
+        border = QColor("#8a2be2");
+        border_width = 3;
+    }
+    if (option.state & QStyle::State_MouseOver) {
+        fill = QColor("#0f3460");
+    }
+    
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setPen(QPen(border, border_width));
+    painter->setBrush(fill);
+    painter->drawRoundedRect(QRectF(option.rect).adjusted(3, 3, -3, -3), 5, 5);
+    
+    QFont font = option.font;
+    font.setBold(true);
+    painter->setFont(font);
+    painter->setPen(Qt::white);
+    
+    QRect text_rect = option.rect.adjusted(10, 8, -10, -8);
+    QString points = QString("$%1").arg(index.data(BoardTableModel::PointsRole).toInt());
+    if (!index.data(BoardTableModel::MediaPathRole).toString().isEmpty()) {
+        points += "  [media]";
+    }
+    painter->drawText(text_rect, Qt::AlignHCenter | Qt::AlignTop, points);
+    
+    QString question = index.data(BoardTableModel::QuestionRole).toString().simplified();
+    QString preview = question.isEmpty() ? QString("Edit") : question;
+    painter->drawText(text_rect, Qt::AlignHCenter | Qt::AlignBottom,
+                      painter->fontMetrics().elidedText(preview, Qt::ElideRight, text_rect.width()));
+    painter->restore();
+}
+
+QSize ConfigCellDelegate::sizeHint(const QStyleOptionViewItem&, const QModelIndex&) const {
+    return QSize(CELL_WIDTH, CELL_HEIGHT);
+}
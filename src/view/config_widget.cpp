@@ -1,32 +1,68 @@
 #include "view/config_widget.h"
 #include <QHeaderView>
 #include <QMessageBox>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QInputDialog>
+#include <algorithm>
+#include "view/board_table_model.h"
+#include "view/config_cell_delegate.h"
+#include "util/trace.h"
 
 ConfigWidget::ConfigWidget(GameController* controller, QWidget* parent)
-    : QWidget(parent), game_controller(controller) {
+    : QWidget(parent), game_controller(controller), config_table(nullptr), board_model(nullptr), cell_delegate(nullptr) {
     setup_ui();
     
-    connect(game_controller, &GameController::board_changed, this, &ConfigWidget::on_board_changed);
-    rebuild_config_grid();
+    connect(game_controller, &GameController::board_reset, this, &ConfigWidget::on_board_reset);
+    on_board_reset();
 }
 
 void ConfigWidget::setup_ui() {
     main_layout = new QVBoxLayout(this);
     
     create_size_controls();
-    
-    
-    config_scroll_area = new QScrollArea;
-    config_content_widget = new QWidget;
-    config_grid_layout = new QGridLayout(config_content_widget);
-    
-    config_scroll_area->setWidget(config_content_widget);
-    config_scroll_area->setWidgetResizable(true);
-    config_scroll_area->setStyleSheet(
-        "QScrollArea { border: 2px solid #16213e; background-color: #0f3460; }"
+    create_config_table();
+}
+
+void ConfigWidget::create_config_table() {
+    TRACE_SCOPE("ConfigWidget::create_config_table");
+    board_model = new BoardTableModel(game_controller, this);
+    cell_delegate = new ConfigCellDelegate(this);
+    
+    config_table = new QTableView;
+    config_table->setModel(board_model);
+    config_table->setItemDelegate(cell_delegate);
+    config_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    config_table->setSelectionMode(QAbstractItemView::SingleSelection);
+    config_table->setShowGrid(false);
+    config_table->setMouseTracking(true);
+    config_table->viewport()->setAttribute(Qt::WA_Hover);
+    config_table->setHorizontalScrollMode(QAbstractItemView::ScrollPerPixel);
+    config_table->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    
+    // Fixed section sizes keep the headers from measuring every row and column
+    QHeaderView* category_header = config_table->horizontalHeader();
+    category_header->setSectionResizeMode(QHeaderView::Fixed);
+    category_header->setDefaultSectionSize(ConfigCellDelegate::CELL_WIDTH);
+    category_header->setFixedHeight(44);
+    category_header->setTextElideMode(Qt::ElideRight);
+    category_header->setToolTip("Double-click a category to rename it");
+    
+    QHeaderView* points_header = config_table->verticalHeader();
+    points_header->setSectionResizeMode(QHeaderView::Fixed);
+    points_header->setDefaultSectionSize(ConfigCellDelegate::CELL_HEIGHT);
+    
+    config_table->setStyleSheet(
+        "QTableView { border: 2px solid #16213e; background-color: #0f3460; }"
+        "QHeaderView::section { background-color: #16213e; color: #ffd700; border: 2px solid #0f3460; "
+        "padding: 8px; font-weight: bold; font-size: 14px; }"
     );
     
-    main_layout->addWidget(config_scroll_area);
+    main_layout->addWidget(config_table);
+    
+    connect(config_table, &QTableView::clicked, this, &ConfigWidget::edit_cell);
+    connect(category_header, &QHeaderView::sectionDoubleClicked, this, &ConfigWidget::edit_category);
 }
 
 void ConfigWidget::create_size_controls() {
@@ -36,13 +72,13 @@ void ConfigWidget::create_size_controls() {
     QLabel* rows_label = new QLabel("Rows:");
     rows_spinbox = new QSpinBox;
     rows_spinbox->setMinimum(3);
-    rows_spinbox->setMaximum(10);
+    rows_spinbox->setMaximum(MAX_ROWS);
     rows_spinbox->setValue(5);
     
     QLabel* cols_label = new QLabel("Columns:");
     cols_spinbox = new QSpinBox;
     cols_spinbox->setMinimum(3);
-    cols_spinbox->setMaximum(8);
+    cols_spinbox->setMaximum(MAX_COLS);
     cols_spinbox->setValue(6);
     
     apply_size_button = new QPushButton("Apply Size");
@@ -52,6 +88,15 @@ void ConfigWidget::create_size_controls() {
         "QPushButton:hover { background-color: #0f3460; }"
     );
     
+    const turn_timer_settings& timers = game_controller->get_turn_timer_settings();
+    QLabel* answer_time_label = new QLabel("Answer time:");
+    answer_time_spinbox = create_timer_spinbox(timers.answer_seconds);
+    QLabel* steal_time_label = new QLabel("Steal time:");
+    steal_time_spinbox = create_timer_spinbox(timers.steal_seconds);
+    
+    clear_board_button = new QPushButton("Clear Board");
+    clear_board_button->setStyleSheet(apply_size_button->styleSheet());
+    
     size_layout->addWidget(rows_label);
     size_layout->addWidget(rows_spinbox);
     size_layout->addWidget(cols_label);
@@ -59,105 +104,33 @@ void ConfigWidget::create_size_controls() {
                                  "padding: 8px; font-weight: bold; font-size: 14px; }");
     size_layout->addWidget(cols_spinbox);
     size_layout->addWidget(apply_size_button);
+    size_layout->addSpacing(20);
+    size_layout->addWidget(answer_time_label);
+    size_layout->addWidget(answer_time_spinbox);
+    size_layout->addWidget(steal_time_label);
+    size_layout->addWidget(steal_time_spinbox);
     size_layout->addStretch();
+    size_layout->addWidget(clear_board_button);
     
     main_layout->addWidget(size_widget);
     
     connect(apply_size_button, &QPushButton::clicked, this, &ConfigWidget::apply_board_size);
+    connect(clear_board_button, &QPushButton::clicked, this, &ConfigWidget::clear_board);
+    connect(answer_time_spinbox, &QSpinBox::valueChanged, this, &ConfigWidget::apply_turn_timers);
+    connect(steal_time_spinbox, &QSpinBox::valueChanged, this, &ConfigWidget::apply_turn_timers);
 }
 
-void ConfigWidget::rebuild_config_grid() {
-    clear_config_grid();
-    
-    const board* board = game_controller->get_board();
-    if (!board) return;
-    
-    size_t rows = board->get_rows();
-    size_t cols = board->get_cols();
-    
-    category_inputs.clear();
-    cell_edit_buttons.clear();
-    
-    for (size_t col = 0; col < cols; ++col) {
-        QLineEdit* category_input = new QLineEdit(QString::fromStdString(board->get_category(col)));
-        category_input->setStyleSheet(
-            "QLineEdit { background-color: #16213e; color: #ffd700; border: 2px solid #0f3460; "
-            "padding: 8px; font-weight: bold; font-size: 14px; }"
-        );
-        category_inputs.push_back(category_input);
-        config_grid_layout->addWidget(category_input, 0, static_cast<int>(col));
-        
-        connect(category_input, QOverload<const QString&>::of(&QLineEdit::textChanged),
-                [this, col](const QString&) { update_category(static_cast<int>(col)); });
-    }
-    
-    cell_edit_buttons.resize(rows);
-    for (size_t row = 0; row < rows; ++row) {
-        cell_edit_buttons[row].resize(cols);
-        for (size_t col = 0; col < cols; ++col) {
-            QPushButton* edit_button = new QPushButton(QString("Edit\n$%1").arg(board->get_cell_points(row)));
-            edit_button->setMinimumSize(120, 80);
-            
-            cell_edit_buttons[row][col] = edit_button;
-            config_grid_layout->addWidget(edit_button, static_cast<int>(row + 1), static_cast<int>(col));
-            
-            connect(edit_button, &QPushButton::clicked, 
-                    [this, row, col]() { edit_cell(static_cast<int>(row), static_cast<int>(col)); });
-            
-            // Update the button style based on cell content
-            update_cell_button_style(row, col);
-        }
-    }
-}
-
-void ConfigWidget::update_cell_button_style(size_t row, size_t col) {
-    const board* board = game_controller->get_board();
-    if (!board || row >= cell_edit_buttons.size() || col >= cell_edit_buttons[row].size()) {
-        return;
-    }
-    
-    const cell& current_cell = board->get_cell(row, col);
-    QPushButton* button = cell_edit_buttons[row][col];
-    
-    QString question = QString::fromStdString(current_cell.get_question()).trimmed();
-    QString answer = QString::fromStdString(current_cell.get_answer()).trimmed();
-    
-    bool has_question = !question.isEmpty();
-    bool has_answer = !answer.isEmpty();
-    
-    QString base_style = 
-        "QPushButton { color: white; border-radius: 5px; font-weight: bold; }";
-    
-    QString hover_style = "QPushButton:hover { background-color: #0f3460; }";
-    
-    if (has_question && has_answer) {
-        // Green border and background for complete cells (question + answer)
-        button->setStyleSheet(base_style + 
-            "QPushButton { background-color: #1a4d1a; "
-            "border: 3px solid #00ff00; }" + hover_style);
-    } else if (has_question) {
-        // Purple border and background for cells with only question
-        button->setStyleSheet(base_style + 
-            "QPushButton { background-color: #4d1a4d; "
-            "border: 3px solid #8a2be2; }" + hover_style);
-    } else {
-        // Default style for empty cells
-        button->setStyleSheet(base_style + 
-            "QPushButton { background-color: #16213e; "
-            "border: 2px solid #0f3460; }" + hover_style);
-    }
+QSpinBox* ConfigWidget::create_timer_spinbox(int seconds) {
+    QSpinBox* spinbox = new QSpinBox;
+    spinbox->setRange(0, 300);
+    spinbox->setSuffix(" s");
+    spinbox->setSpecialValueText("Off");
+    spinbox->setValue(seconds);
+    return spinbox;
 }
 
-void ConfigWidget::clear_config_grid() {
-    QLayoutItem* item;
-    while ((item = config_grid_layout->takeAt(0)) != nullptr) {
-        if (QWidget* widget = item->widget()) {
-            delete widget;
-        }
-        delete item;
-    }
-    category_inputs.clear();
-    cell_edit_buttons.clear();
+void ConfigWidget::apply_turn_timers() {
+    game_controller->set_turn_timer_settings({answer_time_spinbox->value(), steal_time_spinbox->value()});
 }
 
 void ConfigWidget::apply_board_size() {
@@ -166,33 +139,50 @@ void ConfigWidget::apply_board_size() {
     game_controller->configure_board_size(new_rows, new_cols);
 }
 
-void ConfigWidget::edit_cell(int row, int col) {
-    CellEditDialog* dialog = new CellEditDialog(game_controller, static_cast<size_t>(row), static_cast<size_t>(col), this);
-    dialog->setAttribute(Qt::WA_DeleteOnClose);
-    
-    // Connect to update the cell appearance when dialog is closed/saved
-    connect(dialog, &CellEditDialog::cell_updated, 
-            [this, row, col]() { update_cell_button_style(static_cast<size_t>(row), static_cast<size_t>(col)); });
+void ConfigWidget::clear_board() {
+    if (QMessageBox::question(this, "Clear Board", "Remove every category, question and answer?") == QMessageBox::Yes) {
+        game_controller->clear_board();
+    }
+}
+
+void ConfigWidget::edit_cell(const QModelIndex& index) {
+    if (!index.isValid()) return;
     
+    CellEditDialog* dialog = new CellEditDialog(game_controller, static_cast<size_t>(index.row()),
+                                                static_cast<size_t>(index.column()), this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    // The model repaints the cell from the controller's board_changes_committed
     dialog->show();
 }
 
-void ConfigWidget::update_category(int col) {
-    if (col >= 0 && col < static_cast<int>(category_inputs.size())) {
-        std::string category_text = category_inputs[static_cast<size_t>(col)]->text().toStdString();
-        game_controller->set_category_name(static_cast<size_t>(col), category_text);
+void ConfigWidget::edit_category(int col) {
+    bool accepted = false;
+    QString current = board_model->headerData(col, Qt::Horizontal, Qt::EditRole).toString();
+    QString name = QInputDialog::getText(this, "Rename Category", QString("Category %1:").arg(col + 1),
+                                         QLineEdit::Normal, current, &accepted);
+    if (accepted && name != current) {
+        board_model->setHeaderData(col, Qt::Horizontal, name, Qt::EditRole);
     }
 }
 
-void ConfigWidget::on_board_changed() {
-    rebuild_config_grid();
+void ConfigWidget::on_board_reset() {
+    // Keep the size controls in step with boards loaded from disk. A file may be larger than the
+    // editor offers; widen the range rather than clamp, so Apply Size can't silently shrink it
+    if (const board* board = game_controller->get_board()) {
+        int rows = static_cast<int>(board->get_rows());
+        int cols = static_cast<int>(board->get_cols());
+        rows_spinbox->setMaximum(std::max(MAX_ROWS, rows));
+        cols_spinbox->setMaximum(std::max(MAX_COLS, cols));
+        rows_spinbox->setValue(rows);
+        cols_spinbox->setValue(cols);
+    }
 }
 
 CellEditDialog::CellEditDialog(GameController* controller, size_t row, size_t col, QWidget* parent)
     : QWidget(parent), row(row), col(col), game_controller(controller) {
     
     setWindowTitle(QString("Edit Cell (%1, %2)").arg(row + 1).arg(col + 1));
-    setFixedSize(400, 300);
+    setFixedSize(400, 380);
     setStyleSheet("background-color: #1a1a2e; color: white;");
     
     layout = new QVBoxLayout(this);
@@ -205,15 +195,30 @@ CellEditDialog::CellEditDialog(GameController* controller, size_t row, size_t co
     title_label->setAlignment(Qt::AlignCenter);
     
     QLabel* question_label = new QLabel("Question:");
-    question_edit = new QTextEdit(QString::fromStdString(current_cell.get_question()));
+    question_edit = new QTextEdit(current_cell.get_question_text().qstr());
     question_edit->setMaximumHeight(80);
     question_edit->setStyleSheet("background-color: #16213e; border: 2px solid #0f3460; padding: 5px;");
     
     QLabel* answer_label = new QLabel("Answer:");
-    answer_edit = new QTextEdit(QString::fromStdString(current_cell.get_answer()));
+    answer_edit = new QTextEdit(current_cell.get_answer_text().qstr());
     answer_edit->setMaximumHeight(80);
     answer_edit->setStyleSheet("background-color: #16213e; border: 2px solid #0f3460; padding: 5px;");
     
+    QLabel* media_label = new QLabel("Media (optional):");
+    QHBoxLayout* media_layout = new QHBoxLayout;
+    media_edit = new QLineEdit(current_cell.get_media_path_text().qstr());
+    media_edit->setStyleSheet("background-color: #16213e; border: 2px solid #0f3460; padding: 5px;");
+    media_type_combo = new QComboBox;
+    media_type_combo->addItem("None", static_cast<int>(MediaType::NONE));
+    media_type_combo->addItem("Image", static_cast<int>(MediaType::IMAGE));
+    media_type_combo->addItem("Audio", static_cast<int>(MediaType::AUDIO));
+    media_type_combo->addItem("Video", static_cast<int>(MediaType::VIDEO));
+    media_type_combo->setCurrentIndex(media_type_combo->findData(static_cast<int>(current_cell.get_media_type())));
+    browse_media_button = new QPushButton("Browse...");
+    media_layout->addWidget(media_edit, 1);
+    media_layout->addWidget(media_type_combo);
+    media_layout->addWidget(browse_media_button);
+    
     QHBoxLayout* button_layout = new QHBoxLayout;
     save_button = new QPushButton("Save");
     cancel_button = new QPushButton("Cancel");
@@ -225,6 +230,7 @@ CellEditDialog::CellEditDialog(GameController* controller, size_t row, size_t co
     
     save_button->setStyleSheet(button_style);
     cancel_button->setStyleSheet(button_style);
+    browse_media_button->setStyleSheet(button_style);
     
     button_layout->addWidget(save_button);
     button_layout->addWidget(cancel_button);
@@ -234,16 +240,24 @@ CellEditDialog::CellEditDialog(GameController* controller, size_t row, size_t co
     layout->addWidget(question_edit);
     layout->addWidget(answer_label);
     layout->addWidget(answer_edit);
+    layout->addWidget(media_label);
+    layout->addLayout(media_layout);
     layout->addLayout(button_layout);
     
     connect(save_button, &QPushButton::clicked, this, &CellEditDialog::save_cell);
     connect(cancel_button, &QPushButton::clicked, this, &CellEditDialog::cancel_edit);
+    connect(browse_media_button, &QPushButton::clicked, this, &CellEditDialog::browse_media);
 }
 
 void CellEditDialog::save_cell() {
-    std::string question = question_edit->toPlainText().toStdString();
-    std::string answer = answer_edit->toPlainText().toStdString();
-    game_controller->set_question_answer(row, col, question, answer);
+    game_controller->set_question_answer(row, col, question_edit->toPlainText(), answer_edit->toPlainText());
+    
+    QString media_path = media_edit->text().trimmed();
+    MediaType media_type = static_cast<MediaType>(media_type_combo->currentData().toInt());
+    const cell& current_cell = game_controller->get_board()->get_cell(row, col);
+    if (media_path != current_cell.get_media_path_text().qstr() || media_type != current_cell.get_media_type()) {
+        game_controller->set_question_media(row, col, media_path, media_type);
+    }
     emit cell_updated();  
     close();
 }
@@ -251,3 +265,25 @@ void CellEditDialog::save_cell() {
 void CellEditDialog::cancel_edit() {
     close();
 }
+
+void CellEditDialog::browse_media() {
+    QString path = QFileDialog::getOpenFileName(this, "Choose Media", QString(),
+        "Media (*.png *.jpg *.jpeg *.gif *.bmp *.webp *.mp3 *.wav *.ogg *.m4a *.mp4 *.mov *.webm *.mkv);;All files (*)");
+    if (path.isEmpty()) return;
+    
+    media_edit->setText(path);
+    
+    QByteArray suffix = QFileInfo(path).suffix().toLower().toUtf8();
+    static const QList<QByteArray> audio_suffixes = {"mp3", "wav", "ogg", "m4a", "flac"};
+    static const QList<QByteArray> video_suffixes = {"mp4", "mov", "webm", "mkv", "avi"};
+    
+    MediaType type = MediaType::NONE;
+    if (QImageReader::supportedImageFormats().contains(suffix)) {
+        type = MediaType::IMAGE;
+    } else if (audio_suffixes.contains(suffix)) {
+        type = MediaType::AUDIO;
+    } else if (video_suffixes.contains(suffix)) {
+        type = MediaType::VIDEO;
+    }
+    media_type_combo->setCurrentIndex(media_type_combo->findData(static_cast<int>(type)));
+}
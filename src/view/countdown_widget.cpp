@@ -0,0 +1,140 @@
+#include "view/countdown_widget.h"
+#include "view/animation_clock.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <algorithm>
+#include "util/trace.h"
+
+using namespace std::chrono_literals;
+
+CountdownWidget::CountdownWidget(QWidget* parent)
+    : QWidget(parent), wake_timer(this), total(0), running(false), shown_width(0), shown_seconds(0) {
+    wake_timer.setSingleShot(true);
+    wake_timer.setTimerType(Qt::PreciseTimer);
+    connect(&wake_timer, &QTimer::timeout, this, &CountdownWidget::on_wake);
+    setVisible(false);
+}
+
+QSize CountdownWidget::sizeHint() const {
+    return QSize(400, BAR_HEIGHT + 12);
+}
+
+void CountdownWidget::start(int seconds) {
+    if (seconds <= 0) {
+        stop();
+        setVisible(false);
+        return;
+    }
+    
+    TRACE_INSTANT("CountdownWidget::start");
+    total = std::chrono::seconds(seconds);
+    deadline = clock::now() + total;
+    running = true;
+    shown_width = fill_width(total);
+    shown_seconds = whole_seconds(total);
+    setVisible(true);
+    update();
+    schedule_next(total);
+}
+
+void CountdownWidget::stop() {
+    wake_timer.stop();
+    running = false;
+}
+
+std::chrono::milliseconds CountdownWidget::remaining() const {
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now());
+    return std::max(left, 0ms);
+}
+
+QRect CountdownWidget::bar_rect() const {
+    return QRect(0, (height() - BAR_HEIGHT) / 2, std::max(width() - TEXT_WIDTH - SPACING, 1), BAR_HEIGHT);
+}
+
+QRect CountdownWidget::text_rect() const {
+    return QRect(width() - TEXT_WIDTH, 0, TEXT_WIDTH, height());
+}
+
+int CountdownWidget::fill_width(std::chrono::milliseconds left) const {
+    if (total.count() <= 0) return 0;
+    // Round up so the bar only empties when the time is actually up
+    const int64_t bar = bar_rect().width();
+    return static_cast<int>((bar * left.count() + total.count() - 1) / total.count());
+}
+
+int CountdownWidget::whole_seconds(std::chrono::milliseconds left) {
+    return static_cast<int>((left.count() + 999) / 1000);
+}
+
+void CountdownWidget::schedule_next(std::chrono::milliseconds left) {
+    if (left <= 0ms) {
+        wake_timer.start(0);
+        return;
+    }
+    
+    // Next moment the picture changes: the bar loses a pixel or the seconds tick over
+    const int64_t bar = bar_rect().width();
+    const int64_t next_pixel_at = (shown_width - 1) * total.count() / std::max<int64_t>(bar, 1);
+    const int64_t next_second_at = static_cast<int64_t>(shown_seconds - 1) * 1000;
+    const int64_t wait = left.count() - std::max(next_pixel_at, next_second_at);
+    
+    // Faster than a frame would never be seen
+    wake_timer.start(static_cast<int>(std::clamp<int64_t>(wait, AnimationClock::FRAME_INTERVAL_MS, left.count())));
+}
+
+void CountdownWidget::on_wake() {
+    if (!running) return;
+    
+    const std::chrono::milliseconds left = remaining();
+    const int width_now = fill_width(left);
+    const int seconds_now = whole_seconds(left);
+    const QRect bar = bar_rect();
+    
+    const bool warning_changed = (shown_seconds > WARNING_SECONDS) != (seconds_now > WARNING_SECONDS);
+    if (warning_changed) {
+        update(bar);
+    } else if (width_now != shown_width) {
+        update(QRect(bar.left() + width_now, bar.top(), shown_width - width_now + 1, bar.height()));
+    }
+    shown_width = width_now;
+    if (seconds_now != shown_seconds) {
+        shown_seconds = seconds_now;
+        update(text_rect());
+    }
+    
+    if (left <= 0ms) {
+        running = false;
+        TRACE_INSTANT("CountdownWidget::expired");
+        emit expired();
+        return;
+    }
+    schedule_next(left);
+}
+
+void CountdownWidget::resizeEvent(QResizeEvent* event) {
+    QWidget::resizeEvent(event);
+    if (running) {
+        shown_width = fill_width(remaining());
+        schedule_next(remaining());
+    }
+}
+
+void CountdownWidget::paintEvent(QPaintEvent* event) {
+    QPainter painter(this);
+    const QRect bar = bar_rect();
+    const bool warning = shown_seconds <= WARNING_SECONDS;
+    
+    if (event->rect().intersects(bar)) {
+        painter.fillRect(bar, QColor("#16213e"));
+        painter.fillRect(QRect(bar.left(), bar.top(), shown_width, bar.height()),
+                         warning ? QColor("#f44336") : QColor("#ffd700"));
+    }
+    if (event->rect().intersects(text_rect())) {
+        QFont font = painter.font();
+        font.setPixelSize(16);
+        font.setBold(true);
+        painter.setFont(font);
+        painter.setPen(warning ? QColor("#f44336") : QColor("white"));
+        painter.drawText(text_rect(), Qt::AlignRight | Qt::AlignVCenter, QString("%1s").arg(shown_seconds));
+    }
+}
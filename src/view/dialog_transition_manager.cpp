@@ -1,56 +1,47 @@
 #include "view/dialog_transition_manager.h"
 #include <QEasingCurve>
+#include "util/trace.h"
 
-DialogTransitionManager::DialogTransitionManager(QDialog* dialog, QObject* parent)
-    : QObject(parent), dialog(dialog), dialog_opacity_effect(nullptr), fade_out_animation(nullptr) {
-    setup_transition_effects();
+DialogTransitionManager::DialogTransitionManager(QDialog* dialog, AnimationClock* clock, QObject* parent)
+    : QObject(parent), dialog(dialog), clock(clock), dialog_opacity_effect(nullptr), fade_out_effect(0) {
 }
 
 DialogTransitionManager::~DialogTransitionManager() {
-    if (fade_out_animation) {
-        fade_out_animation->stop();
-        fade_out_animation->deleteLater();
-    }
+    clock->stop(fade_out_effect);
 }
 
 void DialogTransitionManager::setup_transition_effects() {
-    // Create graphics opacity effect for dialog fade
-    dialog_opacity_effect = new QGraphicsOpacityEffect(dialog);
+    // An installed effect renders the whole dialog offscreen on every repaint,
+    // including each countdown tick, so it only exists while fading
+    if (!dialog_opacity_effect) {
+        dialog_opacity_effect = new QGraphicsOpacityEffect(dialog);
+        dialog->setGraphicsEffect(dialog_opacity_effect);
+    }
     dialog_opacity_effect->setOpacity(1.0);
-    dialog->setGraphicsEffect(dialog_opacity_effect);
 }
 
 void DialogTransitionManager::fade_out_and_close() {
-    if (fade_out_animation) {
-        fade_out_animation->stop();
-        fade_out_animation->deleteLater();
-    }
-    
-    // Create fade-out animation for smooth dialog transition
-    fade_out_animation = new QPropertyAnimation(dialog_opacity_effect, "opacity", this);
-    fade_out_animation->setDuration(DIALOG_FADE_DURATION);
-    fade_out_animation->setStartValue(1.0);
-    fade_out_animation->setEndValue(0.0);
-    fade_out_animation->setEasingCurve(QEasingCurve::InQuad);
-    
-    // Connect completion signal
-    connect(fade_out_animation, &QPropertyAnimation::finished, 
-            this, &DialogTransitionManager::on_fade_out_finished);
+    TRACE_INSTANT("DialogTransitionManager::fade_out_started");
+    clock->stop(fade_out_effect);
+    setup_transition_effects();
     
-    fade_out_animation->start();
+    // Smooth dialog transition on the shared frame tick
+    fade_out_effect = clock->start(dialog_opacity_effect, DIALOG_FADE_DURATION, QEasingCurve::InQuad,
+        [this](double progress) { dialog_opacity_effect->setOpacity(1.0 - progress); },
+        [this]() { on_fade_out_finished(); });
 }
 
 void DialogTransitionManager::reset_opacity() {
+    clock->stop(fade_out_effect);
     if (dialog_opacity_effect) {
-        dialog_opacity_effect->setOpacity(1.0);
+        // setGraphicsEffect deletes the previous effect
+        dialog->setGraphicsEffect(nullptr);
+        dialog_opacity_effect = nullptr;
     }
 }
 
 void DialogTransitionManager::on_fade_out_finished() {
-    if (fade_out_animation) {
-        fade_out_animation->deleteLater();
-        fade_out_animation = nullptr;
-    }
-    
+    TRACE_INSTANT("DialogTransitionManager::fade_out_finished");
+    fade_out_effect = 0;
     emit transition_finished();
 }
@@ -1,140 +1,304 @@
 #include "view/game_board_widget.h"
-#include <QPushButton>
+#include "view/board_render_cache.h"
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPaintEvent>
+#include <algorithm>
+#include "util/input_latency.h"
+#include "util/trace.h"
 
-GameBoardWidget::GameBoardWidget(GameController* controller, QWidget* parent)
-    : QWidget(parent), game_controller(controller) {
-    setup_ui();
+GameBoardWidget::GameBoardWidget(GameController* controller, BoardRenderCache* cache, BoardAudience audience, QWidget* parent)
+    : QWidget(parent), game_controller(controller), render_cache(cache), audience(audience), latency(nullptr),
+      hovered_row(-1), hovered_col(-1) {
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setMouseTracking(true);
+    setFocusPolicy(Qt::StrongFocus);
     
     connect(game_controller, &GameController::board_changed, this, &GameBoardWidget::on_board_changed);
-    rebuild_board();
+    // A new game compiles a fresh play board
+    connect(game_controller, &GameController::mode_changed, this, &GameBoardWidget::on_board_changed);
+    if (audience == BoardAudience::PRESENTER) {
+        // Only the presenter's tiles list the teams that have tried a clue
+        connect(game_controller, &GameController::attempts_changed, this, &GameBoardWidget::on_attempts_changed);
+    }
 }
 
-void GameBoardWidget::setup_ui() {
-    main_layout = new QVBoxLayout(this);
-    main_layout->setSpacing(10);
-    main_layout->setContentsMargins(20, 20, 20, 20);
-    
-    setStyleSheet("background-color: #1a1a2e;");
+const play_board* GameBoardWidget::shown_play_board() const {
+    // A finished game keeps its play board, but editing shows the board being configured
+    return game_controller->get_current_mode() == GameMode::PLAYING ? game_controller->get_play_board() : nullptr;
+}
+
+QSize GameBoardWidget::grid_size() const {
+    if (const play_board* board = shown_play_board()) {
+        return QSize(static_cast<int>(board->get_cols()), static_cast<int>(board->get_rows()));
+    }
+    const board* config_board = game_controller->get_board();
+    return QSize(static_cast<int>(config_board->get_cols()), static_cast<int>(config_board->get_rows()));
+}
+
+QSize GameBoardWidget::minimumSizeHint() const {
+    const QSize grid = grid_size();
+    int rows = grid.height();
+    int cols = grid.width();
+    return QSize(2 * MARGIN + cols * MIN_CELL_WIDTH + (cols - 1) * SPACING,
+                 2 * MARGIN + HEADER_HEIGHT + rows * (MIN_CELL_HEIGHT + SPACING));
+}
+
+QSize GameBoardWidget::cell_size() const {
+    const QSize grid = grid_size();
+    int rows = std::max(1, grid.height());
+    int cols = std::max(1, grid.width());
+    // Whole pixels so every tile on the board has the same size and shares one render
+    int width = (this->width() - 2 * MARGIN - (cols - 1) * SPACING) / cols;
+    int height = (this->height() - 2 * MARGIN - HEADER_HEIGHT - rows * SPACING) / rows;
+    return QSize(std::max(width, 1), std::max(height, 1));
+}
+
+QRect GameBoardWidget::header_rect(size_t col) const {
+    QSize size = cell_size();
+    return QRect(MARGIN + static_cast<int>(col) * (size.width() + SPACING), MARGIN, size.width(), HEADER_HEIGHT);
+}
+
+QRect GameBoardWidget::cell_rect(size_t row, size_t col) const {
+    QSize size = cell_size();
+    return QRect(MARGIN + static_cast<int>(col) * (size.width() + SPACING),
+                 MARGIN + HEADER_HEIGHT + SPACING + static_cast<int>(row) * (size.height() + SPACING),
+                 size.width(), size.height());
 }
 
-void GameBoardWidget::rebuild_board() {
-    clear_board();
+bool GameBoardWidget::cell_at(const QPoint& position, size_t& row, size_t& col) const {
+    const QSize grid = grid_size();
+    QSize size = cell_size();
+    int x = position.x() - MARGIN;
+    int y = position.y() - MARGIN - HEADER_HEIGHT - SPACING;
+    if (x < 0 || y < 0) return false;
     
-    const board* board = game_controller->get_board();
-    if (!board) return;
+    int candidate_col = x / (size.width() + SPACING);
+    int candidate_row = y / (size.height() + SPACING);
+    if (candidate_col >= grid.width() || candidate_row >= grid.height()) {
+        return false;
+    }
+    row = static_cast<size_t>(candidate_row);
+    col = static_cast<size_t>(candidate_col);
+    // Clicks in the spacing between tiles don't count
+    return cell_rect(row, col).contains(position);
+}
+
+void GameBoardWidget::paintEvent(QPaintEvent* event) {
+    TRACE_SCOPE("GameBoardWidget::paintEvent");
+    QPainter painter(this);
+    painter.fillRect(event->rect(), QColor("#1a1a2e"));
     
-    size_t rows = board->get_rows();
-    size_t cols = board->get_cols();
+    const play_board* board = shown_play_board();
+    if (!board) {
+        paint_config_board(painter, event->rect());
+    } else {
+        paint_play_board(painter, event->rect(), *board);
+    }
     
+    if (latency) {
+        latency->frame_presented();
+    }
+}
+
+void GameBoardWidget::paint_header(QPainter& painter, const QRect& rect, const shared_text& category) {
+    painter.setPen(QPen(QColor("#0f3460"), 3));
+    painter.setBrush(QColor("#16213e"));
+    painter.drawRect(rect.adjusted(1, 1, -2, -2));
     
-    QWidget* board_widget = new QWidget;
-    board_layout = new QGridLayout(board_widget);
-    board_layout->setSpacing(5);
+    QStaticText title = render_cache->text_layout(category.qstr(), BoardRenderCache::TextRole::CATEGORY, rect.width() - 30);
+    painter.setFont(BoardRenderCache::font_for(BoardRenderCache::TextRole::CATEGORY));
+    painter.setPen(QColor("#ffd700"));
+    painter.save();
+    painter.setClipRect(rect.adjusted(3, 3, -3, -3));
+    painter.drawStaticText(rect.left() + 15, rect.center().y() - static_cast<int>(title.size().height() / 2), title);
+    painter.restore();
+}
+
+void GameBoardWidget::paint_config_board(QPainter& painter, const QRect& dirty_rect) {
+    // Before a game starts the presenter can preview the board as it is being edited
+    const board* config_board = game_controller->get_board();
+    const qreal ratio = devicePixelRatioF();
+    const QSize size = cell_size();
     
-    category_labels.clear();
-    cell_buttons.clear();
+    for (size_t col = 0; col < config_board->get_cols(); ++col) {
+        QRect rect = header_rect(col);
+        if (dirty_rect.intersects(rect)) {
+            paint_header(painter, rect, config_board->get_category_text(col));
+        }
+    }
     
+    for (size_t row = 0; row < config_board->get_rows(); ++row) {
+        for (size_t col = 0; col < config_board->get_cols(); ++col) {
+            QRect rect = cell_rect(row, col);
+            if (!dirty_rect.intersects(rect)) continue;
+            
+            const cell& game_cell = config_board->get_cell(row, col);
+            painter.drawPixmap(rect.topLeft(), render_cache->tile(game_cell.get_points(), BoardRenderCache::TileState::OPEN,
+                                                                  size, ratio));
+            if (audience == BoardAudience::PRESENTER) {
+                paint_answer(painter, rect, game_cell.get_answer_text(), false);
+            }
+        }
+    }
+}
+
+void GameBoardWidget::paint_play_board(QPainter& painter, const QRect& dirty_rect, const play_board& board) {
+    const qreal ratio = devicePixelRatioF();
+    const QSize size = cell_size();
     
-    for (size_t col = 0; col < cols; ++col) {
-        QLabel* category_label = new QLabel(QString::fromStdString(board->get_category(col)));
-        category_label->setStyleSheet(
-            "QLabel { background-color: #16213e; color: #ffd700; border: 3px solid #0f3460; "
-            "padding: 15px; font-weight: bold; font-size: 16px; text-align: center; }"
-        );
-        category_label->setAlignment(Qt::AlignCenter);
-        category_label->setMinimumHeight(60);
-        
-        category_labels.push_back(category_label);
-        board_layout->addWidget(category_label, 0, static_cast<int>(col));
+    for (size_t col = 0; col < board.get_cols(); ++col) {
+        QRect rect = header_rect(col);
+        if (dirty_rect.intersects(rect)) {
+            paint_header(painter, rect, board.get_category_text(col));
+        }
     }
     
-    cell_buttons.resize(rows);
-    for (size_t row = 0; row < rows; ++row) {
-        cell_buttons[row].resize(cols);
-        for (size_t col = 0; col < cols; ++col) {
-            QPushButton* cell_button = new QPushButton;
-            cell_button->setMinimumSize(150, 100);
-            cell_button->setProperty("row", static_cast<int>(row));
-            cell_button->setProperty("col", static_cast<int>(col));
+    for (size_t row = 0; row < board.get_rows(); ++row) {
+        for (size_t col = 0; col < board.get_cols(); ++col) {
+            QRect rect = cell_rect(row, col);
+            if (!dirty_rect.intersects(rect)) continue;
             
-            cell_buttons[row][col] = cell_button;
-            board_layout->addWidget(cell_button, static_cast<int>(row + 1), static_cast<int>(col));
+            BoardRenderCache::TileState state = BoardRenderCache::TileState::OPEN;
+            if (board.is_revealed(row, col)) {
+                state = BoardRenderCache::TileState::USED;
+            } else if (static_cast<int>(row) == hovered_row && static_cast<int>(col) == hovered_col) {
+                state = BoardRenderCache::TileState::HOVERED;
+            }
+            painter.drawPixmap(rect.topLeft(), render_cache->tile(board.get_points(row, col), state, size, ratio));
             
-            connect(cell_button, &QPushButton::clicked, this, &GameBoardWidget::on_cell_clicked);
-            update_cell_button(row, col);
+            if (audience == BoardAudience::PRESENTER) {
+                paint_presenter_details(painter, board, row, col, rect);
+            }
         }
     }
-    
-    main_layout->addWidget(board_widget);
 }
 
-void GameBoardWidget::clear_board() {
-    if (board_layout) {
-        QLayoutItem* item;
-        while ((item = board_layout->takeAt(0)) != nullptr) {
-            delete item->widget();
-            delete item;
-        }
-        delete board_layout->parentWidget();
-        board_layout = nullptr;
+void GameBoardWidget::paint_presenter_details(QPainter& painter, const play_board& board, size_t row, size_t col,
+                                              const QRect& rect) {
+    QRect detail_rect = rect.adjusted(DETAIL_PADDING, DETAIL_PADDING, -DETAIL_PADDING, -DETAIL_PADDING);
+    
+    int dot_x = detail_rect.right() - ATTEMPT_DOT_SIZE;
+    painter.setPen(Qt::NoPen);
+    for (size_t team_index : board.attempted_teams(row, col)) {
+        painter.setBrush(BoardRenderCache::team_color(team_index));
+        painter.drawEllipse(dot_x, detail_rect.top(), ATTEMPT_DOT_SIZE, ATTEMPT_DOT_SIZE);
+        dot_x -= ATTEMPT_DOT_SIZE + 3;
     }
-    category_labels.clear();
-    cell_buttons.clear();
+    
+    paint_answer(painter, rect, board.get_answer_text(row, col), board.is_revealed(row, col));
 }
 
-void GameBoardWidget::update_cell_button(size_t row, size_t col) {
-    const board* board = game_controller->get_board();
-    if (!board || row >= cell_buttons.size() || col >= cell_buttons[row].size()) return;
+void GameBoardWidget::paint_answer(QPainter& painter, const QRect& rect, const shared_text& answer, bool revealed) {
+    if (answer.is_blank()) return;
     
-    const cell& game_cell = board->get_cell(row, col);
-    QPushButton* button = cell_buttons[row][col];
+    QRect detail_rect = rect.adjusted(DETAIL_PADDING, DETAIL_PADDING, -DETAIL_PADDING, -DETAIL_PADDING);
+    QStaticText layout = render_cache->text_layout(answer.qstr(), BoardRenderCache::TextRole::DETAIL, detail_rect.width());
+    int top = std::max(detail_rect.top(), detail_rect.bottom() - static_cast<int>(layout.size().height()));
+    painter.save();
+    painter.setClipRect(detail_rect);
+    painter.setFont(BoardRenderCache::font_for(BoardRenderCache::TextRole::DETAIL));
+    painter.setPen(revealed ? QColor("#888") : QColor("#87ceeb"));
+    painter.drawStaticText(detail_rect.left(), top, layout);
+    painter.restore();
+}
+
+void GameBoardWidget::set_hovered(int row, int col) {
+    if (row == hovered_row && col == hovered_col) return;
     
-    if (game_cell.get_is_revealed()) {
-        button->setText("USED");
-        button->setEnabled(false);
-        button->setStyleSheet(
-            "QPushButton { background-color: #333; color: #666; border: 3px solid #555; "
-            "border-radius: 10px; font-weight: bold; font-size: 14px; }"
-        );
+    if (hovered_row >= 0) {
+        update(cell_rect(static_cast<size_t>(hovered_row), static_cast<size_t>(hovered_col)));
+    }
+    hovered_row = row;
+    hovered_col = col;
+    if (hovered_row >= 0) {
+        update(cell_rect(static_cast<size_t>(hovered_row), static_cast<size_t>(hovered_col)));
+        emit cell_hovered(static_cast<size_t>(hovered_row), static_cast<size_t>(hovered_col));
+    }
+}
+
+void GameBoardWidget::mouseMoveEvent(QMouseEvent* event) {
+    size_t row = 0;
+    size_t col = 0;
+    if (cell_at(event->position().toPoint(), row, col)) {
+        set_hovered(static_cast<int>(row), static_cast<int>(col));
     } else {
-        button->setText(QString("$%1").arg(game_cell.get_points()));
-        button->setEnabled(true);
-        button->setStyleSheet(
-            "QPushButton { background-color: #16213e; color: #ffd700; border: 3px solid #0f3460; "
-            "border-radius: 10px; font-weight: bold; font-size: 18px; }"
-            "QPushButton:hover { background-color: #0f3460; }"
-            "QPushButton:pressed { background-color: #e94560; }"
-        );
+        set_hovered(-1, -1);
     }
 }
 
-void GameBoardWidget::on_cell_clicked() {
-    QPushButton* button = qobject_cast<QPushButton*>(sender());
-    if (!button) return;
+void GameBoardWidget::leaveEvent(QEvent* event) {
+    QWidget::leaveEvent(event);
+    set_hovered(-1, -1);
+}
+
+void GameBoardWidget::mousePressEvent(QMouseEvent* event) {
+    TRACE_SCOPE("GameBoardWidget::mousePressEvent");
+    size_t row = 0;
+    size_t col = 0;
+    if (event->button() != Qt::LeftButton || !cell_at(event->position().toPoint(), row, col)) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
     
-    int row = button->property("row").toInt();
-    int col = button->property("col").toInt();
+    activate(row, col);
+}
+
+bool GameBoardWidget::activate(size_t row, size_t col) {
+    if (!game_controller->select_cell(row, col)) return false;
+    update(cell_rect(row, col));
+    emit cell_selected(row, col);
+    return true;
+}
+
+void GameBoardWidget::keyPressEvent(QKeyEvent* event) {
+    const QSize grid = grid_size();
+    const int rows = grid.height();
+    const int cols = grid.width();
+    if (rows == 0 || cols == 0) return;
     
-    if (game_controller->select_cell(static_cast<size_t>(row), static_cast<size_t>(col))) {
-        update_cell_button(static_cast<size_t>(row), static_cast<size_t>(col));
-        emit cell_selected(static_cast<size_t>(row), static_cast<size_t>(col));
+    // Only presses that change what is shown are timed
+    const uint64_t pressed_ns = tracer::now_ns();
+    int row = std::max(hovered_row, 0);
+    int col = std::max(hovered_col, 0);
+    switch (event->key()) {
+        case Qt::Key_Up:    row = (row + rows - 1) % rows; break;
+        case Qt::Key_Down:  row = (row + 1) % rows; break;
+        case Qt::Key_Left:  col = (col + cols - 1) % cols; break;
+        case Qt::Key_Right: col = (col + 1) % cols; break;
+        case Qt::Key_Return:
+        case Qt::Key_Enter:
+        case Qt::Key_Space:
+            if (hovered_row >= 0 && activate(static_cast<size_t>(hovered_row), static_cast<size_t>(hovered_col)) &&
+                latency) {
+                latency->input_received(pressed_ns);
+            }
+            return;
+        default:
+            QWidget::keyPressEvent(event);
+            return;
+    }
+    
+    // The first arrow press only shows where the highlight starts
+    if (hovered_row < 0) {
+        row = 0;
+        col = 0;
+    }
+    if (latency && (row != hovered_row || col != hovered_col)) {
+        latency->input_received(pressed_ns);
     }
+    set_hovered(row, col);
 }
 
 void GameBoardWidget::on_board_changed() {
-    if (game_controller->get_current_mode() == GameMode::PLAYING) {
-        
-        const board* board = game_controller->get_board();
-        if (board) {
-            for (size_t row = 0; row < board->get_rows(); ++row) {
-                for (size_t col = 0; col < board->get_cols(); ++col) {
-                    if (row < cell_buttons.size() && col < cell_buttons[row].size()) {
-                        update_cell_button(row, col);
-                    }
-                }
-            }
-        }
-    } else {
-        rebuild_board();
-    }
+    TRACE_SCOPE("GameBoardWidget::on_board_changed");
+    // Repainting is a blit per visible tile; anything new is rendered once in the shared cache
+    updateGeometry();
+    update();
 }
+
+void GameBoardWidget::on_attempts_changed(size_t row, size_t col) {
+    update(cell_rect(row, col));
+}
+
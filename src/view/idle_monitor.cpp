@@ -0,0 +1,104 @@
+#include "view/idle_monitor.h"
+#include "view/animation_clock.h"
+#include <QAbstractAnimation>
+#include <QApplication>
+#include <QEvent>
+#include <QWidget>
+#include <algorithm>
+#include <cstdio>
+#include <set>
+#include "util/trace.h"
+
+std::string idle_report::to_text() const {
+    std::string text = "Idle report:\n";
+    char line[200];
+    std::snprintf(line, sizeof(line), "  %llu wakeups in %.1f s (%.2f/s), %d running timers, %zu active animations\n",
+                  static_cast<unsigned long long>(wakeups), seconds, wakeups_per_second(), active_timers,
+                  active_animations);
+    text += line;
+    for (const auto& [source, count] : sources) {
+        std::snprintf(line, sizeof(line), "  %8llu  %s\n", static_cast<unsigned long long>(count), source.c_str());
+        text += line;
+    }
+    for (const auto& timer : timers) {
+        text += "  running: " + timer + "\n";
+    }
+    text += is_idle() ? "  idle\n" : "  NOT idle\n";
+    return text;
+}
+
+IdleMonitor::IdleMonitor(AnimationClock* clock, QObject* parent)
+    : QObject(parent), clock(clock), measurement_timer(this), wakeups(0) {
+    measurement_timer.setSingleShot(true);
+    connect(&measurement_timer, &QTimer::timeout, this, &IdleMonitor::finish_measurement);
+}
+
+void IdleMonitor::measure(int duration_ms) {
+    if (is_measuring()) return;
+    
+    TRACE_INSTANT("IdleMonitor::measure");
+    wakeups = 0;
+    sources.clear();
+    QCoreApplication::instance()->installEventFilter(this);
+    elapsed.start();
+    measurement_timer.start(duration_ms);
+}
+
+std::string IdleMonitor::describe(const QObject* object) {
+    // A bare QTimer says nothing; the object that owns it does
+    if (qobject_cast<const QTimer*>(object) && object->parent()) {
+        object = object->parent();
+    }
+    std::string name = object->metaObject()->className();
+    if (!object->objectName().isEmpty()) {
+        name += " \"" + object->objectName().toStdString() + "\"";
+    }
+    return name;
+}
+
+bool IdleMonitor::eventFilter(QObject* watched, QEvent* event) {
+    const char* kind = nullptr;
+    switch (event->type()) {
+        case QEvent::Timer:         kind = "timer "; break;
+        case QEvent::MetaCall:      kind = "queued call "; break;
+        case QEvent::UpdateRequest: kind = "repaint "; break;
+        default: break;
+    }
+    if (kind && watched != &measurement_timer) {
+        ++wakeups;
+        ++sources[kind + describe(watched)];
+    }
+    return false;
+}
+
+void IdleMonitor::finish_measurement() {
+    QCoreApplication::instance()->removeEventFilter(this);
+    
+    idle_report report;
+    report.seconds = static_cast<double>(elapsed.elapsed()) / 1000.0;
+    report.wakeups = wakeups;
+    report.sources.assign(sources.begin(), sources.end());
+    std::sort(report.sources.begin(), report.sources.end(),
+              [](const auto& a, const auto& b) { return a.second > b.second; });
+    
+    // Every long-lived timer hangs off a top-level widget or one of its children
+    std::set<const QTimer*> seen;
+    std::set<const QAbstractAnimation*> seen_animations;
+    for (QWidget* top_level : QApplication::topLevelWidgets()) {
+        for (const QTimer* timer : top_level->findChildren<QTimer*>()) {
+            if (timer != &measurement_timer && timer->isActive() && seen.insert(timer).second) {
+                report.timers.push_back(describe(timer) + " every " + std::to_string(timer->interval()) + " ms");
+            }
+        }
+        for (const QAbstractAnimation* animation : top_level->findChildren<QAbstractAnimation*>()) {
+            if (animation->state() == QAbstractAnimation::Running) {
+                seen_animations.insert(animation);
+            }
+        }
+    }
+    report.active_timers = static_cast<int>(report.timers.size());
+    report.active_animations = seen_animations.size() + (clock ? clock->active_count() : 0);
+    
+    TRACE_INSTANT("IdleMonitor::finished");
+    emit finished(report);
+}
@@ -3,24 +3,62 @@
 #include "view/game_board_widget.h"
 #include "view/question_dialog.h"
 #include "view/team_widget.h"
+#include "view/pixmap_cache.h"
+#include "view/clue_document_cache.h"
+#include "view/score_timeline_widget.h"
+#include "view/memory_report_widget.h"
+#include "view/board_render_cache.h"
+#include "view/presenter_window.h"
+#include "view/animation_clock.h"
+#include "view/idle_monitor.h"
+#include "controller/autosave_service.h"
+#include "controller/collaboration_session.h"
+#include "controller/scoreboard_server.h"
+#include "util/trace.h"
+#include <QFileDialog>
+#include <QInputDialog>
+#include <QMessageBox>
+#include <QGraphicsEffect>
 
 MainWindow::MainWindow(QWidget* parent)
-    : QMainWindow(parent), game_controller(nullptr), stacked_widget(nullptr),
+    : QMainWindow(parent), game_controller(nullptr), stacked_widget(nullptr), content_layout(nullptr),
       config_widget(nullptr), game_board_widget(nullptr), question_dialog(nullptr),
-      team_widget(nullptr), score_label(nullptr), mode_toggle_button(nullptr) {
+      team_widget(nullptr), pixmap_cache(nullptr), clue_document_cache(nullptr),
+      animation_clock(nullptr), idle_monitor(nullptr), autosave_service(nullptr), collaboration_session(nullptr), scoreboard_server(nullptr), score_timeline_widget(nullptr), memory_report_widget(nullptr),
+      board_render_cache(nullptr), presenter_window(nullptr), score_label(nullptr), mode_toggle_button(nullptr), first_frame_painted(false), host_mode(false) {
     
     setStyleSheet("background-color: #1a1a2e; color: white;");
     resize(1200, 800);
     setWindowTitle("Jacko's Jeopardy");
     
     game_controller = new GameController(this);
-    team_widget = new TeamWidget(game_controller, this);   
+    // Lays out every clue when a game starts, so opening one only has to paint it
+    clue_document_cache = new ClueDocumentCache(game_controller, QuestionDialog::clue_font(),
+                                                QuestionDialog::clue_text_width(), this);
+    // Idle until something animates; every effect shares its frame tick
+    animation_clock = new AnimationClock(this);
+    idle_monitor = new IdleMonitor(animation_clock, this);
+    
+    // Restore before any view is built so the config grid is only laid out once
+    autosave_service = new AutosaveService(game_controller, AutosaveService::default_path(), this);
+    autosave_service->restore();
+    collaboration_session = new CollaborationSession(game_controller, this);
+    
     setup_ui();
     setup_menu();
     create_widgets();
     setup_connections();
 }
 
+MainWindow::~MainWindow() {
+    // The lazily built views stop their effects on the clock as they go, but
+    // children are deleted in creation order and the clock comes first
+    delete question_dialog;
+    question_dialog = nullptr;
+    delete team_widget;
+    team_widget = nullptr;
+}
+
 void MainWindow::setup_ui() {
     QWidget* central_widget = new QWidget;
     setCentralWidget(central_widget);
@@ -44,15 +82,11 @@ void MainWindow::setup_ui() {
     status_layout->addStretch();
     status_layout->addWidget(mode_toggle_button);
     
-    QHBoxLayout* content_layout = new QHBoxLayout;
+    content_layout = new QHBoxLayout;
     
     stacked_widget = new QStackedWidget;
     
-    team_widget->setMaximumWidth(250);
-    team_widget->setStyleSheet("background-color: #16213e; border: 1px solid #0f3460; border-radius: 8px;");
-    
     content_layout->addWidget(stacked_widget, 3);  
-    content_layout->addWidget(team_widget, 1);     
     
     main_layout->addLayout(status_layout);
     main_layout->addLayout(content_layout);
@@ -67,11 +101,21 @@ void MainWindow::setup_menu() {
     QAction* config_action = new QAction("Configure Board", this);
     QAction* start_game_action = new QAction("Start Game", this);
     QAction* reset_action = new QAction("Reset Game", this);
+    QAction* timeline_action = new QAction("Score Timeline", this);
+    QAction* presenter_action = new QAction("Presenter View", this);
+    QAction* host_mode_action = new QAction("Keyboard Host Mode", this);
+    host_mode_action->setCheckable(true);
+    host_mode_action->setShortcut(QKeySequence(Qt::Key_F2));
     
     game_menu->addAction(config_action);
     game_menu->addAction(start_game_action);
     game_menu->addSeparator();
     game_menu->addAction(reset_action);
+    game_menu->addSeparator();
+    game_menu->addAction(timeline_action);
+    game_menu->addAction(presenter_action);
+    game_menu->addSeparator();
+    game_menu->addAction(host_mode_action);
     
     connect(config_action, &QAction::triggered, [this]() {
         game_controller->start_config_mode();
@@ -84,20 +128,321 @@ void MainWindow::setup_menu() {
     connect(reset_action, &QAction::triggered, [this]() {
         game_controller->reset_game();
     });
+    
+    connect(timeline_action, &QAction::triggered, [this]() {
+        ScoreTimelineWidget* timeline = ensure_score_timeline_widget();
+        timeline->show();
+        timeline->raise();
+    });
+    
+    connect(host_mode_action, &QAction::toggled, [this](bool checked) {
+        host_mode = checked;
+        if (question_dialog) {
+            question_dialog->set_host_mode(checked);
+        }
+        if (game_board_widget) {
+            game_board_widget->setFocus();
+        }
+    });
+    
+    connect(presenter_action, &QAction::triggered, [this]() {
+        PresenterWindow* presenter = ensure_presenter_window();
+        presenter->show();
+        presenter->raise();
+    });
+    
+    QMenu* collaborate_menu = menu_bar->addMenu("Collaborate");
+    
+    QAction* host_session_action = new QAction("Host Session...", this);
+    QAction* join_session_action = new QAction("Join Session...", this);
+    QAction* leave_session_action = new QAction("Leave Session", this);
+    QAction* session_status_action = new QAction("Not connected", this);
+    session_status_action->setEnabled(false);
+    leave_session_action->setEnabled(false);
+    
+    collaborate_menu->addAction(host_session_action);
+    collaborate_menu->addAction(join_session_action);
+    collaborate_menu->addAction(leave_session_action);
+    collaborate_menu->addSeparator();
+    collaborate_menu->addAction(session_status_action);
+    
+    connect(host_session_action, &QAction::triggered, [this]() {
+        bool ok = false;
+        const QStringList interfaces = {"Local network", "This computer only"};
+        QString reach = QInputDialog::getItem(this, "Host Session", "Accept editors from:", interfaces, 0, false, &ok);
+        if (!ok) return;
+        int port = QInputDialog::getInt(this, "Host Session", "Port:", CollaborationSession::DEFAULT_PORT, 1, 65535, 1, &ok);
+        QHostAddress address = reach == interfaces[1] ? QHostAddress(QHostAddress::LocalHost) : QHostAddress(QHostAddress::Any);
+        QString error;
+        if (ok && !collaboration_session->host(static_cast<quint16>(port), address, &error)) {
+            QMessageBox::warning(this, "Host Session", QString("Could not listen on port %1: %2").arg(port).arg(error));
+        }
+    });
+    
+    connect(join_session_action, &QAction::triggered, [this]() {
+        bool ok = false;
+        QString address = QInputDialog::getText(this, "Join Session", "Host (name:port):", QLineEdit::Normal,
+                                                QString("localhost:%1").arg(CollaborationSession::DEFAULT_PORT), &ok);
+        if (!ok || address.trimmed().isEmpty()) return;
+        QString host_name = address.section(':', 0, 0).trimmed();
+        quint16 port = address.contains(':') ? address.section(':', 1).toUShort() : CollaborationSession::DEFAULT_PORT;
+        collaboration_session->join(host_name, port ? port : CollaborationSession::DEFAULT_PORT);
+    });
+    
+    connect(leave_session_action, &QAction::triggered, [this]() {
+        collaboration_session->leave();
+    });
+    
+    connect(collaboration_session, &CollaborationSession::peers_changed, this,
+            [this, leave_session_action, session_status_action](int count) {
+        leave_session_action->setEnabled(collaboration_session->is_active());
+        if (!collaboration_session->is_active()) {
+            session_status_action->setText("Not connected");
+        } else if (collaboration_session->is_host()) {
+            session_status_action->setText(QString("Hosting on port %1, %2 editor(s) joined")
+                                               .arg(collaboration_session->get_port()).arg(count));
+        } else {
+            session_status_action->setText(count > 0 ? "Joined" : "Disconnected from host");
+        }
+    });
+    
+    connect(collaboration_session, &CollaborationSession::session_error, this, [this](const QString& message) {
+        QMessageBox::warning(this, "Collaborate", message);
+    });
+    
+    QAction* scoreboard_action = new QAction("Serve Scoreboard", this);
+    scoreboard_action->setCheckable(true);
+    collaborate_menu->addSeparator();
+    collaborate_menu->addAction(scoreboard_action);
+    
+    connect(scoreboard_action, &QAction::triggered, [this, scoreboard_action](bool checked) {
+        if (!checked) {
+            scoreboard_server->stop();
+            scoreboard_action->setText("Serve Scoreboard");
+            return;
+        }
+        bool ok = false;
+        int port = QInputDialog::getInt(this, "Serve Scoreboard", "Port:", ScoreboardServer::DEFAULT_PORT, 1, 65535, 1, &ok);
+        if (!scoreboard_server) {
+            scoreboard_server = new ScoreboardServer(game_controller, this);
+        }
+        QString error;
+        if (!ok || !scoreboard_server->start(static_cast<quint16>(port), &error)) {
+            if (ok) {
+                QMessageBox::warning(this, "Serve Scoreboard", QString("Could not listen on port %1: %2").arg(port).arg(error));
+            }
+            scoreboard_action->setChecked(false);
+            return;
+        }
+        scoreboard_action->setText(QString("Serve Scoreboard (http://<this computer>:%1/state)").arg(scoreboard_server->get_port()));
+    });
+    
+    QMenu* debug_menu = menu_bar->addMenu("Debug");
+    
+    QAction* tracing_action = new QAction("Enable Tracing", this);
+    tracing_action->setCheckable(true);
+    tracing_action->setChecked(tracer::enabled());
+    QAction* export_trace_action = new QAction("Export Trace...", this);
+    QAction* memory_report_action = new QAction("Memory Report", this);
+    QAction* frame_stats_action = new QAction("Frame Stats", this);
+    QAction* idle_check_action = new QAction("Idle Check", this);
+    
+    debug_menu->addAction(tracing_action);
+    debug_menu->addAction(export_trace_action);
+    debug_menu->addSeparator();
+    debug_menu->addAction(memory_report_action);
+    debug_menu->addAction(frame_stats_action);
+    debug_menu->addAction(idle_check_action);
+    
+    connect(tracing_action, &QAction::toggled, [](bool checked) {
+        tracer::set_enabled(checked);
+    });
+    
+    connect(export_trace_action, &QAction::triggered, [this]() {
+        QString path = QFileDialog::getSaveFileName(this, "Export Trace", "jpdy_trace.json", "Chrome Trace (*.json)");
+        if (!path.isEmpty() && !tracer::export_chrome_trace(path.toStdString())) {
+            QMessageBox::warning(this, "Export Trace", QString("Could not write %1").arg(path));
+        }
+    });
+    
+    connect(frame_stats_action, &QAction::triggered, [this]() {
+        const animation_frame_stats& stats = animation_clock->frame_stats();
+        QMessageBox::information(this, "Frame Stats",
+            QString("Animation frames: %1 (%2 late, worst gap %3 ms)\nCost per frame: %4 ms average, %5 ms worst\n"
+                    "Active effects: %6\n\nKey to paint: %7 presses, %8 ms average, %9 ms worst, %10 over one frame")
+                .arg(stats.frames).arg(stats.late_frames).arg(stats.worst_interval_ms, 0, 'f', 1)
+                .arg(stats.average_cost_ms(), 0, 'f', 3).arg(stats.worst_cost_ms, 0, 'f', 3)
+                .arg(animation_clock->active_count())
+                .arg(host_latency.sample_count()).arg(host_latency.average(), 0, 'f', 2)
+                .arg(host_latency.worst(), 0, 'f', 2).arg(host_latency.over_budget_count()));
+        animation_clock->reset_frame_stats();
+        host_latency.reset();
+    });
+    
+    connect(idle_check_action, &QAction::triggered, [this]() {
+        if (idle_monitor->is_measuring()) return;
+        connect(idle_monitor, &IdleMonitor::finished, this, [this](const idle_report& report) {
+            QMessageBox::information(this, "Idle Check", QString::fromStdString(report.to_text()));
+        }, Qt::SingleShotConnection);
+        // Leave the mouse alone while this runs; hover repaints count as wakeups
+        idle_monitor->measure(IDLE_CHECK_MS);
+    });
+    
+    connect(memory_report_action, &QAction::triggered, [this]() {
+        MemoryReportWidget* report = ensure_memory_report_widget();
+        report->show();
+        report->raise();
+    });
 }
 
 void MainWindow::create_widgets() {
+    TRACE_SCOPE("MainWindow::create_widgets");
     config_widget = new ConfigWidget(game_controller, this);
-    game_board_widget = new GameBoardWidget(game_controller, this);
-    question_dialog = new QuestionDialog(game_controller, this);
     
     stacked_widget->addWidget(config_widget);
-    stacked_widget->addWidget(game_board_widget);
     
     // Set initial widget
     stacked_widget->setCurrentWidget(config_widget);
 }
 
+GameBoardWidget* MainWindow::ensure_game_board_widget() {
+    if (!game_board_widget) {
+        TRACE_SCOPE("MainWindow::ensure_game_board_widget");
+        game_board_widget = new GameBoardWidget(game_controller, ensure_board_render_cache(), BoardAudience::AUDIENCE, this);
+        game_board_widget->set_input_latency(&host_latency);
+        stacked_widget->addWidget(game_board_widget);
+        connect(game_board_widget, &GameBoardWidget::cell_selected, this, &MainWindow::show_question_dialog);
+        connect(game_board_widget, &GameBoardWidget::cell_hovered, this, &MainWindow::prefetch_column_media);
+    }
+    return game_board_widget;
+}
+
+QuestionDialog* MainWindow::ensure_question_dialog() {
+    if (!question_dialog) {
+        TRACE_SCOPE("MainWindow::ensure_question_dialog");
+        question_dialog = new QuestionDialog(game_controller, ensure_pixmap_cache(), clue_document_cache, animation_clock,
+                                             this);
+        question_dialog->set_input_latency(&host_latency);
+        question_dialog->set_host_mode(host_mode);
+    }
+    return question_dialog;
+}
+
+TeamWidget* MainWindow::ensure_team_widget() {
+    if (!team_widget) {
+        TRACE_SCOPE("MainWindow::ensure_team_widget");
+        team_widget = new TeamWidget(game_controller, animation_clock, this);
+        team_widget->setMinimumWidth(260);
+        team_widget->setMaximumWidth(360);
+        team_widget->setStyleSheet("background-color: #16213e; border: 1px solid #0f3460; border-radius: 8px;");
+        content_layout->addWidget(team_widget, 1);
+    }
+    return team_widget;
+}
+
+PixmapCache* MainWindow::ensure_pixmap_cache() {
+    if (!pixmap_cache) {
+        pixmap_cache = new PixmapCache(this);
+        // An edit may point a clue at a fixed or replaced file, so give failed paths another try
+        connect(game_controller, &GameController::board_reset, pixmap_cache, &PixmapCache::clear_failures);
+        connect(game_controller, &GameController::board_changes_committed, pixmap_cache, &PixmapCache::clear_failures);
+    }
+    return pixmap_cache;
+}
+
+ScoreTimelineWidget* MainWindow::ensure_score_timeline_widget() {
+    if (!score_timeline_widget) {
+        TRACE_SCOPE("MainWindow::ensure_score_timeline_widget");
+        // Separate top-level window so it can sit on a second screen
+        score_timeline_widget = new ScoreTimelineWidget(game_controller, this);
+        score_timeline_widget->setWindowFlag(Qt::Window);
+        score_timeline_widget->resize(720, 400);
+    }
+    return score_timeline_widget;
+}
+
+BoardRenderCache* MainWindow::ensure_board_render_cache() {
+    if (!board_render_cache) {
+        board_render_cache = new BoardRenderCache(this);
+    }
+    return board_render_cache;
+}
+
+PresenterWindow* MainWindow::ensure_presenter_window() {
+    if (!presenter_window) {
+        TRACE_SCOPE("MainWindow::ensure_presenter_window");
+        presenter_window = new PresenterWindow(game_controller, ensure_board_render_cache(), this);
+        presenter_window->setWindowFlag(Qt::Window);
+        presenter_window->resize(1200, 700);
+        GameBoardWidget* presenter_board = presenter_window->get_board_widget();
+        connect(presenter_board, &GameBoardWidget::cell_selected, this, &MainWindow::show_question_dialog);
+        connect(presenter_board, &GameBoardWidget::cell_hovered, this, &MainWindow::prefetch_column_media);
+    }
+    return presenter_window;
+}
+
+MemoryReportWidget* MainWindow::ensure_memory_report_widget() {
+    if (!memory_report_widget) {
+        memory_report_widget = new MemoryReportWidget([this]() { return collect_memory_report(); }, this);
+        memory_report_widget->setWindowFlag(Qt::Window);
+    }
+    return memory_report_widget;
+}
+
+memory_report MainWindow::collect_memory_report() const {
+    TRACE_SCOPE("MainWindow::collect_memory_report");
+    memory_report report;
+    
+    const board* board = game_controller->get_board();
+    report.add("board cells", board->cell_memory());
+    report.add("board text", board->text_memory());
+    if (const play_board* play = game_controller->get_play_board()) {
+        report.add("play board", play->memory());
+    }
+    
+    memory_usage teams;
+    for (const auto& team_entry : game_controller->get_teams()) {
+        ++teams.objects;
+        teams.bytes += sizeof(team_entry) + team_entry.heap_bytes();
+    }
+    report.add("teams and score history", teams);
+    
+    if (pixmap_cache) {
+        report.add("pixmap cache", {static_cast<size_t>(pixmap_cache->cached_count()),
+                                    static_cast<size_t>(pixmap_cache->used_bytes())});
+    }
+    if (board_render_cache) {
+        report.add("board render cache", {static_cast<size_t>(board_render_cache->cached_count()),
+                                          static_cast<size_t>(board_render_cache->used_bytes())});
+    }
+    
+    // Widget sizes are opaque, so views report how many widgets they keep alive
+    auto count_widgets = [&report](const char* view, const QWidget* widget) {
+        if (widget) {
+            report.add_count(view, static_cast<size_t>(widget->findChildren<QWidget*>().size()) + 1);
+        }
+    };
+    count_widgets("widgets: config", config_widget);
+    count_widgets("widgets: game board", game_board_widget);
+    count_widgets("widgets: question dialog", question_dialog);
+    count_widgets("widgets: team panel", team_widget);
+    count_widgets("widgets: score timeline", score_timeline_widget);
+    count_widgets("widgets: presenter", presenter_window);
+    
+    report.add_count("active animation effects", animation_clock->active_count());
+    report.add_count("graphics effects", static_cast<size_t>(findChildren<QGraphicsEffect*>().size()));
+    return report;
+}
+
+void MainWindow::paintEvent(QPaintEvent* event) {
+    QMainWindow::paintEvent(event);
+    if (!first_frame_painted) {
+        first_frame_painted = true;
+        TRACE_INSTANT("MainWindow::first_frame");
+        emit first_frame_shown();
+    }
+}
+
 void MainWindow::setup_connections() {
     connect(game_controller, &GameController::mode_changed, this, &MainWindow::on_mode_changed);
     connect(game_controller, &GameController::score_changed, this, &MainWindow::on_score_changed);
@@ -105,28 +450,25 @@ void MainWindow::setup_connections() {
         on_score_changed(current_team.get_score());
     });
     connect(mode_toggle_button, &QPushButton::clicked, this, &MainWindow::toggle_mode);
-    connect(game_board_widget, &GameBoardWidget::cell_selected, this, &MainWindow::show_question_dialog);
-    
-    connect(game_controller, &GameController::score_changed, [this](int) {
-        if (team_widget->isVisible()) {
-            team_widget->on_teams_updated();
-        }
-    });
 }
 
 void MainWindow::on_mode_changed(GameMode new_mode) {
+    TRACE_SCOPE("MainWindow::on_mode_changed");
     switch (new_mode) {
         case GameMode::CONFIG:
             stacked_widget->setCurrentWidget(config_widget);
             mode_toggle_button->setText("Start Game");
             score_label->setVisible(false);
-            team_widget->setVisible(false);
+            if (team_widget) {
+                team_widget->setVisible(false);
+            }
             break;
         case GameMode::PLAYING:
-            stacked_widget->setCurrentWidget(game_board_widget);
+            stacked_widget->setCurrentWidget(ensure_game_board_widget());
+            game_board_widget->setFocus();
             mode_toggle_button->setText("Configure Board");
             score_label->setVisible(true);
-            team_widget->setVisible(true);
+            ensure_team_widget()->setVisible(true);
             team_widget->update_teams();  // Refresh team display when game starts
             break;
     }
@@ -134,7 +476,7 @@ void MainWindow::on_mode_changed(GameMode new_mode) {
 
 void MainWindow::on_score_changed(int new_score) {
     const team& current_team = game_controller->get_current_team();
-    score_label->setText(QString("%1: $%2").arg(QString::fromStdString(current_team.get_name())).arg(new_score));
+    score_label->setText(QString("%1: $%2").arg(current_team.get_name_text().qstr()).arg(new_score));
 }
 
 void MainWindow::toggle_mode() {
@@ -146,6 +488,18 @@ void MainWindow::toggle_mode() {
 }
 
 void MainWindow::show_question_dialog(size_t row, size_t col) {
-    question_dialog->show_question(row, col);
+    {
+        TRACE_SCOPE("MainWindow::show_question_dialog");
+        ensure_question_dialog()->show_question(row, col);
+    }
+    TRACE_INSTANT("QuestionDialog::exec");
     question_dialog->exec();
 }
+
+void MainWindow::prefetch_column_media(size_t row, size_t col) {
+    Q_UNUSED(row);
+    const play_board* board = game_controller->get_play_board();
+    if (board) {
+        ensure_pixmap_cache()->prefetch_column(*board, col, QuestionDialog::media_size());
+    }
+}
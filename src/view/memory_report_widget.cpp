@@ -0,0 +1,37 @@
+#include "view/memory_report_widget.h"
+#include <QVBoxLayout>
+#include <QFontDatabase>
+#include "util/trace.h"
+
+MemoryReportWidget::MemoryReportWidget(sampler sample, QWidget* parent)
+    : QWidget(parent), sample(std::move(sample)), report_text(nullptr), refresh_timer(this) {
+    setWindowTitle("Memory Report");
+    resize(560, 360);
+    
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    report_text = new QPlainTextEdit;
+    report_text->setReadOnly(true);
+    report_text->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    report_text->setStyleSheet("background-color: #16213e; color: white; border: 2px solid #0f3460;");
+    layout->addWidget(report_text);
+    
+    refresh_timer.setInterval(REFRESH_INTERVAL_MS);
+    connect(&refresh_timer, &QTimer::timeout, this, &MemoryReportWidget::refresh);
+}
+
+void MemoryReportWidget::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    refresh();
+    refresh_timer.start();
+}
+
+void MemoryReportWidget::hideEvent(QHideEvent* event) {
+    QWidget::hideEvent(event);
+    // Nothing is sampled while the window is closed
+    refresh_timer.stop();
+}
+
+void MemoryReportWidget::refresh() {
+    TRACE_SCOPE("MemoryReportWidget::refresh");
+    report_text->setPlainText(QString::fromStdString(sample().to_text()));
+}
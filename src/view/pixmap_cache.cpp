@@ -0,0 +1,117 @@
+#include "view/pixmap_cache.h"
+#include <QImageReader>
+#include <QMetaObject>
+#include "util/trace.h"
+
+PixmapCache::PixmapCache(QObject* parent)
+    : QObject(parent) {
+    cache.setMaxCost(DEFAULT_BUDGET_BYTES);
+    decode_pool.setMaxThreadCount(DECODE_THREADS);
+}
+
+PixmapCache::~PixmapCache() {
+    // Queued results for this object are dropped once it is destroyed
+    decode_pool.clear();
+    decode_pool.waitForDone();
+}
+
+QString PixmapCache::cache_key(const QString& path, const QSize& target_size) {
+    return QString("%1@%2x%3").arg(path).arg(target_size.width()).arg(target_size.height());
+}
+
+QPixmap PixmapCache::request(const QString& path, const QSize& target_size) {
+    TRACE_SCOPE("PixmapCache::request");
+    if (path.isEmpty() || failed_paths.contains(path)) return QPixmap();
+
+    QString key = cache_key(path, target_size);
+    if (QPixmap* cached = cache.object(key)) {
+        return *cached;
+    }
+    start_decode(key, path, target_size);
+    return QPixmap();
+}
+
+void PixmapCache::prefetch(const QString& path, const QSize& target_size) {
+    if (path.isEmpty() || failed_paths.contains(path)) return;
+
+    QString key = cache_key(path, target_size);
+    if (!cache.contains(key)) {
+        start_decode(key, path, target_size);
+    }
+}
+
+void PixmapCache::prefetch_column(const play_board& game_board, size_t col, const QSize& target_size) {
+    TRACE_SCOPE("PixmapCache::prefetch_column");
+    for (size_t row = 0; row < game_board.get_rows(); ++row) {
+        if (!game_board.is_valid_position(row, col)) continue;
+
+        if (!game_board.is_revealed(row, col) && game_board.get_media_type(row, col) == MediaType::IMAGE) {
+            prefetch(game_board.get_media_path_text(row, col).qstr(), target_size);
+        }
+    }
+}
+
+void PixmapCache::clear_failures() {
+    failed_paths.clear();
+}
+
+void PixmapCache::start_decode(const QString& key, const QString& path, const QSize& target_size) {
+    if (pending_keys.contains(key)) return;
+    pending_keys.insert(key);
+
+    decode_pool.start([this, key, path, target_size]() {
+        TRACE_SCOPE("PixmapCache::decode");
+        QImageReader reader(path);
+        reader.setAutoTransform(true);
+
+        // Decode straight to the display size so full-resolution frames never stay resident
+        QSize source_size = reader.size();
+        if (source_size.isValid() && (source_size.width() > target_size.width() ||
+                                      source_size.height() > target_size.height())) {
+            reader.setScaledSize(source_size.scaled(target_size, Qt::KeepAspectRatio));
+        }
+
+        QImage image = reader.read();
+        if (!image.isNull() && (image.width() > target_size.width() || image.height() > target_size.height())) {
+            image = image.scaled(target_size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+
+        QMetaObject::invokeMethod(this, [this, key, path, target_size, image]() {
+            on_decoded(key, path, target_size, image);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void PixmapCache::on_decoded(const QString& key, const QString& path, const QSize& target_size, const QImage& image) {
+    TRACE_SCOPE("PixmapCache::on_decoded");
+    pending_keys.remove(key);
+
+    if (image.isNull()) {
+        // A missing or corrupt file fails at every size, so remember the path rather than the key
+        failed_paths.insert(path);
+        emit decode_failed(path);
+        return;
+    }
+
+    QPixmap pixmap = QPixmap::fromImage(image);
+    qint64 cost = static_cast<qint64>(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+    // An image larger than the whole budget is still delivered, just not retained
+    cache.insert(key, new QPixmap(pixmap), cost);
+    emit pixmap_ready(path, target_size, pixmap);
+}
+
+void PixmapCache::set_budget_bytes(qint64 bytes) {
+    cache.setMaxCost(bytes);
+}
+
+qint64 PixmapCache::budget_bytes() const {
+    return cache.maxCost();
+}
+
+qint64 PixmapCache::used_bytes() const {
+    return cache.totalCost();
+}
+
+int PixmapCache::cached_count() const {
+    return static_cast<int>(cache.count());
+}
@@ -0,0 +1,102 @@
+#include "view/presenter_window.h"
+#include "view/game_board_widget.h"
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include "util/trace.h"
+
+PresenterWindow::PresenterWindow(GameController* controller, BoardRenderCache* render_cache, QWidget* parent)
+    : QWidget(parent), game_controller(controller), board_widget(nullptr), current_team_label(nullptr),
+      scores_label(nullptr), question_label(nullptr), answer_label(nullptr) {
+    setWindowTitle("Presenter View");
+    setStyleSheet("background-color: #1a1a2e; color: white;");
+    setup_ui(render_cache);
+    
+    connect(game_controller, &GameController::cell_selected, this, &PresenterWindow::on_cell_selected);
+    connect(game_controller, &GameController::score_changed, this, [this](int) { refresh_scores(); });
+    connect(game_controller, &GameController::team_changed, this, [this](const team&) { refresh_scores(); });
+    connect(game_controller, &GameController::team_added, this, [this](size_t) { refresh_scores(); });
+    connect(game_controller, &GameController::team_renamed, this, [this](size_t) { refresh_scores(); });
+    connect(game_controller, &GameController::mode_changed, this, [this](GameMode) {
+        question_label->clear();
+        answer_label->clear();
+        refresh_scores();
+    });
+}
+
+void PresenterWindow::setup_ui(BoardRenderCache* render_cache) {
+    QHBoxLayout* main_layout = new QHBoxLayout(this);
+    
+    board_widget = new GameBoardWidget(game_controller, render_cache, BoardAudience::PRESENTER);
+    main_layout->addWidget(board_widget, 3);
+    
+    QVBoxLayout* side_layout = new QVBoxLayout;
+    
+    current_team_label = new QLabel;
+    current_team_label->setStyleSheet("font-size: 18px; font-weight: bold; color: #ffd700;");
+    
+    scores_label = new QLabel;
+    scores_label->setStyleSheet("font-size: 14px;");
+    scores_label->setTextFormat(Qt::PlainText);
+    
+    QLabel* clue_heading = new QLabel("Current clue");
+    clue_heading->setStyleSheet("font-size: 14px; font-weight: bold; color: #ffd700;");
+    
+    question_label = new QLabel;
+    question_label->setWordWrap(true);
+    question_label->setTextFormat(Qt::PlainText);
+    question_label->setStyleSheet("font-size: 14px;");
+    
+    answer_label = new QLabel;
+    answer_label->setWordWrap(true);
+    answer_label->setTextFormat(Qt::PlainText);
+    answer_label->setStyleSheet("font-size: 14px; color: #87ceeb;");
+    
+    side_layout->addWidget(current_team_label);
+    side_layout->addWidget(scores_label);
+    side_layout->addSpacing(20);
+    side_layout->addWidget(clue_heading);
+    side_layout->addWidget(question_label);
+    side_layout->addWidget(answer_label);
+    side_layout->addStretch();
+    
+    main_layout->addLayout(side_layout, 1);
+}
+
+void PresenterWindow::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    refresh_scores();
+}
+
+void PresenterWindow::refresh_scores() {
+    // Scores are rebuilt on show, so a hidden window skips the per-event work
+    if (isHidden()) return;
+    
+    TRACE_SCOPE("PresenterWindow::refresh_scores");
+    const auto& teams = game_controller->get_teams();
+    QString scores;
+    for (size_t team_index : game_controller->get_top_teams(STANDINGS_SHOWN)) {
+        const team& team_entry = teams[team_index];
+        scores += QString("%1. %2: $%3\n")
+                      .arg(game_controller->get_team_rank(team_index))
+                      .arg(team_entry.get_name_text().qstr())
+                      .arg(team_entry.get_score());
+    }
+    scores_label->setText(scores.trimmed());
+    if (!teams.empty()) {
+        size_t current = game_controller->get_current_team_index();
+        current_team_label->setText(QString("Up: %1 (#%2)")
+                                        .arg(teams[current].get_name_text().qstr())
+                                        .arg(game_controller->get_team_rank(current)));
+    }
+}
+
+void PresenterWindow::on_cell_selected(size_t row, size_t col) {
+    const play_board* board = game_controller->get_play_board();
+    if (!board || !board->is_valid_position(row, col)) return;
+    
+    question_label->setText(QString("%1 for $%2\n%3")
+                                .arg(board->get_category_text(col).qstr())
+                                .arg(board->get_points(row, col))
+                                .arg(board->get_question_text(row, col).qstr()));
+    answer_label->setText(board->get_answer_text(row, col).qstr());
+}
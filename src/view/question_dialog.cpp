@@ -1,11 +1,27 @@
 #include "view/question_dialog.h"
+#include "view/clue_document_cache.h"
+#include <QApplication>
 #include <stdexcept>
+#include <QDesktopServices>
+#include <QFileInfo>
+#include <QUrl>
+#include "util/input_latency.h"
+#include "util/trace.h"
+#include "util/log.h"
 
-QuestionDialog::QuestionDialog(GameController* controller, QWidget* parent)
-    : QDialog(parent), game_controller(controller), current_row(0), current_col(0), 
-      answer_shown(false), point_stealing_mode(false), animation_manager(nullptr), transition_manager(nullptr) {
+QuestionDialog::QuestionDialog(GameController* controller, PixmapCache* pixmap_cache,
+                               ClueDocumentCache* document_cache, AnimationClock* animation_clock, QWidget* parent)
+    : QDialog(parent), game_controller(controller), pixmap_cache(pixmap_cache), document_cache(document_cache),
+      animation_clock(animation_clock),
+      current_row(0), current_col(0), 
+      answer_shown(false), point_stealing_mode(false), host_mode(false), latency(nullptr),
+      animation_manager(nullptr), transition_manager(nullptr) {
     setup_ui();
     setup_managers();
+    setup_host_shortcuts();
+    
+    connect(pixmap_cache, &PixmapCache::pixmap_ready, this, &QuestionDialog::on_pixmap_ready);
+    connect(pixmap_cache, &PixmapCache::decode_failed, this, &QuestionDialog::on_pixmap_failed);
     setModal(true);
     setStyleSheet("background-color: #1a1a2e; color: white;");
 }
@@ -20,12 +36,22 @@ QuestionDialog::~QuestionDialog() {
     }
 }
 
+QFont QuestionDialog::clue_font() {
+    QFont font = QApplication::font();
+    font.setPixelSize(CLUE_FONT_PIXEL_SIZE);
+    return font;
+}
+
+int QuestionDialog::clue_text_width() {
+    return DIALOG_WIDTH - 2 * CONTENT_MARGIN - 2 * (CLUE_PADDING + CLUE_BORDER);
+}
+
 void QuestionDialog::setup_managers() {
     // Create animation manager
-    animation_manager = new AnimationManager(this, this);
+    animation_manager = new AnimationManager(this, animation_clock, this);
     
     // Create transition manager
-    transition_manager = new DialogTransitionManager(this, this);
+    transition_manager = new DialogTransitionManager(this, animation_clock, this);
     
     // Connect animation signals
     connect(animation_manager, &AnimationManager::correct_animation_finished,
@@ -38,13 +64,52 @@ void QuestionDialog::setup_managers() {
             this, &QuestionDialog::on_transition_finished);
 }
 
+void QuestionDialog::setup_host_shortcuts() {
+    add_host_shortcut(QKeySequence(Qt::Key_Space), &QuestionDialog::host_reveal);
+    add_host_shortcut(QKeySequence(Qt::Key_C), &QuestionDialog::host_correct);
+    add_host_shortcut(QKeySequence(Qt::Key_X), &QuestionDialog::host_incorrect);
+    add_host_shortcut(QKeySequence(Qt::Key_Escape), &QuestionDialog::host_close);
+}
+
+void QuestionDialog::add_host_shortcut(const QKeySequence& key, bool (QuestionDialog::*action)()) {
+    // Shortcuts win over the focused button, so Space never double-fires as a click
+    QShortcut* shortcut = new QShortcut(key, this);
+    shortcut->setEnabled(false);
+    connect(shortcut, &QShortcut::activated, this, [this, action]() {
+        const uint64_t pressed_ns = tracer::now_ns();
+        if ((this->*action)() && latency) {
+            latency->input_received(pressed_ns);
+        }
+    });
+    host_shortcuts.push_back(shortcut);
+}
+
+void QuestionDialog::set_host_mode(bool enabled) {
+    host_mode = enabled;
+    for (QShortcut* shortcut : host_shortcuts) {
+        shortcut->setEnabled(enabled);
+    }
+}
+
+void QuestionDialog::paintEvent(QPaintEvent* event) {
+    QDialog::paintEvent(event);
+    if (latency) {
+        latency->frame_presented();
+    }
+}
+
+void QuestionDialog::hideEvent(QHideEvent* event) {
+    countdown->stop();
+    QDialog::hideEvent(event);
+}
+
 void QuestionDialog::setup_ui() {
-    setFixedSize(600, 500);
+    setFixedSize(DIALOG_WIDTH, DIALOG_HEIGHT);
     setWindowTitle("Jeopardy Question");
     
     main_layout = new QVBoxLayout(this);
     main_layout->setSpacing(20);
-    main_layout->setContentsMargins(30, 30, 30, 30);
+    main_layout->setContentsMargins(CONTENT_MARGIN, CONTENT_MARGIN, CONTENT_MARGIN, CONTENT_MARGIN);
     
     points_label = new QLabel;
     points_label->setStyleSheet(
@@ -58,15 +123,32 @@ void QuestionDialog::setup_ui() {
     );
     category_label->setAlignment(Qt::AlignCenter);
     
+    countdown = new CountdownWidget;
     
-    question_display = new QTextEdit;
-    question_display->setReadOnly(true);
-    question_display->setMinimumHeight(120);
-    question_display->setStyleSheet(
-        "QTextEdit { background-color: #16213e; border: 3px solid #0f3460; "
-        "padding: 15px; font-size: 16px; border-radius: 10px; }"
+    media_label = new QLabel;
+    media_label->setAlignment(Qt::AlignCenter);
+    media_label->setFixedHeight(MEDIA_HEIGHT);
+    media_label->setVisible(false);
+    media_label->setStyleSheet("QLabel { color: #87ceeb; font-size: 16px; }");
+    
+    play_media_button = new QPushButton("Play");
+    play_media_button->setVisible(false);
+    play_media_button->setStyleSheet(
+        "QPushButton { background-color: #16213e; color: white; border: 2px solid #0f3460; "
+        "padding: 10px 20px; border-radius: 5px; font-weight: bold; }"
+        "QPushButton:hover { background-color: #0f3460; }"
     );
     
+    question_display = new ClueTextView;
+    question_display->setMinimumHeight(120);
+    question_display->setFont(clue_font());
+    question_display->setStyleSheet(QString(
+        "ClueTextView { background-color: #16213e; border: %1px solid #0f3460; "
+        "padding: %2px; border-radius: 10px; }"
+    ).arg(CLUE_BORDER).arg(CLUE_PADDING));
+    // Both views share one width, so the question's stands for the pair
+    connect(question_display, &ClueTextView::text_width_changed, document_cache, &ClueDocumentCache::set_text_width);
+    
     
     show_answer_button = new QPushButton("Show Answer");
     show_answer_button->setStyleSheet(
@@ -75,14 +157,14 @@ void QuestionDialog::setup_ui() {
         "QPushButton:hover { background-color: #0f3460; }"
     );
     
-    answer_display = new QTextEdit;
-    answer_display->setReadOnly(true);
+    answer_display = new ClueTextView;
     answer_display->setMinimumHeight(100);
     answer_display->setVisible(false);
-    answer_display->setStyleSheet(
-        "QTextEdit { background-color: #2d4a22; border: 3px solid #4caf50; "
-        "padding: 15px; font-size: 16px; border-radius: 10px; color: #e8f5e8; }"
-    );
+    answer_display->setFont(clue_font());
+    answer_display->setStyleSheet(QString(
+        "ClueTextView { background-color: #2d4a22; border: %1px solid #4caf50; "
+        "padding: %2px; border-radius: 10px; color: #e8f5e8; }"
+    ).arg(CLUE_BORDER).arg(CLUE_PADDING));
     
     button_layout = new QHBoxLayout;
     
@@ -117,6 +199,9 @@ void QuestionDialog::setup_ui() {
     
     main_layout->addWidget(points_label);
     main_layout->addWidget(category_label);
+    main_layout->addWidget(countdown);
+    main_layout->addWidget(media_label);
+    main_layout->addWidget(play_media_button, 0, Qt::AlignCenter);
     main_layout->addWidget(question_display);
     main_layout->addWidget(show_answer_button);
     main_layout->addWidget(answer_display);
@@ -127,6 +212,8 @@ void QuestionDialog::setup_ui() {
     connect(correct_button, &QPushButton::clicked, this, &QuestionDialog::mark_correct);
     connect(incorrect_button, &QPushButton::clicked, this, &QuestionDialog::mark_incorrect);
     connect(close_button, &QPushButton::clicked, this, &QuestionDialog::close_dialog);
+    connect(play_media_button, &QPushButton::clicked, this, &QuestionDialog::play_media);
+    connect(countdown, &CountdownWidget::expired, this, &QuestionDialog::on_countdown_expired);
 }
 
 void QuestionDialog::enable_buttons(bool enabled) {
@@ -151,6 +238,7 @@ void QuestionDialog::reset_ui_state() {
 }
 
 void QuestionDialog::show_question(size_t row, size_t col) {
+    TRACE_SCOPE("QuestionDialog::show_question");
     current_row = row;
     current_col = col;
     
@@ -168,28 +256,83 @@ void QuestionDialog::show_question(size_t row, size_t col) {
     reset_ui_state();
     
     // Load question data
-    const board* board = game_controller->get_board();
-    if (!board) return;
+    const play_board* board = game_controller->get_play_board();
+    if (!board || !board->is_valid_position(row, col)) return;
     
-    const cell& game_cell = board->get_cell(row, col);
     const team& current_team = game_controller->get_current_team();
     
-    points_label->setText(QString("$%1").arg(game_cell.get_points()));
+    points_label->setText(QString("$%1").arg(board->get_points(row, col)));
     category_label->setText(QString("Category: %1 - %2's Turn")
-                            .arg(QString::fromStdString(board->get_category(col)))
-                            .arg(QString::fromStdString(current_team.get_name())));
-    question_display->setText(QString::fromStdString(game_cell.get_question()));
+                            .arg(board->get_category_text(col).qstr())
+                            .arg(current_team.get_name_text().qstr()));
+    question_display->set_document(document_cache->take_question(row, col, board->get_question_text(row, col)));
+    load_media(*board, row, col);
+    
+    // Warm the cache for the pictures the audience is likely to see next
+    pixmap_cache->prefetch_column(*board, col, media_size());
+    
+    countdown->start(game_controller->get_turn_timer_settings().answer_seconds);
+}
+
+void QuestionDialog::load_media(const play_board& board, size_t row, size_t col) {
+    current_media_path = board.get_media_path_text(row, col).qstr();
+    const MediaType media_type = board.get_media_type(row, col);
+    media_label->clear();
+    play_media_button->setVisible(false);
+    
+    switch (media_type) {
+        case MediaType::NONE:
+            media_label->setVisible(false);
+            break;
+        case MediaType::IMAGE: {
+            media_label->setVisible(true);
+            QPixmap pixmap = pixmap_cache->request(current_media_path, media_size());
+            if (pixmap.isNull()) {
+                media_label->setText("Loading picture...");
+            } else {
+                media_label->setPixmap(pixmap);
+            }
+            break;
+        }
+        case MediaType::AUDIO:
+        case MediaType::VIDEO:
+            media_label->setVisible(true);
+            media_label->setText(QString("%1 clue: %2")
+                                 .arg(media_type == MediaType::AUDIO ? "Audio" : "Video")
+                                 .arg(QFileInfo(current_media_path).fileName()));
+            play_media_button->setVisible(true);
+            break;
+    }
+    
+    setFixedSize(DIALOG_WIDTH, media_type != MediaType::NONE ? DIALOG_HEIGHT_WITH_MEDIA : DIALOG_HEIGHT);
+}
+
+void QuestionDialog::on_pixmap_ready(const QString& path, const QSize& target_size, const QPixmap& pixmap) {
+    if (path == current_media_path && target_size == media_size() && !media_label->isHidden()) {
+        media_label->setPixmap(pixmap);
+    }
+}
+
+void QuestionDialog::on_pixmap_failed(const QString& path) {
+    if (path == current_media_path && !media_label->isHidden()) {
+        media_label->setText("Picture could not be loaded");
+    }
+}
+
+void QuestionDialog::play_media() {
+    if (!current_media_path.isEmpty()) {
+        QDesktopServices::openUrl(QUrl::fromLocalFile(current_media_path));
+    }
 }
 
 void QuestionDialog::reveal_answer() {
     if (answer_shown) return;
 
-    const board* board = game_controller->get_board();
+    const play_board* board = game_controller->get_play_board();
     if (!board) return;
 
-    const cell& game_cell = board->get_cell(current_row, current_col);
-
-    answer_display->setText(QString::fromStdString(game_cell.get_answer()));
+    answer_display->set_document(
+        document_cache->take_answer(current_row, current_col, board->get_answer_text(current_row, current_col)));
     answer_display->setVisible(true);
 
     show_answer_button->setVisible(false);
@@ -198,6 +341,8 @@ void QuestionDialog::reveal_answer() {
 }
 
 void QuestionDialog::show_answer() {
+    // The team has answered; the host is judging now
+    countdown->stop();
     reveal_answer();
     correct_button->setVisible(true);
     incorrect_button->setVisible(true);
@@ -205,18 +350,24 @@ void QuestionDialog::show_answer() {
 
 void QuestionDialog::mark_correct() {
     if (!animation_manager || animation_manager->is_animation_in_progress()) return;
+    countdown->stop();
+    
+    if (host_mode) {
+        execute_correct_action();
+        return;
+    }
     
     // Disable buttons during animation
     enable_buttons(false);
     
     // Get points for animation
-    const board* board = game_controller->get_board();
-    int points = board ? board->get_cell(current_row, current_col).get_points() : 0;
+    const play_board* board = game_controller->get_play_board();
+    int points = board ? board->get_points(current_row, current_col) : 0;
     
     try {
         animation_manager->play_correct_animation(points);
     } catch (const std::exception& e) {
-        qWarning("Animation failed, falling back to immediate action: %s", e.what());
+        LOG_WARNING(LogCategory::ANIMATION, "Animation failed, falling back to immediate action: {}", e.what());
         enable_buttons(true);
         execute_correct_action();
     }
@@ -224,18 +375,24 @@ void QuestionDialog::mark_correct() {
 
 void QuestionDialog::mark_incorrect() {
     if (!animation_manager || animation_manager->is_animation_in_progress()) return;
+    countdown->stop();
+    
+    if (host_mode) {
+        execute_incorrect_action();
+        return;
+    }
     
     // Disable buttons during animation
     enable_buttons(false);
     
     // Get points for animation
-    const board* board = game_controller->get_board();
-    int points = board ? board->get_cell(current_row, current_col).get_points() : 0;
+    const play_board* board = game_controller->get_play_board();
+    int points = board ? board->get_points(current_row, current_col) : 0;
     
     try {
         animation_manager->play_incorrect_animation(points);
     } catch (const std::exception& e) {
-        qWarning("Animation failed, falling back to immediate action: %s", e.what());
+        LOG_WARNING(LogCategory::ANIMATION, "Animation failed, falling back to immediate action: {}", e.what());
         enable_buttons(true);
         execute_incorrect_action();
     }
@@ -252,32 +409,27 @@ void QuestionDialog::on_incorrect_animation_finished() {
 }
 
 void QuestionDialog::execute_correct_action() {
-    const board* board = game_controller->get_board();
+    TRACE_SCOPE("QuestionDialog::execute_correct_action");
+    const play_board* board = game_controller->get_play_board();
     if (!board) return;
 
-    int points = board->get_cell(current_row, current_col).get_points();
-    game_controller->add_to_score(points);
+    int points = board->get_points(current_row, current_col);
+    game_controller->add_to_score(points, current_row, current_col);
     game_controller->complete_question(current_row, current_col);  // Mark question as completed
 
     // Automatically reveal the answer when the question is resolved correctly
     reveal_answer();
 
     game_controller->switch_to_next_team();
-    
-    // Start fade-out transition
-    if (transition_manager) {
-        transition_manager->fade_out_and_close();
-    } else {
-        close_dialog();
-    }
+    finish_question();
 }
 
 void QuestionDialog::setup_for_next_team() {
     // Update the display for the new team attempting the question
     const team& current_team = game_controller->get_current_team();
     category_label->setText(QString("Category: %1 - %2's Turn to Steal!")
-                            .arg(QString::fromStdString(game_controller->get_board()->get_category(current_col)))
-                            .arg(QString::fromStdString(current_team.get_name())));
+                            .arg(game_controller->get_play_board()->get_category_text(current_col).qstr())
+                            .arg(current_team.get_name_text().qstr()));
     
     // Reset answer display state - new team shouldn't see the answer yet
     answer_shown = false;
@@ -289,14 +441,17 @@ void QuestionDialog::setup_for_next_team() {
     
     // Re-enable buttons
     enable_buttons(true);
+    
+    countdown->start(game_controller->get_turn_timer_settings().steal_seconds);
 }
 
 void QuestionDialog::execute_incorrect_action() {
-    const board* board = game_controller->get_board();
+    TRACE_SCOPE("QuestionDialog::execute_incorrect_action");
+    const play_board* board = game_controller->get_play_board();
     if (!board) return;
     
-    int points = board->get_cell(current_row, current_col).get_points();
-    game_controller->subtract_from_score(points);
+    int points = board->get_points(current_row, current_col);
+    game_controller->subtract_from_score(points, current_row, current_col);
     game_controller->mark_current_team_attempted(current_row, current_col);
     
     // Check if there are other teams that can attempt this question
@@ -312,20 +467,58 @@ void QuestionDialog::execute_incorrect_action() {
         reveal_answer();
 
         game_controller->switch_to_next_team();  // Move to next team for next question
-        
-        // Start fade-out transition
-        if (transition_manager) {
-            transition_manager->fade_out_and_close();
-        } else {
-            close_dialog();
-        }
+        finish_question();
     }
 }
 
+void QuestionDialog::finish_question() {
+    // Fade out unless the host wants the board back immediately
+    if (transition_manager && !host_mode) {
+        transition_manager->fade_out_and_close();
+    } else {
+        close_dialog();
+    }
+}
+
+bool QuestionDialog::host_reveal() {
+    if (!show_answer_button->isVisible() || !show_answer_button->isEnabled()) return false;
+    show_answer();
+    return true;
+}
+
+bool QuestionDialog::host_correct() {
+    // Hidden buttons stay enabled until the answer is shown
+    if (!correct_button->isVisible() || !correct_button->isEnabled()) return false;
+    if (animation_manager && animation_manager->is_animation_in_progress()) return false;
+    mark_correct();
+    return true;
+}
+
+bool QuestionDialog::host_incorrect() {
+    if (!incorrect_button->isVisible() || !incorrect_button->isEnabled()) return false;
+    if (animation_manager && animation_manager->is_animation_in_progress()) return false;
+    mark_incorrect();
+    return true;
+}
+
+bool QuestionDialog::host_close() {
+    if (!close_button->isEnabled()) return false;
+    close_dialog();
+    return true;
+}
+
 void QuestionDialog::on_transition_finished() {
     close_dialog();
 }
 
+void QuestionDialog::on_countdown_expired() {
+    // Closing the window without judging leaves no turn to time out
+    if (!isVisible()) return;
+    TRACE_INSTANT("QuestionDialog::countdown_expired");
+    mark_incorrect();
+}
+
 void QuestionDialog::close_dialog() {
+    countdown->stop();
     accept();
 }
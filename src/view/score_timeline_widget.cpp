@@ -0,0 +1,170 @@
+#include "view/score_timeline_widget.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <algorithm>
+#include "view/board_render_cache.h"
+#include "util/trace.h"
+
+ScoreTimelineWidget::ScoreTimelineWidget(GameController* controller, QWidget* parent)
+    : QWidget(parent), game_controller(controller), time_span_ms(INITIAL_TIME_SPAN_MS),
+      score_min(-INITIAL_SCORE_SPAN / 2), score_max(INITIAL_SCORE_SPAN) {
+    setWindowTitle("Score Timeline");
+    setMinimumSize(480, 300);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    
+    connect(game_controller, &GameController::score_event_recorded, this, &ScoreTimelineWidget::on_score_event_recorded);
+    connect(game_controller, &GameController::scores_reset, this, &ScoreTimelineWidget::on_scores_reset);
+}
+
+void ScoreTimelineWidget::reset_ranges() {
+    time_span_ms = INITIAL_TIME_SPAN_MS;
+    score_min = -INITIAL_SCORE_SPAN / 2;
+    score_max = INITIAL_SCORE_SPAN;
+}
+
+QPointF ScoreTimelineWidget::to_pixel(const QPointF& point) const {
+    qreal plot_width = width() - 2 * MARGIN;
+    qreal plot_height = height() - 2 * MARGIN;
+    qreal x = MARGIN + point.x() / static_cast<qreal>(time_span_ms) * plot_width;
+    qreal y = height() - MARGIN - (point.y() - score_min) / static_cast<qreal>(score_max - score_min) * plot_height;
+    return QPointF(x, y);
+}
+
+bool ScoreTimelineWidget::fits(int64_t time_ms, int score) const {
+    return time_ms <= time_span_ms && score >= score_min && score <= score_max;
+}
+
+void ScoreTimelineWidget::grow_to_fit(int64_t time_ms, int score) {
+    // Doubling keeps full rebuilds logarithmic in the length of the game
+    while (time_ms > time_span_ms) {
+        time_span_ms *= 2;
+    }
+    while (score > score_max) {
+        score_max += score_max - score_min;
+    }
+    while (score < score_min) {
+        score_min -= score_max - score_min;
+    }
+}
+
+void ScoreTimelineWidget::draw_axes(QPainter& painter) const {
+    painter.fillRect(QRect(0, 0, width(), height()), QColor("#1a1a2e"));
+    painter.setPen(QPen(QColor("#0f3460"), 1));
+    
+    QPointF origin = to_pixel(QPointF(0, 0));
+    painter.drawLine(QPointF(MARGIN, origin.y()), QPointF(width() - MARGIN, origin.y()));
+    painter.drawLine(QPointF(MARGIN, MARGIN), QPointF(MARGIN, height() - MARGIN));
+    
+    painter.setPen(QColor("#87ceeb"));
+    painter.drawText(QRectF(0, MARGIN - 20, MARGIN * 3, 16), Qt::AlignLeft, QString("$%1").arg(score_max));
+    painter.drawText(QRectF(0, height() - MARGIN + 4, MARGIN * 3, 16), Qt::AlignLeft, QString("$%1").arg(score_min));
+    painter.drawText(QRectF(width() - MARGIN - 100, height() - MARGIN + 4, 100, 16), Qt::AlignRight,
+                     QString("%1 min").arg(time_span_ms / 60000.0, 0, 'f', 1));
+}
+
+QRectF ScoreTimelineWidget::draw_step(QPainter& painter, size_t team_index, const QPointF& from, const QPointF& to) const {
+    QPointF start = to_pixel(from);
+    QPointF corner = to_pixel(QPointF(to.x(), from.y()));
+    QPointF end = to_pixel(to);
+    
+    painter.setPen(QPen(BoardRenderCache::team_color(team_index), 2));
+    painter.drawLine(start, corner);
+    painter.drawLine(corner, end);
+    
+    QRectF bounds = QRectF(start, end).normalized().united(QRectF(corner, corner));
+    return bounds.adjusted(-2, -2, 2, 2);
+}
+
+void ScoreTimelineWidget::rebuild_canvas() {
+    TRACE_SCOPE("ScoreTimelineWidget::rebuild_canvas");
+    if (width() <= 2 * MARGIN || height() <= 2 * MARGIN) return;
+    
+    qreal ratio = devicePixelRatioF();
+    canvas = QPixmap(size() * ratio);
+    canvas.setDevicePixelRatio(ratio);
+    
+    const auto& teams = game_controller->get_teams();
+    last_points.assign(teams.size(), QPointF(0, 0));
+    
+    // Make sure every retained point fits before painting anything
+    for (const auto& team : teams) {
+        const auto& history = team.get_history();
+        for (size_t i = 0; i < history.size(); ++i) {
+            grow_to_fit(history.at(i).timestamp_ms, history.at(i).score);
+        }
+    }
+    
+    QPainter painter(&canvas);
+    painter.setRenderHint(QPainter::Antialiasing);
+    draw_axes(painter);
+    
+    for (size_t team_index = 0; team_index < teams.size(); ++team_index) {
+        const auto& history = teams[team_index].get_history();
+        if (history.empty()) continue;
+        
+        // When the ring has wrapped, the series starts at its oldest retained event
+        const score_event& oldest = history.at(0);
+        QPointF previous = history.first_sequence() == 0
+            ? QPointF(0, 0)
+            : QPointF(static_cast<qreal>(oldest.timestamp_ms), oldest.score - oldest.delta);
+        for (size_t i = 0; i < history.size(); ++i) {
+            QPointF point(static_cast<qreal>(history.at(i).timestamp_ms), history.at(i).score);
+            draw_step(painter, team_index, previous, point);
+            previous = point;
+        }
+        last_points[team_index] = previous;
+    }
+}
+
+void ScoreTimelineWidget::on_score_event_recorded(size_t team_index, const score_event& event) {
+    TRACE_SCOPE("ScoreTimelineWidget::on_score_event_recorded");
+    if (canvas.isNull() || !fits(event.timestamp_ms, event.score) || team_index >= last_points.size()) {
+        grow_to_fit(event.timestamp_ms, event.score);
+        rebuild_canvas();
+        update();
+        return;
+    }
+    
+    QPointF point(static_cast<qreal>(event.timestamp_ms), event.score);
+    QPainter painter(&canvas);
+    painter.setRenderHint(QPainter::Antialiasing);
+    QRectF dirty = draw_step(painter, team_index, last_points[team_index], point);
+    last_points[team_index] = point;
+    update(dirty.toAlignedRect());
+}
+
+void ScoreTimelineWidget::on_scores_reset() {
+    reset_ranges();
+    rebuild_canvas();
+    update();
+}
+
+void ScoreTimelineWidget::resizeEvent(QResizeEvent* event) {
+    QWidget::resizeEvent(event);
+    rebuild_canvas();
+}
+
+void ScoreTimelineWidget::paintEvent(QPaintEvent* event) {
+    QPainter painter(this);
+    if (canvas.isNull()) {
+        painter.fillRect(event->rect(), QColor("#1a1a2e"));
+        return;
+    }
+    painter.drawPixmap(event->rect(), canvas, QRectF(QPointF(event->rect().topLeft()) * canvas.devicePixelRatio(),
+                                                     QSizeF(event->rect().size()) * canvas.devicePixelRatio()));
+    
+    // The legend is small and names can change, so it is painted live on top
+    const auto& teams = game_controller->get_teams();
+    QRect legend_area(width() - MARGIN - 160, MARGIN, 160, 18 * LEGEND_ENTRIES);
+    if (!event->rect().intersects(legend_area)) return;
+    
+    int y = MARGIN;
+    for (size_t i = 0; i < teams.size() && i < static_cast<size_t>(LEGEND_ENTRIES); ++i) {
+        painter.fillRect(QRect(legend_area.left(), y + 4, 10, 10), BoardRenderCache::team_color(i));
+        painter.setPen(Qt::white);
+        painter.drawText(QRect(legend_area.left() + 16, y, 144, 18), Qt::AlignLeft | Qt::AlignVCenter,
+                         teams[i].get_name_text().qstr());
+        y += 18;
+    }
+}
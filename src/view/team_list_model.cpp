@@ -0,0 +1,105 @@
+#include "view/team_list_model.h"
+#include "util/trace.h"
+
+TeamListModel::TeamListModel(GameController* controller, QObject* parent)
+    : QAbstractListModel(parent), game_controller(controller), shown_rows(0), current_row(-1) {
+    shown_rows = static_cast<int>(game_controller->get_teams().size());
+    current_row = static_cast<int>(game_controller->get_current_team_index());
+    
+    connect(game_controller, &GameController::score_event_recorded, this, &TeamListModel::on_score_event_recorded);
+    connect(game_controller, &GameController::team_changed, this, &TeamListModel::on_team_changed);
+    connect(game_controller, &GameController::team_added, this, &TeamListModel::on_team_added);
+    connect(game_controller, &GameController::team_renamed, this, &TeamListModel::on_team_renamed);
+    connect(game_controller, &GameController::win_probabilities_changed, this, &TeamListModel::on_win_probabilities_changed);
+    connect(game_controller, &GameController::scores_reset, this, &TeamListModel::reset);
+}
+
+int TeamListModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : shown_rows;
+}
+
+QVariant TeamListModel::data(const QModelIndex& index, int role) const {
+    const auto& teams = game_controller->get_teams();
+    if (!index.isValid() || index.row() >= static_cast<int>(teams.size())) return QVariant();
+    
+    const size_t team_index = static_cast<size_t>(index.row());
+    const team& row_team = teams[team_index];
+    switch (role) {
+        case Qt::DisplayRole:
+        case Qt::EditRole:
+            return row_team.get_name_text().qstr();
+        case ScoreRole:
+            return row_team.get_score();
+        case WinProbabilityRole: {
+            const auto& probabilities = game_controller->get_win_probabilities();
+            return team_index < probabilities.size() ? QVariant(probabilities[team_index]) : QVariant();
+        }
+        case CurrentRole:
+            return index.row() == current_row;
+        case TeamIndexRole:
+            return static_cast<qulonglong>(team_index);
+        default:
+            return QVariant();
+    }
+}
+
+bool TeamListModel::setData(const QModelIndex& index, const QVariant& value, int role) {
+    if (!index.isValid() || role != Qt::EditRole) return false;
+    
+    QString name = value.toString().trimmed();
+    if (name.isEmpty()) return false;
+    // dataChanged follows from the controller's team_renamed
+    game_controller->set_team_name(static_cast<size_t>(index.row()), name);
+    return true;
+}
+
+Qt::ItemFlags TeamListModel::flags(const QModelIndex& index) const {
+    if (!index.isValid()) return Qt::NoItemFlags;
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsEditable | Qt::ItemNeverHasChildren;
+}
+
+void TeamListModel::reset() {
+    TRACE_SCOPE("TeamListModel::reset");
+    beginResetModel();
+    shown_rows = static_cast<int>(game_controller->get_teams().size());
+    current_row = static_cast<int>(game_controller->get_current_team_index());
+    endResetModel();
+}
+
+void TeamListModel::on_score_event_recorded(size_t team_index, const score_event& event) {
+    Q_UNUSED(event);
+    QModelIndex changed = index(static_cast<int>(team_index));
+    emit dataChanged(changed, changed, {ScoreRole});
+}
+
+void TeamListModel::on_team_changed(const team& current_team) {
+    Q_UNUSED(current_team);
+    int new_row = static_cast<int>(game_controller->get_current_team_index());
+    if (new_row == current_row) return;
+    
+    int old_row = current_row;
+    current_row = new_row;
+    if (old_row >= 0 && old_row < shown_rows) {
+        emit dataChanged(index(old_row), index(old_row), {CurrentRole});
+    }
+    emit dataChanged(index(new_row), index(new_row), {CurrentRole});
+}
+
+void TeamListModel::on_team_added(size_t team_index) {
+    int row = static_cast<int>(team_index);
+    beginInsertRows(QModelIndex(), row, row);
+    shown_rows = static_cast<int>(game_controller->get_teams().size());
+    endInsertRows();
+}
+
+void TeamListModel::on_team_renamed(size_t team_index) {
+    QModelIndex changed = index(static_cast<int>(team_index));
+    emit dataChanged(changed, changed, {Qt::DisplayRole, Qt::EditRole});
+}
+
+void TeamListModel::on_win_probabilities_changed(const std::vector<double>& probabilities) {
+    Q_UNUSED(probabilities);
+    if (shown_rows > 0) {
+        emit dataChanged(index(0), index(shown_rows - 1), {WinProbabilityRole});
+    }
+}
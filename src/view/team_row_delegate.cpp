@@ -0,0 +1,69 @@
+#include "view/team_row_delegate.h"
+#include <QPainter>
+#include "view/team_list_model.h"
+
+TeamRowDelegate::TeamRowDelegate(QObject* parent)
+    : QStyledItemDelegate(parent), motion_progress(1.0) {
+}
+
+void TeamRowDelegate::add_motion(size_t team_index, int rows_moved) {
+    if (rows_moved != 0) {
+        motions[team_index] = rows_moved;
+    }
+}
+
+void TeamRowDelegate::clear_motions() {
+    motions.clear();
+    motion_progress = 1.0;
+}
+
+QSize TeamRowDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    Q_UNUSED(index);
+    return QSize(option.rect.width(), ROW_HEIGHT);
+}
+
+void TeamRowDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    const bool current = index.data(TeamListModel::CurrentRole).toBool();
+    const size_t team_index = index.data(TeamListModel::TeamIndexRole).toULongLong();
+    
+    QRect rect = option.rect;
+    auto motion = motions.find(team_index);
+    if (motion != motions.end()) {
+        rect.translate(0, static_cast<int>(motion->second * rect.height() * (1.0 - motion_progress)));
+    }
+    
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setPen(QPen(current ? QColor("#e94560") : QColor("#0f3460"), 2));
+    painter->setBrush(current ? QColor(233, 69, 96, 26) : QColor("#1a1a2e"));
+    if (option.state & QStyle::State_MouseOver) {
+        painter->setBrush(QColor("#0f3460"));
+    }
+    painter->drawRoundedRect(QRectF(rect).adjusted(2, 2, -2, -2), 6, 6);
+    
+    QRect content = rect.adjusted(10, 0, -10, 0);
+    QFont font = option.font;
+    font.setPixelSize(13);
+    painter->setFont(font);
+    painter->setPen(QColor("#888"));
+    painter->drawText(content, Qt::AlignLeft | Qt::AlignVCenter, QString("%1").arg(index.row() + 1));
+    
+    QString score = QString("$%1").arg(index.data(TeamListModel::ScoreRole).toInt());
+    QVariant probability = index.data(TeamListModel::WinProbabilityRole);
+    if (probability.isValid()) {
+        score += QString("  %1%").arg(qRound(probability.toDouble() * 100.0));
+    }
+    painter->setPen(Qt::white);
+    painter->drawText(content, Qt::AlignRight | Qt::AlignVCenter, score);
+    const int score_width = painter->fontMetrics().horizontalAdvance(score);
+    
+    font.setPixelSize(15);
+    font.setBold(true);
+    painter->setFont(font);
+    painter->setPen(QColor("#ffd700"));
+    QRect name_rect = content.adjusted(36, 0, -(score_width + 10), 0);
+    painter->drawText(name_rect, Qt::AlignLeft | Qt::AlignVCenter,
+                      painter->fontMetrics().elidedText(index.data(Qt::DisplayRole).toString(), Qt::ElideRight,
+                                                        name_rect.width()));
+    painter->restore();
+}
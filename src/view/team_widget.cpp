@@ -1,179 +1,28 @@
 #include "view/team_widget.h"
+#include "view/team_list_model.h"
+#include "view/team_row_delegate.h"
 #include "controller/game_controller.h"
-#include <QString>
-
-// TeamDisplayWidget Implementation
-TeamDisplayWidget::TeamDisplayWidget(const team* team_ptr, QWidget* parent)
-    : QFrame(parent), team_data(team_ptr), name_label(nullptr), score_label(nullptr),
-      name_edit(nullptr), is_current_team(false), is_editing_name(false) {
-    setup_ui();
-    update_display();
-}
-
-void TeamDisplayWidget::setup_ui() {
-    setFrameStyle(QFrame::Box | QFrame::Raised);
-    setLineWidth(2);
-    setMinimumHeight(80);
-    setMinimumWidth(200);
-    
-    QVBoxLayout* main_layout = new QVBoxLayout(this);
-    main_layout->setSpacing(5);
-    main_layout->setContentsMargins(10, 10, 10, 10);
-    
-    // Name display/edit
-    QHBoxLayout* name_layout = new QHBoxLayout;
-    
-    name_label = new QLabel;
-    name_label->setStyleSheet(
-        "QLabel {"
-        "font-size: 16px;"
-        "font-weight: bold;"
-        "color: #ffd700;"
-        "padding: 5px;"
-        "border-radius: 3px;"
-        "}"
-        "QLabel:hover {"
-        "background-color: rgba(255, 215, 0, 0.2);"
-        "cursor: pointer;"
-        "}"
-    );
-    name_label->setAlignment(Qt::AlignCenter);
-    name_label->installEventFilter(this);
-    
-    name_edit = new QLineEdit;
-    name_edit->setStyleSheet(
-        "QLineEdit {"
-        "font-size: 16px;"
-        "font-weight: bold;"
-        "color: #ffd700;"
-        "background-color: #16213e;"
-        "border: 2px solid #0f3460;"
-        "padding: 5px;"
-        "border-radius: 3px;"
-        "}"
-    );
-    name_edit->setAlignment(Qt::AlignCenter);
-    name_edit->hide();
-    
-    name_layout->addWidget(name_label);
-    name_layout->addWidget(name_edit);
-    
-    // Score display
-    score_label = new QLabel;
-    score_label->setStyleSheet(
-        "QLabel {"
-        "font-size: 14px;"
-        "color: white;"
-        "padding: 3px;"
-        "}"
-    );
-    score_label->setAlignment(Qt::AlignCenter);
-    
-    main_layout->addLayout(name_layout);
-    main_layout->addWidget(score_label);
-    
-    connect(name_edit, &QLineEdit::editingFinished, this, &TeamDisplayWidget::on_name_edit_finished);
-}
-
-void TeamDisplayWidget::update_display() {
-    if (!team_data) return;
-    
-    name_label->setText(QString::fromStdString(team_data->get_name()));
-    score_label->setText(QString("Score: %1").arg(team_data->get_score()));
-    
-    // Update styling based on current team status
-    QString border_color = is_current_team ? "#e94560" : "#0f3460";
-    QString bg_color = is_current_team ? "rgba(233, 69, 96, 0.1)" : "#1a1a2e";
-    
-    setStyleSheet(QString(
-        "TeamDisplayWidget {"
-        "background-color: %1;"
-        "border: 2px solid %2;"
-        "border-radius: 8px;"
-        "}"
-    ).arg(bg_color, border_color));
-}
-
-void TeamDisplayWidget::set_team_data(const team* team_ptr) {
-    team_data = team_ptr;
-    update_display();
-}
-
-void TeamDisplayWidget::set_current_team(bool is_current) {
-    is_current_team = is_current;
-    update_display();
-}
-
-void TeamDisplayWidget::update_team_info() {
-    update_display();
-}
-
-void TeamDisplayWidget::start_name_editing() {
-    if (!team_data || is_editing_name) return;
-    
-    is_editing_name = true;
-    name_edit->setText(QString::fromStdString(team_data->get_name()));
-    name_label->hide();
-    name_edit->show();
-    name_edit->setFocus();
-    name_edit->selectAll();
-}
-
-void TeamDisplayWidget::finish_name_editing() {
-    if (!is_editing_name) return;
-    
-    is_editing_name = false;
-    name_edit->hide();
-    name_label->show();
-    
-    QString new_name = name_edit->text().trimmed();
-    if (!new_name.isEmpty() && new_name != QString::fromStdString(team_data->get_name())) {
-        emit name_change_requested(team_data, new_name);
-    }
-}
-
-bool TeamDisplayWidget::eventFilter(QObject* obj, QEvent* event) {
-    if (obj == name_label && event->type() == QEvent::MouseButtonPress) {
-        start_name_editing();
-        return true;
-    }
-    return QFrame::eventFilter(obj, event);
-}
-
-void TeamDisplayWidget::on_name_clicked() {
-    start_name_editing();
-}
-
-void TeamDisplayWidget::on_name_edit_finished() {
-    finish_name_editing();
-}
-
-void TeamDisplayWidget::on_name_edit_escape() {
-    if (is_editing_name) {
-        is_editing_name = false;
-        name_edit->hide();
-        name_label->show();
-    }
-}
-
-void TeamDisplayWidget::keyPressEvent(QKeyEvent* event) {
-    if (is_editing_name && event->key() == Qt::Key_Escape) {
-        on_name_edit_escape();
-        return;
-    }
-    QFrame::keyPressEvent(event);
-}
-
-TeamWidget::TeamWidget(GameController* controller, QWidget* parent)
-    : QWidget(parent), game_controller(controller), main_layout(nullptr), title_label(nullptr) {
+#include <QVBoxLayout>
+#include <algorithm>
+#include "util/trace.h"
+
+TeamWidget::TeamWidget(GameController* controller, AnimationClock* clock, QWidget* parent)
+    : QWidget(parent), game_controller(controller), clock(clock), team_model(nullptr), sorted_model(nullptr),
+      row_delegate(nullptr), title_label(nullptr), current_team_label(nullptr), sort_combo(nullptr),
+      team_list(nullptr), add_team_button(nullptr), rank_motion(0), motion_top_row(0), motion_bottom_row(-1) {
     setup_ui();
     
-    connect(game_controller, &GameController::mode_changed, this, &TeamWidget::on_teams_updated);
-    connect(game_controller, &GameController::team_changed, this, &TeamWidget::on_current_team_changed);
+    connect(game_controller, &GameController::team_changed, this, &TeamWidget::refresh_current_team);
+    connect(game_controller, &GameController::score_changed, this, &TeamWidget::refresh_current_team);
+    connect(game_controller, &GameController::team_renamed, this, &TeamWidget::refresh_current_team);
+    connect(game_controller, &GameController::team_added, this, [this](size_t) {
+        add_team_button->setEnabled(game_controller->get_teams().size() < GameState::MAX_TEAMS);
+    });
+    refresh_current_team();
 }
 
 void TeamWidget::setup_ui() {
-    main_layout = new QVBoxLayout(this);
+    QVBoxLayout* main_layout = new QVBoxLayout(this);
     main_layout->setSpacing(10);
     main_layout->setContentsMargins(10, 10, 10, 10);
     
@@ -189,67 +38,158 @@ void TeamWidget::setup_ui() {
     );
     title_label->setAlignment(Qt::AlignCenter);
     
+    current_team_label = new QLabel;
+    current_team_label->setAlignment(Qt::AlignCenter);
+    current_team_label->setStyleSheet(
+        "QLabel { font-size: 16px; font-weight: bold; color: #ffd700; padding: 8px; "
+        "background-color: rgba(233, 69, 96, 0.1); border: 2px solid #e94560; border-radius: 8px; }"
+    );
+    
+    sort_combo = new QComboBox;
+    sort_combo->addItem("Turn order");
+    sort_combo->addItem("Score");
+    sort_combo->addItem("Name");
+    
+    team_model = new TeamListModel(game_controller, this);
+    // Connected before the proxy so old positions can be read before it re-sorts
+    connect(team_model, &TeamListModel::dataChanged, this, &TeamWidget::on_source_data_changed);
+    sorted_model = new QSortFilterProxyModel(this);
+    sorted_model->setSourceModel(team_model);
+    sorted_model->setDynamicSortFilter(true);
+    sorted_model->setSortCaseSensitivity(Qt::CaseInsensitive);
+    connect(sorted_model, &QSortFilterProxyModel::layoutChanged, this, &TeamWidget::on_layout_changed);
+    
+    row_delegate = new TeamRowDelegate(this);
+    team_list = new QListView;
+    team_list->setModel(sorted_model);
+    team_list->setItemDelegate(row_delegate);
+    team_list->setUniformItemSizes(true);
+    team_list->setMouseTracking(true);
+    team_list->viewport()->setAttribute(Qt::WA_Hover);
+    team_list->setSelectionMode(QAbstractItemView::NoSelection);
+    team_list->setEditTriggers(QAbstractItemView::DoubleClicked | QAbstractItemView::EditKeyPressed);
+    team_list->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    team_list->setStyleSheet("QListView { background-color: #16213e; border: none; }");
+    
+    add_team_button = new QPushButton("Add Team");
+    add_team_button->setStyleSheet(
+        "QPushButton { background-color: #16213e; color: white; border: 2px solid #0f3460; "
+        "padding: 8px 16px; border-radius: 5px; font-weight: bold; }"
+        "QPushButton:hover { background-color: #0f3460; }"
+    );
+    add_team_button->setEnabled(game_controller->get_teams().size() < GameState::MAX_TEAMS);
+    
     main_layout->addWidget(title_label);
-    main_layout->addStretch();
-}
-
-void TeamWidget::clear_team_displays() {
-    for (auto* display : team_displays) {
-        main_layout->removeWidget(display);
-        display->deleteLater();
-    }
-    team_displays.clear();
+    main_layout->addWidget(current_team_label);
+    main_layout->addWidget(sort_combo);
+    main_layout->addWidget(team_list, 1);
+    main_layout->addWidget(add_team_button);
+    
+    connect(sort_combo, &QComboBox::currentIndexChanged, this, &TeamWidget::apply_sort_mode);
+    connect(add_team_button, &QPushButton::clicked, this, &TeamWidget::add_team);
 }
 
-void TeamWidget::create_team_displays() {
-    clear_team_displays();
-    
-    const auto& teams = game_controller->get_teams();
-    const auto& current_team = game_controller->get_current_team();
-    
-    for (const auto& team : teams) {
-        TeamDisplayWidget* display = new TeamDisplayWidget(&team, this);
-        display->set_current_team(&team == &current_team);
-        
-        connect(display, &TeamDisplayWidget::name_change_requested,
-                this, &TeamWidget::on_team_name_change_requested);
-        
-        team_displays.push_back(display);
-        main_layout->insertWidget(main_layout->count() - 1, display);
+void TeamWidget::apply_sort_mode() {
+    clock->stop(rank_motion);
+    row_delegate->clear_motions();
+    switch (static_cast<SortMode>(sort_combo->currentIndex())) {
+        case SortMode::TURN_ORDER:
+            sorted_model->sort(-1);
+            break;
+        case SortMode::SCORE:
+            sorted_model->setSortRole(TeamListModel::ScoreRole);
+            sorted_model->sort(0, Qt::DescendingOrder);
+            break;
+        case SortMode::NAME:
+            sorted_model->setSortRole(Qt::DisplayRole);
+            sorted_model->sort(0, Qt::AscendingOrder);
+            break;
     }
 }
 
 void TeamWidget::update_teams() {
-    create_team_displays();
+    team_model->reset();
+    refresh_current_team();
 }
 
-void TeamWidget::set_current_team(const team& current_team) {
+void TeamWidget::refresh_current_team() {
     const auto& teams = game_controller->get_teams();
-    for (size_t i = 0; i < team_displays.size() && i < teams.size(); ++i) {
-        team_displays[i]->set_current_team(&teams[i] == &current_team);
+    if (teams.empty()) return;
+    const team& current = game_controller->get_current_team();
+    current_team_label->setText(QString("Up: %1  $%2  #%3")
+                                    .arg(current.get_name_text().qstr())
+                                    .arg(current.get_score())
+                                    .arg(game_controller->get_team_rank(game_controller->get_current_team_index())));
+}
+
+void TeamWidget::on_source_data_changed(const QModelIndex& top_left, const QModelIndex& bottom_right,
+                                        const QList<int>& roles) {
+    if (sorted_model->sortColumn() < 0 || !roles.contains(sorted_model->sortRole())) return;
+    
+    for (int row = top_left.row(); row <= bottom_right.row(); ++row) {
+        QModelIndex visual = sorted_model->mapFromSource(team_model->index(row));
+        if (visual.isValid()) {
+            rows_before_sort.emplace(static_cast<size_t>(row), visual.row());
+        }
     }
 }
 
-void TeamWidget::on_teams_updated() {
-    update_teams();
-}
-
-void TeamWidget::on_current_team_changed(const team& current_team) {
-    set_current_team(current_team);
+void TeamWidget::on_layout_changed() {
+    if (rows_before_sort.empty()) return;
+    
+    TRACE_SCOPE("TeamWidget::on_layout_changed");
+    clock->stop(rank_motion);
+    row_delegate->clear_motions();
+    motion_top_row = sorted_model->rowCount();
+    motion_bottom_row = -1;
+    
+    // Only the moved rows and the ones they passed get a motion
+    for (const auto& [team_index, old_row] : rows_before_sort) {
+        int new_row = sorted_model->mapFromSource(team_model->index(static_cast<int>(team_index))).row();
+        if (new_row < 0 || new_row == old_row) continue;
+        
+        int first = std::min(old_row, new_row);
+        int last = std::max(old_row, new_row);
+        int passed_shift = new_row < old_row ? -1 : 1;
+        for (int row = first; row <= last; ++row) {
+            if (row == new_row) continue;
+            QModelIndex passed = sorted_model->index(row, 0);
+            row_delegate->add_motion(passed.data(TeamListModel::TeamIndexRole).toULongLong(), passed_shift);
+        }
+        row_delegate->add_motion(team_index, old_row - new_row);
+        motion_top_row = std::min(motion_top_row, first);
+        motion_bottom_row = std::max(motion_bottom_row, last);
+    }
+    rows_before_sort.clear();
     
-    // Update all team displays to refresh scores
-    for (auto* display : team_displays) {
-        display->update_team_info();
+    if (row_delegate->has_motions()) {
+        start_rank_motion();
     }
 }
 
-void TeamWidget::on_team_name_change_requested(const team* team_ptr, const QString& new_name) {
-    // Find the team index
-    const auto& teams = game_controller->get_teams();
-    for (size_t i = 0; i < teams.size(); ++i) {
-        if (&teams[i] == team_ptr) {
-            game_controller->set_team_name(i, new_name.toStdString());
-            break;
-        }
+void TeamWidget::start_rank_motion() {
+    rank_motion = clock->start(team_list, RANK_MOTION_MS, QEasingCurve::OutCubic,
+        [this](double progress) {
+            row_delegate->set_motion_progress(progress);
+            update_motion_rows();
+        },
+        [this]() {
+            row_delegate->clear_motions();
+            update_motion_rows();
+        });
+}
+
+void TeamWidget::update_motion_rows() {
+    // Repaint only the band the moving rows travel through
+    QRect top = team_list->visualRect(sorted_model->index(motion_top_row, 0));
+    QRect bottom = team_list->visualRect(sorted_model->index(motion_bottom_row, 0));
+    QRect band = top.united(bottom);
+    if (band.intersects(team_list->viewport()->rect())) {
+        team_list->viewport()->update(band.adjusted(0, -TeamRowDelegate::ROW_HEIGHT, 0, TeamRowDelegate::ROW_HEIGHT));
     }
 }
+
+void TeamWidget::add_team() {
+    size_t count = game_controller->get_teams().size();
+    game_controller->add_team(QString("Team %1").arg(count + 1));
+}